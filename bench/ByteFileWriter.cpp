@@ -0,0 +1,193 @@
+#include "ByteFileWriter.hpp"
+
+#include <cstring>
+#include <fstream>
+
+namespace svm::bench {
+	namespace {
+		constexpr std::uint32_t Magic = 0x74687468;
+		constexpr std::uint16_t ByteFileVersion = 0x0003;
+		constexpr std::uint16_t ByteCodeVersion = 0x0003;
+
+		template<typename T>
+		void WriteLittle(std::vector<std::uint8_t>& bytes, T value) {
+			for (std::size_t i = 0; i < sizeof(T); ++i) {
+				bytes.push_back(static_cast<std::uint8_t>(static_cast<std::uint64_t>(value) >> (i * 8)));
+			}
+		}
+		void WriteDouble(std::vector<std::uint8_t>& bytes, double value) {
+			std::uint64_t bits;
+			std::memcpy(&bits, &value, sizeof(bits));
+			WriteLittle(bytes, bits);
+		}
+		void WriteString(std::vector<std::uint8_t>& bytes, const std::string& string) {
+			WriteLittle(bytes, static_cast<std::uint32_t>(string.size()));
+			bytes.insert(bytes.end(), string.begin(), string.end());
+		}
+	}
+
+	std::uint32_t InstructionsWriter::AddLabel() {
+		m_Labels.push_back(0);
+		return static_cast<std::uint32_t>(m_Labels.size() - 1);
+	}
+	void InstructionsWriter::BindLabel(std::uint32_t label) noexcept {
+		m_Labels[label] = m_Instructions.size();
+	}
+
+	InstructionsWriter& InstructionsWriter::Emit(OpCode opCode) {
+		m_Instructions.push_back({ opCode, { OperandKind::None, 0 } });
+		return *this;
+	}
+	InstructionsWriter& InstructionsWriter::Emit(OpCode opCode, std::uint32_t operand) {
+		return Emit(opCode, { OperandKind::Raw, operand });
+	}
+	InstructionsWriter& InstructionsWriter::Emit(OpCode opCode, Operand operand) {
+		m_Instructions.push_back({ opCode, operand });
+		return *this;
+	}
+
+	void InstructionsWriter::Write(std::vector<std::uint8_t>& bytes, std::uint32_t intCount, std::uint32_t longCount, std::uint32_t doubleCount) const {
+		WriteLittle(bytes, static_cast<std::uint32_t>(m_Labels.size()));
+		for (const std::uint64_t label : m_Labels) {
+			WriteLittle(bytes, label);
+		}
+
+		WriteLittle(bytes, static_cast<std::uint64_t>(m_Instructions.size()));
+		for (const Instruction& instruction : m_Instructions) {
+			bytes.push_back(static_cast<std::uint8_t>(instruction.OpCode));
+
+			// Constants are numbered in the order of the constant pool, and structures after all the constants
+			std::uint32_t operand = instruction.Operand.Value;
+			switch (instruction.Operand.Kind) {
+			case OperandKind::None: continue;
+			case OperandKind::Raw:
+			case OperandKind::IntConstant: break;
+			case OperandKind::LongConstant: operand += intCount; break;
+			case OperandKind::DoubleConstant: operand += intCount + longCount; break;
+			case OperandKind::Structure: operand += intCount + longCount + doubleCount; break;
+			}
+			WriteLittle(bytes, operand);
+		}
+	}
+
+	std::uint32_t ByteFileWriter::AddDependency(std::string path) {
+		m_Dependencies.push_back(std::move(path));
+		return static_cast<std::uint32_t>(m_Dependencies.size() - 1);
+	}
+	std::uint32_t ByteFileWriter::AddStructureMapping(std::uint32_t dependency, std::string name) {
+		m_StructureMappings.emplace_back(dependency, std::move(name));
+		return static_cast<std::uint32_t>(m_StructureMappings.size() - 1);
+	}
+	std::uint32_t ByteFileWriter::AddFunctionMapping(std::uint32_t dependency, std::string name) {
+		m_FunctionMappings.emplace_back(dependency, std::move(name));
+		return static_cast<std::uint32_t>(m_FunctionMappings.size() - 1);
+	}
+
+	Operand ByteFileWriter::AddInt(std::uint32_t value) {
+		m_IntConstants.push_back(value);
+		return { OperandKind::IntConstant, static_cast<std::uint32_t>(m_IntConstants.size() - 1) };
+	}
+	Operand ByteFileWriter::AddLong(std::uint64_t value) {
+		m_LongConstants.push_back(value);
+		return { OperandKind::LongConstant, static_cast<std::uint32_t>(m_LongConstants.size() - 1) };
+	}
+	Operand ByteFileWriter::AddDouble(double value) {
+		m_DoubleConstants.push_back(value);
+		return { OperandKind::DoubleConstant, static_cast<std::uint32_t>(m_DoubleConstants.size() - 1) };
+	}
+
+	std::uint32_t ByteFileWriter::AddStructure(StructureWriter structure) {
+		m_Structures.push_back(std::move(structure));
+		return TypeCode::Structure + static_cast<std::uint32_t>(m_Structures.size() - 1);
+	}
+	std::uint32_t ByteFileWriter::AddFunction(std::string name, std::uint16_t arity, bool hasResult) {
+		FunctionWriter& function = m_Functions.emplace_back();
+		function.Name = std::move(name);
+		function.Arity = arity;
+		function.HasResult = hasResult;
+		return static_cast<std::uint32_t>(m_Functions.size() - 1);
+	}
+	FunctionWriter& ByteFileWriter::GetFunction(std::uint32_t index) noexcept {
+		return m_Functions[index];
+	}
+	std::uint32_t ByteFileWriter::GetFunctionCount() const noexcept {
+		return static_cast<std::uint32_t>(m_Functions.size());
+	}
+	InstructionsWriter& ByteFileWriter::GetEntrypoint() noexcept {
+		return m_Entrypoint;
+	}
+
+	std::vector<std::uint8_t> ByteFileWriter::Write() const {
+		std::vector<std::uint8_t> bytes;
+		for (int i = 3; i >= 0; --i) {
+			bytes.push_back(static_cast<std::uint8_t>(Magic >> (i * 8)));
+		}
+		WriteLittle(bytes, ByteFileVersion);
+		WriteLittle(bytes, ByteCodeVersion);
+
+		WriteLittle(bytes, static_cast<std::uint32_t>(m_Dependencies.size()));
+		for (const std::string& dependency : m_Dependencies) {
+			WriteString(bytes, dependency);
+		}
+
+		WriteLittle(bytes, static_cast<std::uint32_t>(m_StructureMappings.size()));
+		for (const auto& [dependency, name] : m_StructureMappings) {
+			WriteLittle(bytes, dependency);
+			WriteString(bytes, name);
+		}
+		WriteLittle(bytes, static_cast<std::uint32_t>(m_FunctionMappings.size()));
+		for (const auto& [dependency, name] : m_FunctionMappings) {
+			WriteLittle(bytes, dependency);
+			WriteString(bytes, name);
+		}
+
+		WriteLittle(bytes, static_cast<std::uint32_t>(m_IntConstants.size()));
+		for (const std::uint32_t value : m_IntConstants) {
+			WriteLittle(bytes, value);
+		}
+		WriteLittle(bytes, static_cast<std::uint32_t>(m_LongConstants.size()));
+		for (const std::uint64_t value : m_LongConstants) {
+			WriteLittle(bytes, value);
+		}
+		WriteLittle(bytes, static_cast<std::uint32_t>(m_DoubleConstants.size()));
+		for (const double value : m_DoubleConstants) {
+			WriteDouble(bytes, value);
+		}
+
+		WriteLittle(bytes, static_cast<std::uint32_t>(m_Structures.size()));
+		for (const StructureWriter& structure : m_Structures) {
+			WriteString(bytes, structure.Name);
+			WriteLittle(bytes, static_cast<std::uint32_t>(structure.Fields.size()));
+			for (const auto& [type, count] : structure.Fields) {
+				WriteLittle(bytes, type);
+				if (type & TypeCode::Array) {
+					WriteLittle(bytes, count);
+				}
+			}
+		}
+
+		const auto intCount = static_cast<std::uint32_t>(m_IntConstants.size());
+		const auto longCount = static_cast<std::uint32_t>(m_LongConstants.size());
+		const auto doubleCount = static_cast<std::uint32_t>(m_DoubleConstants.size());
+
+		WriteLittle(bytes, static_cast<std::uint32_t>(m_Functions.size()));
+		for (const FunctionWriter& function : m_Functions) {
+			WriteString(bytes, function.Name);
+			WriteLittle(bytes, function.Arity);
+			bytes.push_back(function.HasResult ? 1 : 0);
+			function.Write(bytes, intCount, longCount, doubleCount);
+		}
+
+		m_Entrypoint.Write(bytes, intCount, longCount, doubleCount);
+		return bytes;
+	}
+	bool ByteFileWriter::Save(const std::string& path) const {
+		const std::vector<std::uint8_t> bytes = Write();
+
+		std::ofstream stream(path, std::ios::binary);
+		if (!stream) return false;
+
+		stream.write(reinterpret_cast<const char*>(bytes.data()), static_cast<std::streamsize>(bytes.size()));
+		return static_cast<bool>(stream);
+	}
+}
\ No newline at end of file
@@ -0,0 +1,129 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace svm::bench {
+	// Opcodes of ShitBC 0.4.0
+	enum class OpCode : std::uint8_t {
+		Push = 0x01, Pop = 0x02, Load = 0x03, Store = 0x04, Lea = 0x05, FLea = 0x06, TLoad = 0x07, TStore = 0x08, Copy = 0x09, Swap = 0x0A,
+		Add = 0x0B, Sub = 0x0C, Mul = 0x0D, IMul = 0x0E, Div = 0x0F, IDiv = 0x10, Mod = 0x11, IMod = 0x12, Neg = 0x13, Inc = 0x14, Dec = 0x15,
+		And = 0x16, Or = 0x17, Xor = 0x18, Not = 0x19, Shl = 0x1A, Sal = 0x1B, Shr = 0x1C, Sar = 0x1D,
+		Cmp = 0x1E, ICmp = 0x1F, Jmp = 0x20, Je = 0x21, Jne = 0x22, Ja = 0x23, Jae = 0x24, Jb = 0x25, Jbe = 0x26, Call = 0x27, Ret = 0x28,
+		ToI = 0x2B, ToL = 0x2C, ToD = 0x2E, ToP = 0x2F,
+		Null = 0x30, New = 0x31, Delete = 0x32, GCNull = 0x33, GCNew = 0x34, APush = 0x35, ANew = 0x36, AGCNew = 0x37, ALea = 0x38, Count = 0x3B,
+	};
+
+	namespace TypeCode {
+		constexpr std::uint32_t Int = 3;
+		constexpr std::uint32_t Long = 4;
+		constexpr std::uint32_t Double = 6;
+		constexpr std::uint32_t Pointer = 7;
+		constexpr std::uint32_t GCPointer = 8;
+		constexpr std::uint32_t Structure = 20;
+		constexpr std::uint32_t Array = 0x80000000;
+	}
+
+	enum class OperandKind : std::uint8_t {
+		None,
+		Raw,
+		IntConstant,
+		LongConstant,
+		DoubleConstant,
+		Structure,
+	};
+
+	struct Operand final {
+		OperandKind Kind = OperandKind::Raw;
+		std::uint32_t Value = 0;
+	};
+
+	class InstructionsWriter {
+	private:
+		struct Instruction final {
+			bench::OpCode OpCode;
+			bench::Operand Operand;
+		};
+
+		std::vector<std::uint64_t> m_Labels;
+		std::vector<Instruction> m_Instructions;
+
+	public:
+		InstructionsWriter() = default;
+		InstructionsWriter(InstructionsWriter&& writer) noexcept = default;
+		~InstructionsWriter() = default;
+
+	public:
+		InstructionsWriter& operator=(InstructionsWriter&& writer) noexcept = default;
+		bool operator==(const InstructionsWriter&) = delete;
+		bool operator!=(const InstructionsWriter&) = delete;
+
+	public:
+		std::uint32_t AddLabel();
+		void BindLabel(std::uint32_t label) noexcept;
+
+		InstructionsWriter& Emit(OpCode opCode);
+		InstructionsWriter& Emit(OpCode opCode, std::uint32_t operand);
+		InstructionsWriter& Emit(OpCode opCode, Operand operand);
+
+		void Write(std::vector<std::uint8_t>& bytes, std::uint32_t intCount, std::uint32_t longCount, std::uint32_t doubleCount) const;
+	};
+
+	struct FunctionWriter final : InstructionsWriter {
+		std::string Name;
+		std::uint16_t Arity = 0;
+		bool HasResult = false;
+	};
+
+	struct StructureWriter final {
+		std::string Name;
+		std::vector<std::pair<std::uint32_t, std::uint64_t>> Fields; // Type code, count of elements if the field is an array
+	};
+
+	// Writes ShitBF 0.4.0 files without depending on the parser
+	class ByteFileWriter final {
+	private:
+		std::vector<std::string> m_Dependencies;
+		std::vector<std::pair<std::uint32_t, std::string>> m_StructureMappings;
+		std::vector<std::pair<std::uint32_t, std::string>> m_FunctionMappings;
+		std::vector<std::uint32_t> m_IntConstants;
+		std::vector<std::uint64_t> m_LongConstants;
+		std::vector<double> m_DoubleConstants;
+		std::vector<StructureWriter> m_Structures;
+		std::vector<FunctionWriter> m_Functions;
+		InstructionsWriter m_Entrypoint;
+
+	public:
+		ByteFileWriter() = default;
+		ByteFileWriter(ByteFileWriter&& writer) noexcept = default;
+		~ByteFileWriter() = default;
+
+	public:
+		ByteFileWriter& operator=(ByteFileWriter&& writer) noexcept = default;
+		bool operator==(const ByteFileWriter&) = delete;
+		bool operator!=(const ByteFileWriter&) = delete;
+
+	public:
+		std::uint32_t AddDependency(std::string path);
+		std::uint32_t AddStructureMapping(std::uint32_t dependency, std::string name);
+		std::uint32_t AddFunctionMapping(std::uint32_t dependency, std::string name);
+
+		Operand AddInt(std::uint32_t value);
+		Operand AddLong(std::uint64_t value);
+		Operand AddDouble(double value);
+
+		// Returns the type code of the structure. The operand of push is Operand{ OperandKind::Structure, index }
+		std::uint32_t AddStructure(StructureWriter structure);
+		// Returns the index of the function. Mapped functions come after all the functions of the module
+		std::uint32_t AddFunction(std::string name, std::uint16_t arity, bool hasResult);
+		FunctionWriter& GetFunction(std::uint32_t index) noexcept;
+		std::uint32_t GetFunctionCount() const noexcept;
+		InstructionsWriter& GetEntrypoint() noexcept;
+
+		std::vector<std::uint8_t> Write() const;
+		bool Save(const std::string& path) const;
+	};
+}
\ No newline at end of file
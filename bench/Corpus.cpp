@@ -0,0 +1,264 @@
+#include "Corpus.hpp"
+
+#include <cstdint>
+#include <filesystem>
+#include <stdexcept>
+
+namespace svm::bench {
+	namespace {
+		Program MakeProgram(std::string name, std::string description, std::string expectedResult, ByteFileWriter&& main) {
+			Program result;
+			result.Name = std::move(name);
+			result.Description = std::move(description);
+			result.ExpectedResult = std::move(expectedResult);
+			result.Modules.emplace_back("main.sbf", std::move(main));
+			return result;
+		}
+
+		// Emits 'while (local < limit) { body; ++local; }'. Conditional jumps pop the result of cmp only when they jump
+		template<typename F>
+		void EmitLoop(InstructionsWriter& writer, std::uint32_t local, Operand limit, F&& body) {
+			const std::uint32_t loop = writer.AddLabel();
+			const std::uint32_t end = writer.AddLabel();
+
+			writer.BindLabel(loop);
+			writer.Emit(OpCode::Load, local).Emit(OpCode::Push, limit).Emit(OpCode::Cmp).Emit(OpCode::Jae, end).Emit(OpCode::Pop);
+			body();
+			writer.Emit(OpCode::Lea, local).Emit(OpCode::Inc).Emit(OpCode::Jmp, loop);
+			writer.BindLabel(end);
+		}
+
+		Program CreateIntLoop() {
+			constexpr std::uint64_t count = 5'000'000;
+
+			ByteFileWriter main;
+			const Operand zero = main.AddLong(0);
+			const Operand seven = main.AddLong(7);
+			const Operand limit = main.AddLong(count);
+
+			InstructionsWriter& entry = main.GetEntrypoint();
+			entry.Emit(OpCode::Push, zero).Emit(OpCode::Store, 0); // i
+			entry.Emit(OpCode::Push, zero).Emit(OpCode::Store, 1); // sum
+			EmitLoop(entry, 0, limit, [&] {
+				// sum = (sum + i * i) ^ (i & 7)
+				entry.Emit(OpCode::Load, 1).Emit(OpCode::Load, 0).Emit(OpCode::Load, 0).Emit(OpCode::Mul).Emit(OpCode::Add);
+				entry.Emit(OpCode::Load, 0).Emit(OpCode::Push, seven).Emit(OpCode::And).Emit(OpCode::Xor).Emit(OpCode::Store, 1);
+			});
+			entry.Emit(OpCode::Load, 1);
+
+			std::uint64_t sum = 0;
+			for (std::uint64_t i = 0; i < count; ++i) {
+				sum = (sum + i * i) ^ (i & 7);
+			}
+			return MakeProgram("int-loop", "Integer arithmetic and branches in a counted loop", std::to_string(sum), std::move(main));
+		}
+		Program CreateRecursion() {
+			constexpr std::uint64_t n = 30;
+
+			ByteFileWriter main;
+			const Operand one = main.AddLong(1);
+			const Operand two = main.AddLong(2);
+			const Operand argument = main.AddLong(n);
+
+			const std::uint32_t fibIndex = main.AddFunction("fib", 1, true);
+			FunctionWriter& fib = main.GetFunction(fibIndex);
+			const std::uint32_t base = fib.AddLabel();
+			fib.Emit(OpCode::Load, 0).Emit(OpCode::Push, two).Emit(OpCode::Cmp).Emit(OpCode::Jb, base).Emit(OpCode::Pop);
+			fib.Emit(OpCode::Load, 0).Emit(OpCode::Push, one).Emit(OpCode::Sub).Emit(OpCode::Call, fibIndex);
+			fib.Emit(OpCode::Load, 0).Emit(OpCode::Push, two).Emit(OpCode::Sub).Emit(OpCode::Call, fibIndex);
+			fib.Emit(OpCode::Add).Emit(OpCode::Ret);
+			fib.BindLabel(base);
+			fib.Emit(OpCode::Load, 0).Emit(OpCode::Ret);
+
+			main.GetEntrypoint().Emit(OpCode::Push, argument).Emit(OpCode::Call, fibIndex);
+
+			std::uint64_t previous = 0, current = 1;
+			for (std::uint64_t i = 1; i < n; ++i) {
+				current += previous;
+				previous = current - previous;
+			}
+			return MakeProgram("recursion", "Naive recursive Fibonacci, dominated by call and ret", std::to_string(current), std::move(main));
+		}
+		Program CreateStructureField() {
+			constexpr std::uint64_t count = 2'000'000;
+
+			ByteFileWriter main;
+			const Operand zero = main.AddLong(0);
+			const Operand one = main.AddLong(1);
+			const Operand limit = main.AddLong(count);
+			main.AddStructure({ "Vector3", { { TypeCode::Long, 0 }, { TypeCode::Long, 0 }, { TypeCode::Long, 0 } } });
+
+			InstructionsWriter& entry = main.GetEntrypoint();
+			entry.Emit(OpCode::Push, Operand{ OperandKind::Structure, 0 }).Emit(OpCode::Store, 0); // v
+			entry.Emit(OpCode::Push, zero).Emit(OpCode::Store, 1); // i
+			EmitLoop(entry, 1, limit, [&] {
+				// v.x += i
+				entry.Emit(OpCode::Lea, 0).Emit(OpCode::FLea, 0).Emit(OpCode::Copy).Emit(OpCode::TLoad);
+				entry.Emit(OpCode::Load, 1).Emit(OpCode::Add).Emit(OpCode::TStore);
+				// v.y ^= v.x
+				entry.Emit(OpCode::Lea, 0).Emit(OpCode::FLea, 1).Emit(OpCode::Copy).Emit(OpCode::TLoad);
+				entry.Emit(OpCode::Lea, 0).Emit(OpCode::FLea, 0).Emit(OpCode::TLoad).Emit(OpCode::Xor).Emit(OpCode::TStore);
+				// v.z += 1
+				entry.Emit(OpCode::Lea, 0).Emit(OpCode::FLea, 2).Emit(OpCode::Copy).Emit(OpCode::TLoad);
+				entry.Emit(OpCode::Push, one).Emit(OpCode::Add).Emit(OpCode::TStore);
+			});
+			for (std::uint32_t field = 0; field < 3; ++field) {
+				entry.Emit(OpCode::Lea, 0).Emit(OpCode::FLea, field).Emit(OpCode::TLoad);
+			}
+			entry.Emit(OpCode::Add).Emit(OpCode::Add);
+
+			std::uint64_t x = 0, y = 0, z = 0;
+			for (std::uint64_t i = 0; i < count; ++i) {
+				x += i;
+				y ^= x;
+				z += 1;
+			}
+			return MakeProgram("structure-field", "Loads and stores through field pointers of a local structure", std::to_string(x + y + z), std::move(main));
+		}
+		Program CreateArrayScan() {
+			constexpr std::uint64_t size = 100'000;
+			constexpr std::uint64_t passes = 20;
+
+			ByteFileWriter main;
+			const Operand zero = main.AddLong(0);
+			const Operand three = main.AddLong(3);
+			const Operand sizeConstant = main.AddLong(size);
+			const Operand passesConstant = main.AddLong(passes);
+
+			InstructionsWriter& entry = main.GetEntrypoint();
+			entry.Emit(OpCode::Push, sizeConstant).Emit(OpCode::APush, TypeCode::Array | TypeCode::Long).Emit(OpCode::Store, 0); // array
+			entry.Emit(OpCode::Push, zero).Emit(OpCode::Store, 1); // i
+			entry.Emit(OpCode::Push, zero).Emit(OpCode::Store, 2); // pass
+			entry.Emit(OpCode::Push, zero).Emit(OpCode::Store, 3); // sum
+			EmitLoop(entry, 1, sizeConstant, [&] {
+				// array[i] = i * 3
+				entry.Emit(OpCode::Lea, 0).Emit(OpCode::Load, 1).Emit(OpCode::ALea);
+				entry.Emit(OpCode::Load, 1).Emit(OpCode::Push, three).Emit(OpCode::Mul).Emit(OpCode::TStore);
+			});
+			EmitLoop(entry, 2, passesConstant, [&] {
+				entry.Emit(OpCode::Push, zero).Emit(OpCode::Store, 1);
+				EmitLoop(entry, 1, sizeConstant, [&] {
+					// sum += array[i]
+					entry.Emit(OpCode::Load, 3).Emit(OpCode::Lea, 0).Emit(OpCode::Load, 1).Emit(OpCode::ALea).Emit(OpCode::TLoad);
+					entry.Emit(OpCode::Add).Emit(OpCode::Store, 3);
+				});
+			});
+			entry.Emit(OpCode::Load, 3);
+
+			const std::uint64_t sum = passes * 3 * (size * (size - 1) / 2);
+			return MakeProgram("array-scan", "Sequential element access of a packed local array", std::to_string(sum), std::move(main));
+		}
+		Program CreateGCChurn() {
+			constexpr std::uint64_t count = 500'000;
+
+			ByteFileWriter main;
+			const Operand zero = main.AddLong(0);
+			const Operand mask = main.AddLong(63);
+			const Operand bufferSize = main.AddLong(8);
+			const Operand limit = main.AddLong(count);
+			const std::uint32_t node = main.AddStructure({ "Node", { { TypeCode::Long, 0 }, { TypeCode::GCPointer, 0 } } });
+
+			InstructionsWriter& entry = main.GetEntrypoint();
+			entry.Emit(OpCode::Push, zero).Emit(OpCode::Store, 0); // i
+			entry.Emit(OpCode::GCNull).Emit(OpCode::Store, 1); // head
+			EmitLoop(entry, 0, limit, [&] {
+				// Drop the list every 64 nodes, so that most of the nodes die young
+				const std::uint32_t keep = entry.AddLabel();
+				entry.Emit(OpCode::Load, 0).Emit(OpCode::Push, mask).Emit(OpCode::And).Emit(OpCode::Push, zero).Emit(OpCode::Cmp);
+				entry.Emit(OpCode::Jne, keep).Emit(OpCode::Pop);
+				entry.Emit(OpCode::GCNull).Emit(OpCode::Store, 1);
+				entry.BindLabel(keep);
+
+				// node = gcnew Node; node.value = i; node.next = head; head = node
+				entry.Emit(OpCode::GCNew, node).Emit(OpCode::Copy).Emit(OpCode::FLea, 0).Emit(OpCode::Load, 0).Emit(OpCode::TStore);
+				entry.Emit(OpCode::Copy).Emit(OpCode::FLea, 1).Emit(OpCode::Load, 1).Emit(OpCode::TStore);
+				entry.Emit(OpCode::Store, 1);
+
+				entry.Emit(OpCode::Push, bufferSize).Emit(OpCode::AGCNew, TypeCode::Array | TypeCode::Long).Emit(OpCode::Pop);
+			});
+			entry.Emit(OpCode::Load, 0);
+
+			return MakeProgram("gc-churn", "Short-lived structures and arrays on the managed heap", std::to_string(count), std::move(main));
+		}
+		Program CreateCrossModuleCall() {
+			constexpr std::uint64_t count = 1'000'000;
+
+			ByteFileWriter library;
+			const Operand factor = library.AddLong(31);
+			FunctionWriter& mix = library.GetFunction(library.AddFunction("mix", 2, true));
+			// Parameters are numbered from the last pushed one
+			mix.Emit(OpCode::Load, 1).Emit(OpCode::Push, factor).Emit(OpCode::Mul).Emit(OpCode::Load, 0).Emit(OpCode::Add).Emit(OpCode::Ret);
+
+			ByteFileWriter main;
+			const Operand zero = main.AddLong(0);
+			const Operand limit = main.AddLong(count);
+			const std::uint32_t libraryIndex = main.AddDependency("lib.sbf");
+			const std::uint32_t mixIndex = main.GetFunctionCount() + main.AddFunctionMapping(libraryIndex, "mix");
+
+			InstructionsWriter& entry = main.GetEntrypoint();
+			entry.Emit(OpCode::Push, zero).Emit(OpCode::Store, 0); // i
+			entry.Emit(OpCode::Push, zero).Emit(OpCode::Store, 1); // accumulator
+			EmitLoop(entry, 0, limit, [&] {
+				entry.Emit(OpCode::Load, 1).Emit(OpCode::Load, 0).Emit(OpCode::Call, mixIndex).Emit(OpCode::Store, 1);
+			});
+			entry.Emit(OpCode::Load, 1);
+
+			std::uint64_t accumulator = 0;
+			for (std::uint64_t i = 0; i < count; ++i) {
+				accumulator = accumulator * 31 + i;
+			}
+
+			Program result = MakeProgram("cross-module-call", "Calls of a function mapped from another module", std::to_string(accumulator), std::move(main));
+			result.Modules.emplace_back("lib.sbf", std::move(library));
+			return result;
+		}
+		Program CreateStdIO() {
+			constexpr std::uint64_t count = 200'000;
+
+			ByteFileWriter main;
+			const Operand zero = main.AddLong(0);
+			const Operand limit = main.AddLong(count);
+			const std::uint32_t io = main.AddDependency("/std/io.sbf");
+			const std::uint32_t getStdout = main.GetFunctionCount() + main.AddFunctionMapping(io, "getStdout");
+			const std::uint32_t writeLong = main.GetFunctionCount() + main.AddFunctionMapping(io, "writeLong");
+			const std::uint32_t flush = main.GetFunctionCount() + main.AddFunctionMapping(io, "flush");
+
+			InstructionsWriter& entry = main.GetEntrypoint();
+			entry.Emit(OpCode::Call, getStdout).Emit(OpCode::Store, 0); // stream
+			entry.Emit(OpCode::Push, zero).Emit(OpCode::Store, 1); // i
+			EmitLoop(entry, 1, limit, [&] {
+				entry.Emit(OpCode::Load, 1).Emit(OpCode::Load, 0).Emit(OpCode::Call, writeLong);
+			});
+			entry.Emit(OpCode::Load, 0).Emit(OpCode::Call, flush);
+			entry.Emit(OpCode::Load, 1);
+
+			return MakeProgram("std-io", "Writes to the standard output through /std/io.sbf", std::to_string(count), std::move(main));
+		}
+	}
+
+	std::vector<Program> CreateCorpus() {
+		std::vector<Program> result;
+		result.push_back(CreateIntLoop());
+		result.push_back(CreateRecursion());
+		result.push_back(CreateStructureField());
+		result.push_back(CreateArrayScan());
+		result.push_back(CreateGCChurn());
+		result.push_back(CreateCrossModuleCall());
+		result.push_back(CreateStdIO());
+		return result;
+	}
+	std::vector<std::string> SaveCorpus(const std::vector<Program>& corpus, const std::string& directory) {
+		std::vector<std::string> result;
+		for (const Program& program : corpus) {
+			const std::filesystem::path programDirectory = std::filesystem::path(directory) / program.Name;
+			std::filesystem::create_directories(programDirectory);
+
+			for (const auto& [fileName, module] : program.Modules) {
+				const std::string path = (programDirectory / fileName).string();
+				if (!module.Save(path)) throw std::runtime_error("Failed to write \"" + path + "\".");
+			}
+			result.push_back((programDirectory / program.Modules.front().first).string());
+		}
+		return result;
+	}
+}
\ No newline at end of file
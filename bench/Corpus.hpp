@@ -0,0 +1,20 @@
+#pragma once
+
+#include "ByteFileWriter.hpp"
+
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace svm::bench {
+	struct Program final {
+		std::string Name;
+		std::string Description;
+		std::vector<std::pair<std::string, ByteFileWriter>> Modules; // The first one is run, and the others are its dependencies
+		std::string ExpectedResult; // Empty if the result is not checked
+	};
+
+	std::vector<Program> CreateCorpus();
+	// Each program is saved in its own directory, so that relative dependencies are resolved. Returns the paths to run
+	std::vector<std::string> SaveCorpus(const std::vector<Program>& corpus, const std::string& directory);
+}
\ No newline at end of file
@@ -0,0 +1,291 @@
+#include "Corpus.hpp"
+
+#include <svm/Json.hpp>
+#include <svm/Macro.hpp>
+
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <exception>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <iterator>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#ifndef SVM_WINDOWS
+#	include <sys/resource.h>
+#	include <sys/types.h>
+#	include <sys/wait.h>
+#	include <unistd.h>
+#endif
+
+namespace {
+	struct Options final {
+		std::string VMPath;
+		std::string CorpusDirectory = "bench-corpus";
+		std::string OutputPath;
+		std::size_t RunCount = 10;
+		std::vector<std::string> Filters;
+	};
+
+	struct ProcessResult final {
+		int ExitCode = -1;
+		std::string Output;
+		double WallSeconds = 0;
+		std::uint64_t PeakRSS = 0; // In bytes
+	};
+
+	struct BenchmarkResult final {
+		std::string Name;
+		std::string Description;
+		std::uint64_t InstructionCount = 0;
+		std::vector<double> Interpreting;
+		std::vector<double> Wall;
+		std::uint64_t PeakRSS = 0;
+		bool IsResultValid = true;
+	};
+
+	std::optional<ProcessResult> RunProcess(const std::vector<std::string>& arguments) {
+#ifdef SVM_WINDOWS
+		return std::nullopt;
+#else
+		int pipes[2];
+		if (pipe(pipes) != 0) return std::nullopt;
+
+		const auto begin = std::chrono::steady_clock::now();
+		const pid_t pid = fork();
+		if (pid < 0) {
+			close(pipes[0]);
+			close(pipes[1]);
+			return std::nullopt;
+		} else if (pid == 0) {
+			dup2(pipes[1], STDOUT_FILENO);
+			dup2(pipes[1], STDERR_FILENO);
+			close(pipes[0]);
+			close(pipes[1]);
+
+			std::vector<char*> argv;
+			for (const std::string& argument : arguments) {
+				argv.push_back(const_cast<char*>(argument.c_str()));
+			}
+			argv.push_back(nullptr);
+			execv(argv[0], argv.data());
+			_exit(127);
+		}
+
+		close(pipes[1]);
+
+		ProcessResult result;
+		char buffer[4096];
+		ssize_t readSize;
+		while ((readSize = read(pipes[0], buffer, sizeof(buffer))) > 0) {
+			result.Output.append(buffer, static_cast<std::size_t>(readSize));
+		}
+		close(pipes[0]);
+
+		int status = 0;
+		rusage usage{};
+		if (wait4(pid, &status, 0, &usage) < 0) return std::nullopt;
+
+		const std::chrono::duration<double> wall = std::chrono::steady_clock::now() - begin;
+		result.WallSeconds = wall.count();
+		result.ExitCode = WIFEXITED(status) ? WEXITSTATUS(status) : -1;
+#	ifdef __APPLE__
+		result.PeakRSS = static_cast<std::uint64_t>(usage.ru_maxrss);
+#	else
+		result.PeakRSS = static_cast<std::uint64_t>(usage.ru_maxrss) * 1024;
+#	endif
+		return result;
+#endif
+	}
+
+	std::optional<std::string> FindLine(const std::string& output, std::string_view prefix) {
+		const std::size_t begin = output.find(prefix);
+		if (begin == std::string::npos) return std::nullopt;
+
+		const std::size_t valueBegin = begin + prefix.size();
+		return output.substr(valueBegin, output.find('\n', valueBegin) - valueBegin);
+	}
+	std::optional<double> GetInterpretingSeconds(const std::string& output) {
+		const auto line = FindLine(output, "Succeed interpreting in ");
+		if (!line) return std::nullopt;
+		else return std::strtod(line->c_str(), nullptr);
+	}
+
+	// Reads the count of executed instructions from the metrics the VM wrote with --metrics
+	std::optional<std::uint64_t> ReadInstructionCount(const std::string& metricsPath) {
+		std::ifstream metrics(metricsPath);
+		const std::string content((std::istreambuf_iterator<char>(metrics)), std::istreambuf_iterator<char>());
+
+		const auto line = FindLine(content, "\t\"instructions\": ");
+		if (!line) return std::nullopt;
+		else return std::strtoull(line->c_str(), nullptr, 10);
+	}
+
+	double GetPercentile(std::vector<double> values, double percentile) {
+		if (values.empty()) return 0;
+
+		std::sort(values.begin(), values.end());
+		const auto rank = static_cast<std::size_t>(percentile / 100 * static_cast<double>(values.size()) + 0.999999);
+		return values[std::clamp<std::size_t>(rank, 1, values.size()) - 1];
+	}
+	double GetMedian(std::vector<double> values) {
+		if (values.empty()) return 0;
+
+		std::sort(values.begin(), values.end());
+		const std::size_t middle = values.size() / 2;
+		return values.size() % 2 ? values[middle] : (values[middle - 1] + values[middle]) / 2;
+	}
+
+	void WriteJson(std::ostream& stream, const std::string& version, std::size_t runCount, const std::vector<BenchmarkResult>& results) {
+		stream << "{\n\t\"vm\": ";
+		svm::WriteJsonString(stream, version);
+		stream << ",\n\t\"runs\": " << runCount << ",\n\t\"benchmarks\": [";
+
+		stream << std::setprecision(9);
+		for (std::size_t i = 0; i < results.size(); ++i) {
+			const BenchmarkResult& result = results[i];
+			const double median = GetMedian(result.Interpreting);
+
+			stream << (i ? ",\n" : "\n") << "\t\t{\n\t\t\t\"name\": ";
+			svm::WriteJsonString(stream, result.Name);
+			stream << ",\n\t\t\t\"description\": ";
+			svm::WriteJsonString(stream, result.Description);
+			stream << ",\n\t\t\t\"valid\": " << (result.IsResultValid ? "true" : "false")
+				   << ",\n\t\t\t\"instructions\": " << result.InstructionCount
+				   << ",\n\t\t\t\"median_seconds\": " << median
+				   << ",\n\t\t\t\"p99_seconds\": " << GetPercentile(result.Interpreting, 99)
+				   << ",\n\t\t\t\"min_seconds\": " << GetPercentile(result.Interpreting, 0)
+				   << ",\n\t\t\t\"median_wall_seconds\": " << GetMedian(result.Wall)
+				   << ",\n\t\t\t\"instructions_per_second\": " << (median > 0 ? static_cast<double>(result.InstructionCount) / median : 0)
+				   << ",\n\t\t\t\"peak_rss_bytes\": " << result.PeakRSS
+				   << "\n\t\t}";
+		}
+		stream << "\n\t]\n}\n";
+	}
+
+	bool ParseOptions(int argc, char* argv[], Options& options) {
+#ifdef SVM_BENCH_VM_PATH
+		options.VMPath = SVM_BENCH_VM_PATH;
+#endif
+
+		for (int i = 1; i < argc; ++i) {
+			const std::string_view arg = argv[i];
+			if (arg.compare(0, 4, "-vm=") == 0) {
+				options.VMPath = arg.substr(4);
+			} else if (arg.compare(0, 8, "-corpus=") == 0) {
+				options.CorpusDirectory = arg.substr(8);
+			} else if (arg.compare(0, 3, "-o=") == 0) {
+				options.OutputPath = arg.substr(3);
+			} else if (arg.compare(0, 3, "-n=") == 0) {
+				options.RunCount = static_cast<std::size_t>(std::stoull(std::string(arg.substr(3))));
+			} else if (!arg.empty() && arg.front() != '-') {
+				options.Filters.emplace_back(arg);
+			} else {
+				std::cout << "Usage: ./ShitVM-bench [-vm=<ShitVM>] [-corpus=<Directory>] [-o=<JSON>] [-n=<Runs>] [Benchmarks...]\n";
+				return false;
+			}
+		}
+
+		if (options.VMPath.empty()) {
+			std::cout << "Error: There is no ShitVM executable.\n";
+			return false;
+		} else if (options.RunCount == 0) {
+			std::cout << "Error: Count of runs cannot be zero.\n";
+			return false;
+		}
+		return true;
+	}
+}
+
+int main(int argc, char* argv[]) {
+#ifdef SVM_WINDOWS
+	std::cout << "Error: The benchmark harness is not supported on Windows.\n";
+	return EXIT_FAILURE;
+#else
+
+	Options options;
+	if (!ParseOptions(argc, argv, options)) return EXIT_FAILURE;
+
+	const auto versionResult = RunProcess({ options.VMPath, "--version" });
+	if (!versionResult) {
+		std::cout << "Error: Failed to run \"" << options.VMPath << "\".\n";
+		return EXIT_FAILURE;
+	}
+	const std::string version = versionResult->Output.substr(0, versionResult->Output.find('\n'));
+
+	std::vector<svm::bench::Program> corpus = svm::bench::CreateCorpus();
+	if (!options.Filters.empty()) {
+		corpus.erase(std::remove_if(corpus.begin(), corpus.end(), [&options](const svm::bench::Program& program) {
+			return std::find(options.Filters.begin(), options.Filters.end(), program.Name) == options.Filters.end();
+		}), corpus.end());
+	}
+
+	std::vector<std::string> paths;
+	try {
+		paths = svm::bench::SaveCorpus(corpus, options.CorpusDirectory);
+	} catch (const std::exception& e) {
+		std::cout << "Error: " << e.what() << '\n';
+		return EXIT_FAILURE;
+	}
+
+	std::vector<BenchmarkResult> results;
+	for (std::size_t i = 0; i < corpus.size(); ++i) {
+		const svm::bench::Program& program = corpus[i];
+		BenchmarkResult& result = results.emplace_back();
+		result.Name = program.Name;
+		result.Description = program.Description;
+		std::cerr << program.Name << "..." << std::flush;
+
+		// Every run executes the same instructions, so the count is taken from the metrics of the first one
+		const std::string metricsPath = paths[i] + ".metrics.json";
+		for (std::size_t run = 0; run < options.RunCount; ++run) {
+			const auto process = RunProcess({ options.VMPath, paths[i], "--metrics=" + metricsPath });
+			const auto interpreting = process ? GetInterpretingSeconds(process->Output) : std::nullopt;
+			if (!process || process->ExitCode != 0 || !interpreting) {
+				result.IsResultValid = false;
+				break;
+			} else if (!program.ExpectedResult.empty() && FindLine(process->Output, "\tResult: ") != program.ExpectedResult) {
+				result.IsResultValid = false;
+			}
+
+			if (run == 0) {
+				const auto instructionCount = ReadInstructionCount(metricsPath);
+				if (!instructionCount) {
+					std::cerr << " (no instruction count)";
+					result.IsResultValid = false;
+					break;
+				}
+				result.InstructionCount = *instructionCount;
+			}
+
+			result.Interpreting.push_back(*interpreting);
+			result.Wall.push_back(process->WallSeconds);
+			result.PeakRSS = std::max(result.PeakRSS, process->PeakRSS);
+		}
+		std::cerr << (result.IsResultValid ? " done\n" : " invalid\n");
+	}
+
+	if (options.OutputPath.empty()) {
+		WriteJson(std::cout, version, options.RunCount, results);
+	} else {
+		std::ofstream output(options.OutputPath);
+		if (!output) {
+			std::cout << "Error: Failed to write \"" << options.OutputPath << "\".\n";
+			return EXIT_FAILURE;
+		}
+		WriteJson(output, version, options.RunCount, results);
+	}
+
+	const bool isAllValid = std::all_of(results.begin(), results.end(), [](const BenchmarkResult& result) {
+		return result.IsResultValid;
+	});
+	return isAllValid ? EXIT_SUCCESS : EXIT_FAILURE;
+#endif
+}
\ No newline at end of file
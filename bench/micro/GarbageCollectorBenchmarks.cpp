@@ -0,0 +1,112 @@
+#include "MicroBenchmark.hpp"
+
+#include <svm/GarbageCollector.hpp>
+#include <svm/Interpreter.hpp>
+#include <svm/Object.hpp>
+#include <svm/Type.hpp>
+#include <svm/gc/SimpleGarbageCollector.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <optional>
+#include <vector>
+
+namespace {
+	using namespace svm;
+	using namespace svm::bench;
+
+	constexpr std::size_t DefaultYoungGenerationSize = 8 * 1024 * 1024;
+	constexpr std::size_t DefaultOldGenerationSize = 32 * 1024 * 1024;
+
+	// Objects referenced by these roots survive collections, as if they were held by a native function
+	struct BenchmarkRoots final : GCRootProvider {
+		std::vector<GCPointerObject> Roots;
+
+		virtual void VisitGCRoots(const std::function<void(Type*)>& visitor) override {
+			for (GCPointerObject& root : Roots) {
+				visitor(reinterpret_cast<Type*>(&root));
+			}
+		}
+	};
+
+	// Allocates an object that holds no pointers. Only the header is a long, and the GC relies on the allocated size
+	void* AllocateObject(SimpleGarbageCollector& gc, Interpreter& interpreter, std::size_t size) {
+		void* const address = gc.Allocate(interpreter, size);
+		*reinterpret_cast<Type*>(static_cast<ManagedHeapInfo*>(address) + 1) = LongType;
+		return address;
+	}
+	void FillGeneration(SimpleGarbageCollector& gc, Interpreter& interpreter, std::size_t generationSize, std::size_t objectSize, std::uint64_t survivalPercent) {
+		BenchmarkRoots& roots = interpreter.GetLocalStates().Get<BenchmarkRoots>();
+		const std::size_t count = generationSize * 9 / 10 / (objectSize + sizeof(ManagedHeapInfo));
+
+		for (std::size_t i = 0; i < count; ++i) {
+			void* const address = AllocateObject(gc, interpreter, objectSize);
+			if (i % 100 < survivalPercent) {
+				roots.Roots.emplace_back(address);
+			}
+		}
+	}
+
+	void GCAllocate(State& state) {
+		constexpr std::size_t rootCount = 1024;
+		const auto survivalPercent = static_cast<std::uint64_t>(state.GetArgument(0));
+
+		Interpreter interpreter;
+		SimpleGarbageCollector gc(DefaultYoungGenerationSize, DefaultOldGenerationSize);
+		BenchmarkRoots& roots = interpreter.GetLocalStates().Get<BenchmarkRoots>();
+		roots.Roots.resize(rootCount);
+
+		std::uint64_t i = 0;
+		std::size_t nextRoot = 0;
+		while (state.KeepRunning()) {
+			void* const address = AllocateObject(gc, interpreter, sizeof(LongObject));
+			if (i++ % 100 < survivalPercent) {
+				roots.Roots[nextRoot++ % rootCount].Value = address; // The replaced object dies
+			}
+		}
+		state.SetItemsProcessed(state.GetIterations());
+		state.SetBytesProcessed(state.GetIterations() * sizeof(LongObject));
+	}
+	void GCMinor(State& state) {
+		const auto youngGenerationSize = static_cast<std::size_t>(state.GetArgument(0)) * 1024;
+		const auto survivalPercent = static_cast<std::uint64_t>(state.GetArgument(1));
+
+		std::optional<Interpreter> interpreter;
+		std::optional<SimpleGarbageCollector> gc;
+		while (state.KeepRunning()) {
+			state.PauseTiming();
+			interpreter.emplace();
+			gc.emplace(youngGenerationSize, DefaultOldGenerationSize);
+			FillGeneration(*gc, *interpreter, youngGenerationSize, sizeof(LongObject), survivalPercent);
+			state.ResumeTiming();
+
+			gc->ForceMinorGC(*interpreter);
+		}
+		state.SetBytesProcessed(state.GetIterations() * youngGenerationSize);
+	}
+	void GCMajor(State& state) {
+		constexpr std::size_t youngGenerationSize = 4096;
+		constexpr std::size_t objectSize = 8192; // Larger than a young block, so that it is allocated on the old generation
+
+		const auto oldGenerationSize = static_cast<std::size_t>(state.GetArgument(0)) * 1024;
+		const auto survivalPercent = static_cast<std::uint64_t>(state.GetArgument(1));
+
+		std::optional<Interpreter> interpreter;
+		std::optional<SimpleGarbageCollector> gc;
+		while (state.KeepRunning()) {
+			state.PauseTiming();
+			interpreter.emplace();
+			gc.emplace(youngGenerationSize, oldGenerationSize);
+			FillGeneration(*gc, *interpreter, oldGenerationSize, objectSize, survivalPercent);
+			state.ResumeTiming();
+
+			gc->ForceMajorGC(*interpreter);
+		}
+		state.SetBytesProcessed(state.GetIterations() * oldGenerationSize);
+	}
+
+	SVM_MICRO_BENCHMARK(GCAllocate).Arg(0).Arg(10).Arg(50).Arg(90);
+	SVM_MICRO_BENCHMARK(GCMinor).Args({ 1024, 10 }).Args({ 8192, 10 }).Args({ 8192, 50 }).Args({ 32768, 10 });
+	SVM_MICRO_BENCHMARK(GCMajor).Args({ 8192, 10 }).Args({ 32768, 10 }).Args({ 32768, 50 }).Args({ 131072, 10 });
+}
\ No newline at end of file
@@ -0,0 +1,49 @@
+#include "MicroBenchmark.hpp"
+#include "../ByteFileWriter.hpp"
+
+#include <svm/Loader.hpp>
+
+#include <cstdint>
+#include <cstdlib>
+#include <filesystem>
+#include <iostream>
+#include <string>
+
+namespace {
+	using svm::Loader;
+	using namespace svm::bench;
+
+	// Each function adds its own constant to the parameter, so the constant pool grows with the functions
+	std::string CreateSyntheticModule(std::uint32_t functionCount) {
+		ByteFileWriter module;
+		for (std::uint32_t i = 0; i < functionCount; ++i) {
+			const Operand constant = module.AddLong(i);
+			FunctionWriter& function = module.GetFunction(module.AddFunction("function" + std::to_string(i), 1, true));
+			function.Emit(OpCode::Load, 0).Emit(OpCode::Push, constant).Emit(OpCode::Add).Emit(OpCode::Ret);
+		}
+		module.GetEntrypoint().Emit(OpCode::Push, module.AddLong(0)).Emit(OpCode::Call, 0);
+
+		const std::filesystem::path path = std::filesystem::temp_directory_path() / ("svm-microbench-" + std::to_string(functionCount) + ".sbf");
+		if (!module.Save(path.string())) {
+			std::cerr << "Error: Failed to write \"" << path.string() << "\".\n";
+			std::exit(EXIT_FAILURE);
+		}
+		return path.string();
+	}
+
+	void LoaderLoad(State& state) {
+		const auto functionCount = static_cast<std::uint32_t>(state.GetArgument(0));
+		const std::string path = CreateSyntheticModule(functionCount);
+
+		while (state.KeepRunning()) {
+			Loader loader;
+			DoNotOptimize(loader.Load(path));
+		}
+		state.SetItemsProcessed(state.GetIterations() * functionCount);
+		state.SetBytesProcessed(state.GetIterations() * std::filesystem::file_size(path));
+
+		std::filesystem::remove(path);
+	}
+
+	SVM_MICRO_BENCHMARK(LoaderLoad).Arg(100).Arg(1000).Arg(10000);
+}
\ No newline at end of file
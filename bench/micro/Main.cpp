@@ -0,0 +1,45 @@
+#include "MicroBenchmark.hpp"
+
+#include <chrono>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <string_view>
+#include <vector>
+
+int main(int argc, char* argv[]) {
+	std::vector<std::string> filters;
+	std::string outputPath;
+	double minTime = 0.5;
+
+	for (int i = 1; i < argc; ++i) {
+		const std::string_view arg = argv[i];
+		if (arg.compare(0, 3, "-o=") == 0) {
+			outputPath = arg.substr(3);
+		} else if (arg.compare(0, 10, "-min-time=") == 0) {
+			minTime = std::strtod(argv[i] + 10, nullptr);
+		} else if (!arg.empty() && arg.front() != '-') {
+			filters.emplace_back(arg);
+		} else {
+			std::cout << "Usage: ./ShitVM-microbench [-o=<JSON>] [-min-time=<Seconds>] [Filters...]\n";
+			return EXIT_FAILURE;
+		}
+	}
+
+	if (minTime <= 0) {
+		std::cout << "Error: Minimum time must be positive.\n";
+		return EXIT_FAILURE;
+	}
+
+	const auto results = svm::bench::RunMicroBenchmarks(filters, std::chrono::duration<double>(minTime), std::cout);
+	if (!outputPath.empty()) {
+		std::ofstream output(outputPath);
+		if (!output) {
+			std::cout << "Error: Failed to write \"" << outputPath << "\".\n";
+			return EXIT_FAILURE;
+		}
+		svm::bench::WriteMicroBenchmarkJson(output, results);
+	}
+	return EXIT_SUCCESS;
+}
\ No newline at end of file
@@ -0,0 +1,184 @@
+#include "MicroBenchmark.hpp"
+
+#include <svm/Json.hpp>
+
+#include <algorithm>
+#include <cassert>
+#include <iomanip>
+#include <utility>
+
+namespace svm::bench {
+	State::State(std::uint64_t iterations, std::vector<std::int64_t> arguments)
+		: m_Iterations(iterations), m_Remaining(iterations), m_Arguments(std::move(arguments)) {}
+
+	bool State::KeepRunning() {
+		if (m_Remaining == m_Iterations && !m_IsRunning) {
+			ResumeTiming();
+		}
+
+		if (m_Remaining == 0) {
+			PauseTiming();
+			return false;
+		}
+
+		--m_Remaining;
+		return true;
+	}
+	void State::PauseTiming() noexcept {
+		if (!m_IsRunning) return;
+
+		m_Elapsed += std::chrono::steady_clock::now() - m_Begin;
+		m_IsRunning = false;
+	}
+	void State::ResumeTiming() noexcept {
+		if (m_IsRunning) return;
+
+		m_IsRunning = true;
+		m_Begin = std::chrono::steady_clock::now();
+	}
+
+	std::int64_t State::GetArgument(std::size_t index) const noexcept {
+		assert(index < m_Arguments.size());
+		return m_Arguments[index];
+	}
+	std::uint64_t State::GetIterations() const noexcept {
+		return m_Iterations;
+	}
+	void State::SetItemsProcessed(std::uint64_t itemsProcessed) noexcept {
+		m_ItemsProcessed = itemsProcessed;
+	}
+	void State::SetBytesProcessed(std::uint64_t bytesProcessed) noexcept {
+		m_BytesProcessed = bytesProcessed;
+	}
+
+	std::chrono::steady_clock::duration State::GetElapsed() const noexcept {
+		return m_Elapsed;
+	}
+	std::uint64_t State::GetItemsProcessed() const noexcept {
+		return m_ItemsProcessed;
+	}
+	std::uint64_t State::GetBytesProcessed() const noexcept {
+		return m_BytesProcessed;
+	}
+}
+
+namespace svm::bench {
+	MicroBenchmark::MicroBenchmark(std::string name, MicroBenchmarkFunction function)
+		: m_Name(std::move(name)), m_Function(function) {}
+
+	MicroBenchmark& MicroBenchmark::Arg(std::int64_t argument) {
+		m_Arguments.push_back({ argument });
+		return *this;
+	}
+	MicroBenchmark& MicroBenchmark::Args(std::initializer_list<std::int64_t> arguments) {
+		m_Arguments.emplace_back(arguments);
+		return *this;
+	}
+
+	const std::string& MicroBenchmark::GetName() const noexcept {
+		return m_Name;
+	}
+	MicroBenchmarkFunction MicroBenchmark::GetFunction() const noexcept {
+		return m_Function;
+	}
+	const std::vector<std::vector<std::int64_t>>& MicroBenchmark::GetArguments() const noexcept {
+		return m_Arguments;
+	}
+}
+
+namespace svm::bench {
+	namespace {
+		constexpr std::uint64_t MaxIterations = 1'000'000'000;
+
+		std::string GetInstanceName(const MicroBenchmark& benchmark, const std::vector<std::int64_t>& arguments) {
+			std::string result = benchmark.GetName();
+			for (const std::int64_t argument : arguments) {
+				result += '/';
+				result += std::to_string(argument);
+			}
+			return result;
+		}
+		bool IsSelected(const std::string& name, const std::vector<std::string>& filters) {
+			if (filters.empty()) return true;
+
+			return std::any_of(filters.begin(), filters.end(), [&name](const std::string& filter) {
+				return name.find(filter) != std::string::npos;
+			});
+		}
+
+		MicroBenchmarkResult RunInstance(MicroBenchmarkFunction function, const std::vector<std::int64_t>& arguments, std::chrono::duration<double> minTime) {
+			std::uint64_t iterations = 1;
+			while (true) {
+				State state(iterations, arguments);
+				function(state);
+
+				const std::chrono::duration<double> elapsed = state.GetElapsed();
+				if (elapsed >= minTime || iterations >= MaxIterations) {
+					MicroBenchmarkResult result;
+					result.Iterations = iterations;
+					result.NanosecondsPerIteration = elapsed.count() * 1e9 / static_cast<double>(iterations);
+					if (elapsed.count() > 0) {
+						result.ItemsPerSecond = static_cast<double>(state.GetItemsProcessed()) / elapsed.count();
+						result.BytesPerSecond = static_cast<double>(state.GetBytesProcessed()) / elapsed.count();
+					}
+					return result;
+				}
+
+				// Aim 40% past the minimum time, but grow at most tenfold at once
+				const double multiplier = elapsed.count() > 0 ? minTime.count() * 1.4 / elapsed.count() : 10;
+				iterations = std::min(MaxIterations, std::max(iterations + 1,
+					static_cast<std::uint64_t>(static_cast<double>(iterations) * std::min(multiplier, 10.0))));
+			}
+		}
+	}
+
+	MicroBenchmark& RegisterMicroBenchmark(const char* name, MicroBenchmarkFunction function) {
+		std::deque<MicroBenchmark>& benchmarks = GetMicroBenchmarks();
+		benchmarks.emplace_back(name, function);
+		return benchmarks.back();
+	}
+	std::deque<MicroBenchmark>& GetMicroBenchmarks() {
+		static std::deque<MicroBenchmark> benchmarks; // Registered references must stay valid
+		return benchmarks;
+	}
+
+	std::vector<MicroBenchmarkResult> RunMicroBenchmarks(const std::vector<std::string>& filters, std::chrono::duration<double> minTime, std::ostream& log) {
+		static const std::vector<std::vector<std::int64_t>> noArguments{ {} };
+
+		log << std::left << std::setw(48) << "Benchmark" << std::right << std::setw(16) << "Time" << std::setw(14) << "Iterations"
+			<< std::setw(16) << "Items/s" << std::setw(16) << "Bytes/s" << '\n';
+
+		std::vector<MicroBenchmarkResult> results;
+		for (const MicroBenchmark& benchmark : GetMicroBenchmarks()) {
+			const auto& argumentSets = benchmark.GetArguments().empty() ? noArguments : benchmark.GetArguments();
+			for (const std::vector<std::int64_t>& arguments : argumentSets) {
+				std::string name = GetInstanceName(benchmark, arguments);
+				if (!IsSelected(name, filters)) continue;
+
+				MicroBenchmarkResult& result = results.emplace_back(RunInstance(benchmark.GetFunction(), arguments, minTime));
+				result.Name = std::move(name);
+
+				log << std::left << std::setw(48) << result.Name << std::right << std::fixed << std::setprecision(1)
+					<< std::setw(13) << result.NanosecondsPerIteration << " ns" << std::setw(14) << result.Iterations
+					<< std::scientific << std::setprecision(3) << std::setw(16) << result.ItemsPerSecond
+					<< std::setw(16) << result.BytesPerSecond << std::defaultfloat << '\n';
+			}
+		}
+		return results;
+	}
+	void WriteMicroBenchmarkJson(std::ostream& stream, const std::vector<MicroBenchmarkResult>& results) {
+		stream << "{\n\t\"benchmarks\": [" << std::setprecision(9);
+		for (std::size_t i = 0; i < results.size(); ++i) {
+			const MicroBenchmarkResult& result = results[i];
+
+			stream << (i ? ",\n" : "\n") << "\t\t{\n\t\t\t\"name\": ";
+			WriteJsonString(stream, result.Name);
+			stream << ",\n\t\t\t\"iterations\": " << result.Iterations
+				   << ",\n\t\t\t\"ns_per_iteration\": " << result.NanosecondsPerIteration
+				   << ",\n\t\t\t\"items_per_second\": " << result.ItemsPerSecond
+				   << ",\n\t\t\t\"bytes_per_second\": " << result.BytesPerSecond
+				   << "\n\t\t}";
+		}
+		stream << "\n\t]\n}\n";
+	}
+}
\ No newline at end of file
@@ -0,0 +1,103 @@
+#pragma once
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <initializer_list>
+#include <ostream>
+#include <string>
+#include <vector>
+
+namespace svm::bench {
+	class State final {
+	private:
+		std::uint64_t m_Iterations = 0;
+		std::uint64_t m_Remaining = 0;
+		std::vector<std::int64_t> m_Arguments;
+
+		std::chrono::steady_clock::time_point m_Begin;
+		std::chrono::steady_clock::duration m_Elapsed{};
+		bool m_IsRunning = false;
+		std::uint64_t m_ItemsProcessed = 0;
+		std::uint64_t m_BytesProcessed = 0;
+
+	public:
+		State(std::uint64_t iterations, std::vector<std::int64_t> arguments);
+		State(const State&) = delete;
+		~State() = default;
+
+	public:
+		State& operator=(const State&) = delete;
+		bool operator==(const State&) = delete;
+		bool operator!=(const State&) = delete;
+
+	public:
+		// Starts the timer at the first call, and stops it after the last iteration
+		bool KeepRunning();
+		void PauseTiming() noexcept;
+		void ResumeTiming() noexcept;
+
+		std::int64_t GetArgument(std::size_t index) const noexcept;
+		std::uint64_t GetIterations() const noexcept;
+		void SetItemsProcessed(std::uint64_t itemsProcessed) noexcept;
+		void SetBytesProcessed(std::uint64_t bytesProcessed) noexcept;
+
+		std::chrono::steady_clock::duration GetElapsed() const noexcept;
+		std::uint64_t GetItemsProcessed() const noexcept;
+		std::uint64_t GetBytesProcessed() const noexcept;
+	};
+
+	using MicroBenchmarkFunction = void(*)(State&);
+
+	class MicroBenchmark final {
+	private:
+		std::string m_Name;
+		MicroBenchmarkFunction m_Function;
+		std::vector<std::vector<std::int64_t>> m_Arguments;
+
+	public:
+		MicroBenchmark(std::string name, MicroBenchmarkFunction function);
+		MicroBenchmark(MicroBenchmark&& benchmark) noexcept = default;
+		~MicroBenchmark() = default;
+
+	public:
+		MicroBenchmark& operator=(MicroBenchmark&& benchmark) noexcept = default;
+		bool operator==(const MicroBenchmark&) = delete;
+		bool operator!=(const MicroBenchmark&) = delete;
+
+	public:
+		MicroBenchmark& Arg(std::int64_t argument);
+		MicroBenchmark& Args(std::initializer_list<std::int64_t> arguments);
+
+		const std::string& GetName() const noexcept;
+		MicroBenchmarkFunction GetFunction() const noexcept;
+		const std::vector<std::vector<std::int64_t>>& GetArguments() const noexcept;
+	};
+
+	struct MicroBenchmarkResult final {
+		std::string Name;
+		std::uint64_t Iterations = 0;
+		double NanosecondsPerIteration = 0;
+		double ItemsPerSecond = 0;
+		double BytesPerSecond = 0;
+	};
+
+	MicroBenchmark& RegisterMicroBenchmark(const char* name, MicroBenchmarkFunction function);
+	std::deque<MicroBenchmark>& GetMicroBenchmarks();
+
+	// Runs each instance until it takes at least minTime, growing the count of iterations
+	std::vector<MicroBenchmarkResult> RunMicroBenchmarks(const std::vector<std::string>& filters, std::chrono::duration<double> minTime, std::ostream& log);
+	void WriteMicroBenchmarkJson(std::ostream& stream, const std::vector<MicroBenchmarkResult>& results);
+
+	template<typename T>
+	void DoNotOptimize(T&& value) noexcept;
+	void ClobberMemory() noexcept;
+}
+
+#define SVM_MICRO_BENCHMARK_CONCAT_IMPL(a, b) a##b
+#define SVM_MICRO_BENCHMARK_CONCAT(a, b) SVM_MICRO_BENCHMARK_CONCAT_IMPL(a, b)
+#define SVM_MICRO_BENCHMARK(function) \
+	[[maybe_unused]] static ::svm::bench::MicroBenchmark& SVM_MICRO_BENCHMARK_CONCAT(svmMicroBenchmark, __LINE__) = ::svm::bench::RegisterMicroBenchmark(#function, function)
+
+#include "detail/impl/MicroBenchmark.hpp"
\ No newline at end of file
@@ -0,0 +1,68 @@
+#include "MicroBenchmark.hpp"
+
+#include <svm/Heap.hpp>
+#include <svm/Object.hpp>
+#include <svm/Stack.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace {
+	using namespace svm;
+	using namespace svm::bench;
+
+	void StackPushPop(State& state) {
+		const auto depth = static_cast<std::uint64_t>(state.GetArgument(0));
+		Stack stack(1 * 1024 * 1024);
+
+		while (state.KeepRunning()) {
+			for (std::uint64_t i = 0; i < depth; ++i) {
+				stack.Push(LongObject(i));
+			}
+			for (std::uint64_t i = 0; i < depth; ++i) {
+				DoNotOptimize(stack.Pop<LongObject>());
+			}
+		}
+		state.SetItemsProcessed(state.GetIterations() * depth * 2);
+	}
+	void StackGet(State& state) {
+		const auto depth = static_cast<std::uint64_t>(state.GetArgument(0));
+		Stack stack(1 * 1024 * 1024);
+		std::vector<std::size_t> offsets;
+		for (std::uint64_t i = 0; i < depth; ++i) {
+			stack.Push(LongObject(i));
+			offsets.push_back(stack.GetUsedSize());
+		}
+
+		while (state.KeepRunning()) {
+			for (const std::size_t offset : offsets) {
+				DoNotOptimize(stack.Get<LongObject>(offset)->Value);
+			}
+		}
+		state.SetItemsProcessed(state.GetIterations() * depth);
+	}
+
+	void HeapAllocateUnmanaged(State& state) {
+		constexpr std::size_t batch = 64;
+		const auto size = static_cast<std::size_t>(state.GetArgument(0));
+		Heap heap;
+		void* addresses[batch];
+
+		while (state.KeepRunning()) {
+			for (void*& address : addresses) {
+				address = heap.AllocateUnmanagedHeap(size);
+			}
+			ClobberMemory();
+			for (void* address : addresses) {
+				heap.DeallocateUnmanagedHeap(address);
+			}
+		}
+		state.SetItemsProcessed(state.GetIterations() * batch);
+		state.SetBytesProcessed(state.GetIterations() * batch * size);
+	}
+
+	SVM_MICRO_BENCHMARK(StackPushPop).Arg(1).Arg(64).Arg(1024);
+	SVM_MICRO_BENCHMARK(StackGet).Arg(64).Arg(1024);
+	SVM_MICRO_BENCHMARK(HeapAllocateUnmanaged).Arg(16).Arg(256).Arg(4096);
+}
\ No newline at end of file
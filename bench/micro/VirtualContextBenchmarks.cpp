@@ -0,0 +1,90 @@
+#include "MicroBenchmark.hpp"
+
+#include <svm/Heap.hpp>
+#include <svm/Interpreter.hpp>
+#include <svm/Object.hpp>
+#include <svm/Stack.hpp>
+#include <svm/virtual/VirtualContext.hpp>
+#include <svm/virtual/VirtualStack.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace {
+	using namespace svm;
+	using namespace svm::bench;
+
+	// Reproduces the stack of a native function called with two long parameters
+	struct ContextFixture final {
+		svm::Interpreter Interpreter;
+		svm::Stack Stack{ 1 * 1024 * 1024 };
+		StackFrame Frame;
+		std::vector<std::size_t> LocalVariables;
+		svm::Heap Heap;
+		svm::VirtualStack VirtualStack{ &Stack, &Frame, &LocalVariables };
+		VirtualContext Context{ Interpreter, VirtualStack, Heap };
+
+		ContextFixture() {
+			for (std::uint64_t i = 0; i < 2; ++i) {
+				Stack.Push(LongObject(i + 1));
+				LocalVariables.push_back(Stack.GetUsedSize());
+			}
+			Frame.StackBegin = Stack.GetUsedSize();
+		}
+	};
+
+	void VirtualContextGetParameter(State& state) {
+		ContextFixture fixture;
+
+		while (state.KeepRunning()) {
+			DoNotOptimize(fixture.Context.GetParameter(0).ToLong() + fixture.Context.GetParameter(1).ToLong());
+		}
+		state.SetItemsProcessed(state.GetIterations() * 2);
+	}
+	void VirtualContextPushPop(State& state) {
+		ContextFixture fixture;
+
+		std::uint64_t i = 0;
+		while (state.KeepRunning()) {
+			DoNotOptimize(fixture.Context.PushFundamental(LongObject(i++)));
+			fixture.Context.Pop();
+		}
+		state.SetItemsProcessed(state.GetIterations());
+	}
+	void VirtualContextGetElement(State& state) {
+		const auto count = static_cast<std::uint64_t>(state.GetArgument(0));
+		ContextFixture fixture;
+		const VirtualObject array = fixture.Context.PushFundamental(LongObject(), count);
+
+		while (state.KeepRunning()) {
+			std::uint64_t sum = 0;
+			for (std::uint64_t i = 0; i < count; ++i) {
+				sum += fixture.Context.GetElement(array, i).ToLong();
+			}
+			DoNotOptimize(sum);
+		}
+		state.SetItemsProcessed(state.GetIterations() * count);
+	}
+	void VirtualContextGetSpan(State& state) {
+		const auto count = static_cast<std::uint64_t>(state.GetArgument(0));
+		ContextFixture fixture;
+		const VirtualObject array = fixture.Context.PushFundamental(LongObject(), count);
+
+		while (state.KeepRunning()) {
+			const VirtualSpan<std::uint64_t> span = fixture.Context.GetSpan<std::uint64_t>(array);
+
+			std::uint64_t sum = 0;
+			for (std::uint64_t i = 0; i < span.GetCount(); ++i) {
+				sum += span[i];
+			}
+			DoNotOptimize(sum);
+		}
+		state.SetItemsProcessed(state.GetIterations() * count);
+	}
+
+	SVM_MICRO_BENCHMARK(VirtualContextGetParameter);
+	SVM_MICRO_BENCHMARK(VirtualContextPushPop);
+	SVM_MICRO_BENCHMARK(VirtualContextGetElement).Arg(64).Arg(4096);
+	SVM_MICRO_BENCHMARK(VirtualContextGetSpan).Arg(64).Arg(4096);
+}
\ No newline at end of file
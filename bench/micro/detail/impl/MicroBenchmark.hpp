@@ -0,0 +1,27 @@
+#pragma once
+#include "../../MicroBenchmark.hpp"
+
+#include <svm/Macro.hpp>
+
+#ifdef SVM_MSVC
+#	include <intrin.h>
+#endif
+
+namespace svm::bench {
+	template<typename T>
+	void DoNotOptimize(T&& value) noexcept {
+#ifdef SVM_MSVC
+		static_cast<void>(*const_cast<volatile char*>(reinterpret_cast<const volatile char*>(&value)));
+		_ReadWriteBarrier();
+#else
+		asm volatile("" : : "r,m"(value) : "memory");
+#endif
+	}
+	inline void ClobberMemory() noexcept {
+#ifdef SVM_MSVC
+		_ReadWriteBarrier();
+#else
+		asm volatile("" : : : "memory");
+#endif
+	}
+}
\ No newline at end of file
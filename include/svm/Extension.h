@@ -0,0 +1,96 @@
+#pragma once
+
+/*
+ * C interface of native extension modules.
+ *
+ * An extension is a shared library that exports svm_extension_init. When a module depends on a virtual path
+ * such as "/zlib/inflate.sbf" and no built-in module provides it, the loader looks for "zlib/inflate.so"
+ * (".dll" on Windows, ".dylib" on macOS) in the library directories given with -L, loads it, and lets
+ * svm_extension_init register the structures and functions of the module.
+ *
+ * The extension must keep the SvmExtensionApi pointer it receives to use it from its functions.
+ */
+
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define SVM_EXTENSION_VERSION			1
+#define SVM_EXTENSION_INIT				"svm_extension_init"
+
+#ifdef _WIN32
+#	define SVM_EXTENSION_EXPORT __declspec(dllexport)
+#else
+#	define SVM_EXTENSION_EXPORT __attribute__((visibility("default")))
+#endif
+
+/*
+ * Exception codes the interface returns, and extensions may return.
+ * They are spelled exactly like svm/detail/InterpreterExceptionCode.hpp, so that both headers can be included together.
+ */
+#define SVM_IEC_NONE							0xFFFFFFFF
+#define SVM_IEC_TYPE_OUTOFRANGE					0x00000000
+#define SVM_IEC_STACK_OVERFLOW					0x00000001
+#define SVM_IEC_LOCALVARIABLE_OUTOFRANGE		0x00000006
+#define SVM_IEC_POINTER_NULLPOINTER				0x0000000B
+#define SVM_IEC_POINTER_UNKNOWNADDRESS			0x0000000E
+#define SVM_IEC_STRUCTURE_FIELD_OUTOFRANGE		0x0000000F
+#define SVM_IEC_STRUCTURE_NOTSTRUCTURE			0x00000010
+#define SVM_IEC_ARRAY_COUNT_CANNOTBEZERO		0x00000012
+#define SVM_IEC_ARRAY_NOTARRAY					0x00000015
+#define SVM_IEC_STDLIB_TYPEASSERTFAIL			0x00000017
+#define SVM_IEC_STDLIB_ARRAY_OUTOFRANGE			0x00000018
+#define SVM_IEC_STDLIB_OUTOFMEMORY				0x00000022
+
+#define SVM_EXTENSION_TYPE_NONE			0 /* Accepts any parameter */
+#define SVM_EXTENSION_TYPE_INT			1
+#define SVM_EXTENSION_TYPE_LONG			2
+#define SVM_EXTENSION_TYPE_DOUBLE		3
+#define SVM_EXTENSION_TYPE_POINTER		4
+#define SVM_EXTENSION_TYPE_GCPOINTER	5
+
+typedef struct SvmModule SvmModule;
+typedef struct SvmContext SvmContext;
+
+typedef struct SvmValue {
+	uint32_t Type;
+	union {
+		uint32_t Int;
+		uint64_t Long;
+		double Double;
+		uint64_t Pointer; /* Opaque, for both pointer types */
+	} Value;
+} SvmValue;
+
+typedef struct SvmArray {
+	uint32_t ElementType;
+	uint64_t Count;
+	void* Data; /* Count packed values of ElementType */
+} SvmArray;
+
+/* Every function returns SVM_IEC_NONE, or the code of the exception to occur */
+typedef uint32_t(*SvmNativeFunction)(SvmContext* context);
+
+typedef struct SvmExtensionApi {
+	uint32_t Version;
+
+	/* Only valid in svm_extension_init. parameterTypes may be NULL, or must have arity elements. */
+	uint32_t(*AddStructure)(SvmModule* module, const char* name, const uint32_t* fieldTypes, uint32_t fieldCount, uint32_t* structure);
+	uint32_t(*AddFunction)(SvmModule* module, const char* name, uint16_t arity, int hasResult, SvmNativeFunction function, const uint32_t* parameterTypes);
+
+	/* Only valid in a SvmNativeFunction. A structure or an array parameter may also be passed by a pointer. */
+	uint32_t(*GetParameter)(SvmContext* context, uint16_t index, SvmValue* value);
+	uint32_t(*GetField)(SvmContext* context, uint16_t index, uint32_t field, SvmValue* value);
+	uint32_t(*GetArray)(SvmContext* context, uint16_t index, SvmArray* array);
+	uint32_t(*Push)(SvmContext* context, const SvmValue* value);
+	uint32_t(*PushStructure)(SvmContext* context, uint32_t structure, const SvmValue* fields, uint32_t fieldCount); /* fieldCount must match the structure */
+	uint32_t(*NewArray)(SvmContext* context, uint32_t elementType, uint64_t count, SvmArray* array); /* Pushes a pointer to the array */
+} SvmExtensionApi;
+
+typedef uint32_t(*SvmExtensionInit)(const SvmExtensionApi* api, SvmModule* module);
+
+#ifdef __cplusplus
+}
+#endif
\ No newline at end of file
@@ -0,0 +1,31 @@
+#pragma once
+
+#include <svm/Extension.h>
+
+#include <filesystem>
+
+namespace svm {
+	class Extension final {
+	private:
+		void* m_Handle = nullptr;
+
+	public:
+		Extension() noexcept = default;
+		explicit Extension(const std::filesystem::path& path);
+		Extension(Extension&& extension) noexcept;
+		~Extension();
+
+	public:
+		Extension& operator=(Extension&& extension) noexcept;
+		bool operator==(const Extension&) = delete;
+		bool operator!=(const Extension&) = delete;
+
+	public:
+		void Close() noexcept;
+		bool IsOpen() const noexcept;
+		SvmExtensionInit GetInit() const noexcept;
+
+		static const char* GetFileExtension() noexcept;
+		static const SvmExtensionApi& GetApi() noexcept;
+	};
+}
\ No newline at end of file
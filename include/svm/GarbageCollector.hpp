@@ -1,9 +1,12 @@
 #pragma once
 
 #include <svm/Stack.hpp>
+#include <svm/Type.hpp>
 
+#include <chrono>
 #include <cstddef>
 #include <cstdint>
+#include <functional>
 #include <list>
 
 namespace svm {
@@ -30,6 +33,7 @@ namespace svm {
 		std::list<Stack> m_Blocks;
 		Block m_CurrentBlock;
 		std::size_t m_DefaultBlockSize = 0;
+		std::size_t m_Size = 0;
 
 	public:
 		ManagedHeapGeneration() = default;
@@ -67,13 +71,30 @@ namespace svm {
 
 		std::size_t GetDefaultBlockSize() const noexcept;
 		std::size_t GetBlockCount() const noexcept;
+		// Total size of the blocks, including their free space
+		std::size_t GetSize() const noexcept;
 	};
 }
 
 namespace svm {
+	struct GarbageCollectorStatistics final {
+		std::uint64_t MinorGCCount = 0;
+		std::uint64_t MajorGCCount = 0;
+		// A major GC during a minor GC is only charged to the major GC
+		std::chrono::steady_clock::duration MinorGCPause{};
+		std::chrono::steady_clock::duration MajorGCPause{};
+		std::size_t PeakHeapSize = 0;
+	};
+
 	class Interpreter;
 
 	class GarbageCollector {
+	private:
+		std::size_t m_PinCount = 0;
+
+	protected:
+		GarbageCollectorStatistics m_Statistics;
+
 	protected:
 		GarbageCollector() noexcept = default;
 		GarbageCollector(const GarbageCollector&) = delete;
@@ -89,5 +110,31 @@ namespace svm {
 	public:
 		virtual void* Allocate(Interpreter& interpreter, std::size_t size) = 0;
 		virtual void MakeDirty(const void* address) noexcept = 0;
+
+		// While pinned, collections are deferred so that no object is moved
+		void Pin() noexcept;
+		void Unpin() noexcept;
+		bool IsPinned() const noexcept;
+		const GarbageCollectorStatistics& GetStatistics() const noexcept;
+	};
+}
+
+namespace svm {
+	// Local states that keep objects outside of the stack report them to the GC as roots
+	class GCRootProvider {
+	protected:
+		GCRootProvider() noexcept = default;
+		GCRootProvider(const GCRootProvider&) = delete;
+
+	public:
+		virtual ~GCRootProvider() = default;
+
+	public:
+		GCRootProvider& operator=(const GCRootProvider&) = delete;
+		bool operator==(const GCRootProvider&) = delete;
+		bool operator!=(const GCRootProvider&) = delete;
+
+	public:
+		virtual void VisitGCRoots(const std::function<void(Type*)>& visitor) = 0;
 	};
 }
\ No newline at end of file
@@ -13,6 +13,8 @@ namespace svm {
 	class Heap final {
 	private:
 		std::unordered_map<void*, std::size_t> m_UnmanagedHeap;
+		std::size_t m_UnmanagedHeapSize = 0;
+		std::size_t m_PeakUnmanagedHeapSize = 0;
 		std::unique_ptr<GarbageCollector> m_GarbageCollector;
 
 	public:
@@ -29,9 +31,15 @@ namespace svm {
 		void Deallocate() noexcept;
 
 		void* AllocateUnmanagedHeap(std::size_t size);
+		void* ReallocateUnmanagedHeap(void* address, std::size_t size) noexcept;
 		bool DeallocateUnmanagedHeap(void* address) noexcept;
+		std::size_t GetUnmanagedHeapSize() const noexcept;
+		std::size_t GetPeakUnmanagedHeapSize() const noexcept;
 
 		void SetGarbageCollector(std::unique_ptr<GarbageCollector>&& gc) noexcept;
+		const GarbageCollector* GetGarbageCollector() const noexcept;
 		void* AllocateManagedHeap(Interpreter& interpreter, std::size_t size);
+		void PinManagedHeap() noexcept;
+		void UnpinManagedHeap() noexcept;
 	};
 }
\ No newline at end of file
@@ -7,13 +7,20 @@
 #include <svm/Heap.hpp>
 #include <svm/Instruction.hpp>
 #include <svm/Loader.hpp>
+#include <svm/LocalStateTable.hpp>
 #include <svm/Module.hpp>
 #include <svm/Object.hpp>
+#include <svm/PerfCounters.hpp>
+#include <svm/PerfMap.hpp>
 #include <svm/Predefined.hpp>
+#include <svm/Profiler.hpp>
+#include <svm/Sampler.hpp>
 #include <svm/Stack.hpp>
+#include <svm/Tracer.hpp>
 #include <svm/Type.hpp>
 #include <svm/virtual/VirtualFunction.hpp>
 
+#include <chrono>
 #include <cstddef>
 #include <cstdint>
 #include <memory>
@@ -34,6 +41,19 @@ namespace svm {
 	};
 }
 
+namespace svm {
+	enum class InterpretResult {
+		Completed,
+		Suspended,
+		Exception,
+	};
+
+	struct InterpretBudget final {
+		std::uint64_t InstructionCount = 0; // 0 means no limit
+		std::chrono::steady_clock::time_point Deadline = std::chrono::steady_clock::time_point::max();
+	};
+}
+
 namespace svm {
 	namespace detail {
 		struct ArrayInfo final {
@@ -46,20 +66,29 @@ namespace svm {
 
 	class Interpreter final {
 	private:
-		Loader m_Loader;
+		ModuleStore m_Loader;
 		std::optional<InterpreterException> m_Exception;
 
 		Stack m_Stack;
 		StackFrame m_StackFrame;
 		std::size_t m_Depth = 0;
+		std::size_t m_MaxDepth = 0;
+		std::uint64_t m_InstructionCount = 0;
 
 		std::vector<std::size_t> m_LocalVariables;
 
 		Heap m_Heap;
+		LocalStateTable m_LocalStates;
+
+		std::unique_ptr<Profiler> m_Profiler;
+		PerfCounters* m_PerfCounters = nullptr;
+		std::unique_ptr<PerfMap> m_PerfMap;
+		std::unique_ptr<Tracer> m_Tracer;
 
 	public:
 		Interpreter() noexcept = default;
-		Interpreter(Loader&& loader, Module program) noexcept;
+		Interpreter(Loader&& loader, Module program);
+		Interpreter(ModuleStore loader, Module program) noexcept;
 		Interpreter(Interpreter&& interpreter) noexcept;
 		~Interpreter() = default;
 
@@ -70,13 +99,24 @@ namespace svm {
 
 	public:
 		void Clear() noexcept;
-		void Load(Loader&& loader, Module program) noexcept;
+		void Load(Loader&& loader, Module program);
+		void Load(ModuleStore loader, Module program) noexcept;
 
 		void AllocateStack(std::size_t size = 1 * 1024 * 1024);
 		void ReallocateStack(std::size_t newSize);
 		void SetGarbageCollector(std::unique_ptr<GarbageCollector>&& gc) noexcept;
+		void SetProfiler(std::unique_ptr<Profiler>&& profiler) noexcept;
+		Profiler* GetProfiler() noexcept;
+		// The counters are not owned, so that they can also measure the phases outside of the interpreter
+		void SetPerfCounters(PerfCounters* perfCounters) noexcept;
+		PerfCounters* GetPerfCounters() noexcept;
+		void SetPerfMap(std::unique_ptr<PerfMap>&& perfMap) noexcept;
+		PerfMap* GetPerfMap() noexcept;
+		void SetTracer(std::unique_ptr<Tracer>&& tracer) noexcept;
+		Tracer* GetTracer() noexcept;
 
 		bool Interpret();
+		InterpretResult Interpret(const InterpretBudget& budget);
 		bool HasResult() const noexcept;
 		const Object* GetResult() const noexcept;
 		void PrintObject(std::ostream& stream, const Object& object) const;
@@ -87,6 +127,8 @@ namespace svm {
 		bool HasException() const noexcept;
 		const InterpreterException& GetException() const noexcept;
 		std::vector<StackFrame> GetCallStacks() const;
+		// Async-signal-safe. The sample may be inconsistent if the interpreter is in the middle of a call or a return
+		void CaptureSample(detail::Sample& sample) const noexcept;
 
 	public:
 		Type GetType(TypeCode code) const noexcept;
@@ -99,8 +141,27 @@ namespace svm {
 		const Type* GetLocalVariable(std::uint32_t index) const noexcept;
 		Type* GetLocalVariable(std::uint32_t index) noexcept;
 		std::uint32_t GetLocalVariableCount() const noexcept;
+		const ModuleStore& GetModuleStore() const noexcept;
+		LocalStateTable& GetLocalStates() noexcept;
+		const Stack& GetStack() const noexcept;
+		const Heap& GetHeap() const noexcept;
+		std::uint64_t GetInstructionCount() const noexcept;
+		std::size_t GetMaxDepth() const noexcept;
 
 	private:
+		static constexpr std::uint64_t DeadlineCheckInterval = 1024;
+
+		template<bool UseBudget, bool UseProfiler, bool UseTracer>
+		InterpretResult InterpretLoop(std::uint64_t instructionCount, std::chrono::steady_clock::time_point deadline);
+		template<bool UseBudget, bool UseProfiler, bool UseTracer, bool UseTrampoline = false>
+		InterpretResult InterpretInstructions(std::uint64_t& instructionCount, std::chrono::steady_clock::time_point deadline);
+		template<bool UseBudget>
+		InterpretResult InterpretInTrampolines(std::uint64_t& instructionCount, std::chrono::steady_clock::time_point deadline);
+		template<bool UseBudget>
+		static void InterpretTrampolineFrame(void* context);
+		void TraceLocation() noexcept;
+		void TraceTopValue() noexcept;
+		void PrintPackedElement(std::ostream& stream, Type type, const void* value) const;
 		void PrintPointerTaget(std::ostream& stream, const Object& object) const;
 
 	public:
@@ -125,6 +186,7 @@ namespace svm {
 	public:
 		void InitStructure(Object* object, Structure structure) noexcept;
 		void InitArray(Object* object, Type type, std::uint64_t count) noexcept;
+		// Returns 0 if the size does not fit in std::size_t
 		std::size_t CalcArraySize(Type type, std::uint64_t count) const noexcept;
 
 	private:
@@ -0,0 +1,9 @@
+#pragma once
+
+#include <ostream>
+#include <string_view>
+
+namespace svm {
+	// Writes the string as a quoted JSON string, escaping quotes, backslashes and every control character
+	void WriteJsonString(std::ostream& stream, std::string_view string);
+}
\ No newline at end of file
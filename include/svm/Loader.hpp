@@ -1,11 +1,22 @@
 #pragma once
 
+#include <svm/Extension.hpp>
+#include <svm/Module.hpp>
+#include <svm/ThreadPool.hpp>
+#include <svm/core/ByteFile.hpp>
 #include <svm/core/Loader.hpp>
 #include <svm/virtual/VirtualFunction.hpp>
 #include <svm/virtual/VirtualModule.hpp>
 
+#include <chrono>
+#include <cstdint>
+#include <functional>
 #include <memory>
+#include <optional>
 #include <string>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
 
 namespace svm {
 	namespace detail {
@@ -19,23 +30,66 @@ namespace svm {
 		private:
 			using core::Loader<VirtualFunctionInfo>::Create;
 		};
+
+		struct ParsedModule final {
+			core::ByteFile ByteFile;
+			std::vector<std::string> Dependencies;
+			std::chrono::steady_clock::duration ParseTime{};
+		};
 	}
+
+	struct ModuleLoadTime final {
+		std::string Path;
+		std::chrono::steady_clock::duration Parse{};
+		std::chrono::steady_clock::duration Link{};
+	};
 	
 	class Loader final : public detail::LoaderAdapter {
+	public:
+		using ModuleProvider = std::function<void(Loader&)>;
+
+	private:
+		std::vector<std::string> m_LibraryDirectories;
+		std::unordered_set<std::string> m_ModulePaths;
+		std::unordered_map<std::string, ModuleProvider> m_ModuleProviders;
+		std::vector<Extension> m_Extensions;
+		std::vector<ModuleLoadTime> m_LoadTimes;
+
 	public:
 		using detail::LoaderAdapter::LoaderAdapter;
 
 	public:
 		VirtualModule& Create(std::string virtualPath);
+		void AddLibraryDirectory(std::string directory);
+		void AddModuleProvider(std::string virtualPath, ModuleProvider provider);
+		bool Provide(const std::string& virtualPath);
+		Module Load(const std::string& path);
+		// Byte files loaded so far in the order of linking. Virtual modules and extensions are not included
+		const std::vector<ModuleLoadTime>& GetModuleLoadTimes() const noexcept;
+
+	private:
+		bool LoadExtension(const std::string& virtualPath);
+		std::vector<detail::ParsedModule> ParseModules(const std::vector<std::string>& paths, std::optional<ThreadPool>& threadPool) const;
+		std::string ResolveDependency(const std::string& modulePath, const std::string& dependency) const;
+		void SortModules(const std::string& path, const std::unordered_map<std::string, detail::ParsedModule>& modules,
+			std::unordered_set<std::string>& visited, std::vector<std::string>& result) const;
+
+		static detail::ParsedModule ParseModule(const std::string& path);
 	};
+
+	// Loaded modules are never modified after linking, so one store can be shared by any number of interpreters
+	using ModuleStore = std::shared_ptr<const Loader>;
 }
 
 namespace svm {
-	namespace detail {
-		struct StdModuleState;
-	}
+	class LocalStateTable;
 
-	using StdModule = std::shared_ptr<detail::StdModuleState>;
+	struct StdIOStatistics final {
+		std::uint64_t ReadSize = 0;
+		std::uint64_t WrittenSize = 0;
+	};
 
-	StdModule InitStdModule(Loader& loader);
+	void InitStdModule(Loader& loader);
+	// Bytes read and written through the streams of /std/io.sbf, including the closed ones
+	StdIOStatistics GetStdIOStatistics(LocalStateTable& localStates);
 }
\ No newline at end of file
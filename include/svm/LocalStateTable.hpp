@@ -0,0 +1,42 @@
+#pragma once
+
+#include <svm/GarbageCollector.hpp>
+#include <svm/Type.hpp>
+
+#include <functional>
+#include <memory>
+#include <typeindex>
+#include <unordered_map>
+#include <vector>
+
+namespace svm {
+	class LocalStateTable final {
+	private:
+		std::unordered_map<std::type_index, std::shared_ptr<void>> m_States;
+		std::vector<GCRootProvider*> m_GCRootProviders;
+
+	public:
+		LocalStateTable() = default;
+		LocalStateTable(LocalStateTable&& table) noexcept = default;
+		~LocalStateTable() = default;
+
+	public:
+		LocalStateTable& operator=(LocalStateTable&& table) noexcept = default;
+		bool operator==(const LocalStateTable&) = delete;
+		bool operator!=(const LocalStateTable&) = delete;
+
+	public:
+		void Clear() noexcept;
+
+		template<typename T>
+		T& Get();
+		// Unlike Get, returns nullptr instead of creating the state
+		template<typename T>
+		T* Find();
+		template<typename T>
+		const T* Find() const;
+		void VisitGCRoots(const std::function<void(Type*)>& visitor);
+	};
+}
+
+#include "detail/impl/LocalStateTable.hpp"
\ No newline at end of file
@@ -19,6 +19,10 @@
 #	define SVM_LITTLE
 #endif
 
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#	define SVM_SSE2
+#endif
+
 #if defined(_MSC_VER)
 #	define SVM_MSVC
 #elif defined(__GNUC__)
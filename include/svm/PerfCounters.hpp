@@ -0,0 +1,89 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <ostream>
+#include <vector>
+
+namespace svm {
+	enum class PerfEvent {
+		Cycles,
+		Instructions,
+		BranchMisses,
+		CacheMisses,
+		DTLBMisses,
+	};
+
+	enum class VMPhase {
+		Loading,
+		Interpreting,
+		MinorGC,
+		MajorGC,
+	};
+
+	namespace detail {
+		constexpr std::size_t PerfEventCount = 5;
+		constexpr std::size_t VMPhaseCount = 4;
+
+		using PerfCounts = std::array<std::uint64_t, PerfEventCount>;
+	}
+
+	// Counts hardware events of the calling thread with perf_event_open. Nested phases are excluded from their parents
+	class PerfCounters final {
+	private:
+		std::array<int, detail::PerfEventCount> m_Descriptors;
+		std::array<detail::PerfCounts, detail::VMPhaseCount> m_Counts{};
+		std::array<std::uint64_t, detail::VMPhaseCount> m_EnterCounts{};
+		std::vector<VMPhase> m_Phases;
+		detail::PerfCounts m_LastRead{};
+
+	public:
+		PerfCounters() noexcept;
+		PerfCounters(const PerfCounters&) = delete;
+		~PerfCounters();
+
+	public:
+		PerfCounters& operator=(const PerfCounters&) = delete;
+		bool operator==(const PerfCounters&) = delete;
+		bool operator!=(const PerfCounters&) = delete;
+
+	public:
+		// Returns false if no event can be counted. Events that the CPU or the kernel does not allow are skipped
+		bool Open();
+		void Close() noexcept;
+		bool IsOpened() const noexcept;
+		bool IsAvailable(PerfEvent event) const noexcept;
+
+		void EnterPhase(VMPhase phase);
+		void LeavePhase() noexcept;
+
+		std::uint64_t GetCount(VMPhase phase, PerfEvent event) const noexcept;
+		std::uint64_t GetEnterCount(VMPhase phase) const noexcept;
+		void WriteReport(std::ostream& stream) const;
+
+		static bool IsSupported() noexcept;
+		static const char* GetEventName(PerfEvent event) noexcept;
+		static const char* GetPhaseName(VMPhase phase) noexcept;
+
+	private:
+		detail::PerfCounts Read() const noexcept;
+		void Account(const detail::PerfCounts& counts) noexcept;
+	};
+
+	// Does nothing if counters is nullptr
+	class PerfPhaseScope final {
+	private:
+		PerfCounters* m_Counters;
+
+	public:
+		PerfPhaseScope(PerfCounters* counters, VMPhase phase);
+		PerfPhaseScope(const PerfPhaseScope&) = delete;
+		~PerfPhaseScope();
+
+	public:
+		PerfPhaseScope& operator=(const PerfPhaseScope&) = delete;
+		bool operator==(const PerfPhaseScope&) = delete;
+		bool operator!=(const PerfPhaseScope&) = delete;
+	};
+}
\ No newline at end of file
@@ -0,0 +1,53 @@
+#pragma once
+
+#include <svm/Loader.hpp>
+#include <svm/Profiler.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <fstream>
+#include <string_view>
+#include <utility>
+#include <unordered_map>
+#include <vector>
+
+namespace svm {
+	using TrampolineTarget = void(*)(void* context);
+	using Trampoline = void(*)(void* context, TrampolineTarget target);
+
+	// Writes /tmp/perf-<pid>.map, so that native profilers such as perf can symbolize generated code.
+	// Each function gets its own trampoline, and the interpreter runs the function inside it.
+	// Samples land in the interpreter loop called by the trampoline, so they are attributed through call graphs:
+	// build with SVM_FRAME_POINTERS and record with perf record --call-graph=fp
+	class PerfMap final {
+	private:
+		std::ofstream m_Stream;
+		std::vector<std::pair<std::uint8_t*, std::size_t>> m_Pages;
+		std::size_t m_PageUsedSize = 0;
+		std::unordered_map<ProfiledFunction, Trampoline> m_Trampolines;
+
+	public:
+		PerfMap() noexcept = default;
+		PerfMap(const PerfMap&) = delete;
+		~PerfMap();
+
+	public:
+		PerfMap& operator=(const PerfMap&) = delete;
+		bool operator==(const PerfMap&) = delete;
+		bool operator!=(const PerfMap&) = delete;
+
+	public:
+		// Returns false if the map cannot be written or trampolines are not supported
+		bool Open();
+		bool IsOpened() const noexcept;
+
+		// Code generated outside of the trampolines, such as a JIT compiler, can be registered here
+		void AddEntry(const void* address, std::size_t size, std::string_view name);
+		Trampoline GetTrampoline(const ProfiledFunction& function, const Loader& loader);
+
+		static bool IsSupported() noexcept;
+
+	private:
+		Trampoline CreateTrampoline();
+	};
+}
\ No newline at end of file
@@ -0,0 +1,100 @@
+#pragma once
+
+#include <svm/Function.hpp>
+#include <svm/Instruction.hpp>
+#include <svm/Loader.hpp>
+#include <svm/virtual/VirtualFunction.hpp>
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <ostream>
+#include <string>
+#include <unordered_map>
+#include <variant>
+#include <vector>
+
+namespace svm {
+	using ProfiledFunction = std::variant<std::monostate, Function, VirtualFunction>;
+
+	struct OpCodeProfile final {
+		std::uint64_t Count = 0;
+		std::uint64_t Cycles = 0;
+	};
+
+	struct FunctionProfile final {
+		std::uint64_t CallCount = 0;
+		std::uint64_t InclusiveCycles = 0;
+		std::uint64_t ExclusiveCycles = 0;
+		std::size_t ActiveCount = 0;
+	};
+
+	namespace detail {
+		// A node of the calling context tree. The root is the entrypoint
+		struct CallNode final {
+			ProfiledFunction Function;
+			FunctionProfile* Profile = nullptr;
+			std::size_t Parent = 0;
+			std::vector<std::size_t> Children;
+
+			std::uint64_t CallCount = 0;
+			std::uint64_t InclusiveCycles = 0;
+			std::uint64_t ExclusiveCycles = 0;
+		};
+
+		struct ProfilerFrame final {
+			std::size_t Node = 0;
+			std::uint64_t Begin = 0;
+			std::uint64_t ChildCycles = 0;
+		};
+	}
+
+	class Profiler final {
+	private:
+		std::array<OpCodeProfile, 256> m_OpCodes{};
+		std::unordered_map<ProfiledFunction, FunctionProfile> m_Functions;
+		std::vector<detail::CallNode> m_CallNodes;
+		std::vector<detail::ProfilerFrame> m_Frames;
+		std::uint64_t m_PausedAt = 0;
+
+	public:
+		Profiler();
+		Profiler(Profiler&& profiler) noexcept;
+		~Profiler() = default;
+
+	public:
+		Profiler& operator=(Profiler&& profiler) noexcept;
+		bool operator==(const Profiler&) = delete;
+		bool operator!=(const Profiler&) = delete;
+
+	public:
+		void Clear();
+
+		// Timestamps are in CPU cycles where the TSC is available, and in nanoseconds otherwise
+		static std::uint64_t GetTimestamp() noexcept;
+
+		void RecordInstruction(OpCode opCode, std::uint64_t cycles) noexcept;
+		void EnterFunction(const ProfiledFunction& function, std::uint64_t timestamp);
+		void LeaveFunction(std::uint64_t timestamp) noexcept;
+
+		// Time between Pause and Resume is not charged to any function
+		void Pause(std::uint64_t timestamp) noexcept;
+		void Resume(std::uint64_t timestamp) noexcept;
+		void Stop() noexcept;
+
+		const OpCodeProfile& GetOpCodeProfile(OpCode opCode) const noexcept;
+		const FunctionProfile* GetFunctionProfile(const ProfiledFunction& function) const noexcept;
+
+		void WriteReport(std::ostream& stream, const Loader& loader) const;
+		void WriteCollapsedStacks(std::ostream& stream, const Loader& loader) const;
+
+		static const char* GetMnemonic(OpCode opCode) noexcept;
+		static std::string GetFunctionName(const ProfiledFunction& function, const Loader& loader);
+
+	private:
+		void WriteCollapsedStacks(std::ostream& stream, std::size_t node, std::string& stack,
+			std::unordered_map<ProfiledFunction, std::string>& names, const Loader& loader) const;
+	};
+}
+
+#include "detail/impl/Profiler.hpp"
\ No newline at end of file
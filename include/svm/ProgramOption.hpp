@@ -19,12 +19,18 @@ namespace svm {
 		bool DefaultValue;
 	};
 
+	struct StringVariable final {
+		std::optional<std::string> Value;
+		std::string DefaultValue;
+	};
+
 	class ProgramOption final {
 	public:
 		std::string Path;
 
 		std::unordered_map<std::string_view, Flag> Options;
 		std::unordered_map<std::string_view, Variable> Variables;
+		std::unordered_map<std::string_view, StringVariable> StringVariables;
 		std::unordered_map<std::string_view, Flag> Flags;
 		std::unordered_map<char, std::vector<std::string>> StringLists;
 
@@ -43,10 +49,12 @@ namespace svm {
 
 		ProgramOption& AddOption(const char* name);
 		ProgramOption& AddVariable(const char* name, std::uint64_t defaultValue);
+		ProgramOption& AddStringVariable(const char* name, std::string defaultValue = {});
 		ProgramOption& AddFlag(const char* name, bool defaultValue);
 		ProgramOption& AddStringList(char prefix);
 		bool GetOption(const char* name) const;
 		std::uint64_t GetVariable(const char* name) const;
+		const std::string& GetStringVariable(const char* name) const;
 		bool GetFlag(const char* name) const;
 		const std::vector<std::string>& GetStringList(char prefix) const;
 
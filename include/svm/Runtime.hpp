@@ -0,0 +1,58 @@
+#pragma once
+
+#include <svm/Interpreter.hpp>
+#include <svm/Loader.hpp>
+#include <svm/Module.hpp>
+#include <svm/ThreadPool.hpp>
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <future>
+#include <memory>
+
+namespace svm {
+	struct IsolateOption final {
+		std::size_t StackSize = 1 * 1024 * 1024;
+		bool UseGarbageCollector = false;
+		std::size_t YoungGenerationSize = 8 * 1024 * 1024;
+		std::size_t OldGenerationSize = 32 * 1024 * 1024;
+
+		// An isolate yields its worker after either limit is reached; both zero runs it to completion
+		std::uint64_t SliceInstructionCount = 0;
+		std::chrono::microseconds SliceDuration = std::chrono::microseconds::zero();
+	};
+
+	namespace detail {
+		struct Isolate final {
+			svm::Interpreter Interpreter;
+			IsolateOption Option;
+			std::promise<svm::Interpreter> Promise;
+		};
+	}
+
+	class Runtime final {
+	private:
+		ThreadPool m_ThreadPool;
+
+	public:
+		Runtime();
+		explicit Runtime(std::size_t workerCount);
+		Runtime(const Runtime&) = delete;
+		~Runtime() = default;
+
+	public:
+		Runtime& operator=(const Runtime&) = delete;
+		bool operator==(const Runtime&) = delete;
+		bool operator!=(const Runtime&) = delete;
+
+	public:
+		std::future<Interpreter> Run(ModuleStore loader, Module program, const IsolateOption& option = {});
+		std::size_t GetWorkerCount() const noexcept;
+
+	private:
+		void RunSlice(std::shared_ptr<detail::Isolate> isolate);
+
+		static Interpreter CreateIsolate(ModuleStore loader, Module program, const IsolateOption& option);
+	};
+}
\ No newline at end of file
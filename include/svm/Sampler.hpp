@@ -0,0 +1,103 @@
+#pragma once
+
+#include <svm/Loader.hpp>
+#include <svm/Profiler.hpp>
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <ostream>
+#include <thread>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace svm {
+	class Interpreter;
+
+	namespace detail {
+		constexpr std::size_t MaxSampleDepth = 32;
+
+		struct SampleFrame final {
+			ProfiledFunction Function;
+			std::uint64_t Instruction = 0;
+		};
+
+		// Frames are ordered from the innermost one
+		struct Sample final {
+			std::size_t Depth = 0;
+			std::array<SampleFrame, MaxSampleDepth> Frames;
+		};
+
+		// Single producer (the signal handler), single consumer (the draining thread)
+		struct SampleRing final {
+			static constexpr std::uint64_t Capacity = 1024;
+			static_assert((Capacity & (Capacity - 1)) == 0, "Capacity must be a power of two");
+			static_assert(std::atomic<std::uint64_t>::is_always_lock_free, "The ring must be usable in signal handlers");
+
+			std::array<Sample, Capacity> Samples;
+			std::atomic<std::uint64_t> Head = 0;
+			std::atomic<std::uint64_t> Tail = 0;
+			std::atomic<std::uint64_t> DroppedCount = 0;
+		};
+
+		struct SampleCount final {
+			std::uint64_t Self = 0;
+			std::uint64_t Total = 0;
+		};
+	}
+
+	class Sampler final {
+	private:
+		std::chrono::microseconds m_Interval;
+		const Interpreter* m_Interpreter = nullptr;
+		std::unique_ptr<detail::SampleRing> m_Ring;
+
+		std::thread m_Drainer;
+		std::mutex m_Mutex;
+		std::condition_variable m_Condition;
+		bool m_IsStopping = false;
+
+		std::uint64_t m_SampleCount = 0;
+		std::unordered_map<ProfiledFunction, detail::SampleCount> m_Functions;
+		std::map<std::pair<ProfiledFunction, std::uint64_t>, std::uint64_t> m_Instructions;
+		std::map<std::vector<ProfiledFunction>, std::uint64_t> m_Stacks;
+
+	public:
+		explicit Sampler(std::chrono::microseconds interval) noexcept;
+		Sampler(const Sampler&) = delete;
+		~Sampler();
+
+	public:
+		Sampler& operator=(const Sampler&) = delete;
+		bool operator==(const Sampler&) = delete;
+		bool operator!=(const Sampler&) = delete;
+
+	public:
+		// Must be called on the thread that runs the interpreter. Returns false if sampling is not supported
+		bool Start(const Interpreter& interpreter);
+		void Stop() noexcept;
+		bool IsStarted() const noexcept;
+
+		std::uint64_t GetSampleCount() const noexcept;
+		std::uint64_t GetDroppedCount() const noexcept;
+
+		void WriteReport(std::ostream& stream, const Loader& loader) const;
+		void WriteCollapsedStacks(std::ostream& stream, const Loader& loader) const;
+
+		static bool IsSupported() noexcept;
+
+	private:
+		static void HandleSignal(int signal) noexcept;
+
+		void Drain();
+		void Consume();
+		void Aggregate(const detail::Sample& sample);
+	};
+}
\ No newline at end of file
@@ -48,6 +48,8 @@ namespace svm {
 		std::size_t GetUsedSize() const noexcept;
 		void SetUsedSize(std::size_t newUsedSize) noexcept;
 		std::size_t GetFreeSize() const noexcept;
+		// The deepest use since the allocation. May be underestimated by up to the size of a type
+		std::size_t GetPeakUsedSize() const noexcept;
 
 		bool Expand(std::size_t delta) noexcept;
 		void Reduce(std::size_t delta) noexcept;
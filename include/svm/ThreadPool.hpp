@@ -0,0 +1,65 @@
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+namespace svm {
+	namespace detail {
+		struct WorkerQueue final {
+			std::deque<std::function<void()>> Jobs;
+			std::mutex Mutex;
+		};
+	}
+
+	class ThreadPool final {
+	private:
+		std::vector<std::thread> m_Workers;
+		std::vector<std::unique_ptr<detail::WorkerQueue>> m_Queues;
+		std::atomic<std::size_t> m_JobCount = 0;
+		std::atomic<std::size_t> m_NextQueue = 0;
+		std::mutex m_Mutex;
+		std::condition_variable m_Condition;
+		bool m_IsStopping = false;
+
+	public:
+		ThreadPool() noexcept = default;
+		explicit ThreadPool(std::size_t workerCount);
+		ThreadPool(const ThreadPool&) = delete;
+		~ThreadPool();
+
+	public:
+		ThreadPool& operator=(const ThreadPool&) = delete;
+		bool operator==(const ThreadPool&) = delete;
+		bool operator!=(const ThreadPool&) = delete;
+
+	public:
+		void Start(std::size_t workerCount);
+		void Stop() noexcept;
+		bool IsStarted() const noexcept;
+		std::size_t GetWorkerCount() const noexcept;
+
+		template<typename F>
+		std::future<std::invoke_result_t<F>> Submit(F&& job);
+		void Post(std::function<void()> job);
+		void Defer(std::function<void()> job);
+
+		static std::size_t GetDefaultWorkerCount() noexcept;
+
+	private:
+		void Push(std::function<void()> job, bool isDeferred);
+		void Work(std::size_t index);
+		std::optional<std::function<void()>> TakeJob(std::size_t index);
+	};
+}
+
+#include "detail/impl/ThreadPool.hpp"
\ No newline at end of file
@@ -0,0 +1,134 @@
+#pragma once
+
+#include <svm/Instruction.hpp>
+#include <svm/Type.hpp>
+
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <fstream>
+#include <istream>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace svm {
+	// A trace starts with TraceMagic, the version and the flags, and then has a record for each executed instruction:
+	//   varint   OpCode << 2 | HasLocation << 1 | HasJump
+	//   varint   Module, Function and Index         if HasLocation. Function is 0 for the entrypoint, and n + 1 for the n-th function
+	//   zigzag   Index - (Previous index + 1)       if HasJump
+	//   varint   Type code of the top + 1, or 0     if TraceTopValueFlag is set
+	//   zigzag   Value - Previous value             if the top has a fundamental type
+	namespace detail {
+		constexpr char TraceMagic[8] = { 'S', 'V', 'M', 'T', 'R', 'A', 'C', 'E' };
+		constexpr std::uint8_t TraceVersion = 1;
+		constexpr std::uint8_t TraceTopValueFlag = 1 << 0;
+
+		constexpr std::uint64_t TraceHasJump = 1 << 0;
+		constexpr std::uint64_t TraceHasLocation = 1 << 1;
+
+		constexpr std::size_t TraceChunkSize = 64 * 1024;
+		constexpr std::size_t TraceChunkCount = 8;
+		constexpr std::size_t MaxTraceRecordSize = 64;
+
+		struct TraceChunk final {
+			std::unique_ptr<std::uint8_t[]> Data;
+			std::size_t Size = 0;
+		};
+	}
+
+	struct TraceRecord final {
+		std::uint32_t Module = 0;
+		std::uint32_t Function = 0; // 0 for the entrypoint
+		std::uint64_t Index = 0;
+		svm::OpCode OpCode{};
+
+		std::optional<std::uint32_t> TopTypeCode; // Empty if the stack of the function was empty
+		std::uint64_t TopValue = 0; // Raw bits, if the top has a fundamental type
+	};
+
+	class Tracer final {
+	private:
+		std::ofstream m_Stream;
+		bool m_RecordsTopValue = false;
+		std::uint64_t m_RecordCount = 0;
+
+		detail::TraceChunk m_Chunk;
+		std::deque<detail::TraceChunk> m_FullChunks;
+		std::vector<detail::TraceChunk> m_FreeChunks;
+
+		std::thread m_Writer;
+		std::mutex m_Mutex;
+		std::condition_variable m_Condition;
+		bool m_IsStopping = false;
+
+		std::uint32_t m_Module = 0;
+		std::uint32_t m_Function = 0;
+		bool m_HasMoved = true;
+		std::uint64_t m_Index = 0;
+		std::uint64_t m_TopValue = 0;
+
+	public:
+		Tracer() noexcept = default;
+		Tracer(const Tracer&) = delete;
+		~Tracer();
+
+	public:
+		Tracer& operator=(const Tracer&) = delete;
+		bool operator==(const Tracer&) = delete;
+		bool operator!=(const Tracer&) = delete;
+
+	public:
+		bool Open(const std::string& path, bool recordsTopValue);
+		// Writes the remaining records and waits for the writer. Returns false if any write has failed
+		bool Close();
+		bool IsOpened() const noexcept;
+		bool RecordsTopValue() const noexcept;
+		std::uint64_t GetRecordCount() const noexcept;
+
+		void SetLocation(std::uint32_t module, std::uint32_t function) noexcept;
+		// Waits for the writer if all chunks are full, so that no record is lost
+		void RecordInstruction(std::uint64_t index, OpCode opCode);
+		// Must follow RecordInstruction if RecordsTopValue is true
+		void RecordTopValue(std::optional<std::uint32_t> typeCode, std::uint64_t value) noexcept;
+
+	private:
+		void WriteVarint(std::uint64_t value) noexcept;
+		void WriteZigzag(std::uint64_t delta) noexcept;
+		void SubmitChunk();
+		void Write();
+	};
+
+	class TraceReader final {
+	private:
+		std::istream* m_Stream = nullptr;
+		bool m_HasTopValues = false;
+		TraceRecord m_Record;
+		bool m_HasLocation = false;
+
+	public:
+		// Throws an exception if the stream does not begin with a valid header
+		explicit TraceReader(std::istream& stream);
+		TraceReader(const TraceReader&) = delete;
+		~TraceReader() = default;
+
+	public:
+		TraceReader& operator=(const TraceReader&) = delete;
+		bool operator==(const TraceReader&) = delete;
+		bool operator!=(const TraceReader&) = delete;
+
+	public:
+		bool HasTopValues() const noexcept;
+		// Returns false at the end of the trace. Throws an exception if the trace is truncated or corrupted
+		bool Read(TraceRecord& record);
+
+	private:
+		std::uint64_t ReadVarint();
+	};
+}
+
+#include "detail/impl/Tracer.hpp"
\ No newline at end of file
@@ -0,0 +1,54 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <optional>
+#include <vector>
+
+namespace svm::detail {
+	// Handles pack a slot index (lower 32 bits) with the slot's generation (upper 32 bits).
+	// Removing a value bumps the generation, so stale handles are rejected even after the slot is reused.
+	template<typename T>
+	class HandleTable final {
+	private:
+		struct Slot final {
+			std::optional<T> Value;
+			std::uint32_t Generation = 1;
+			std::uint32_t NextFree = 0;
+		};
+
+		static constexpr std::uint32_t NoFreeSlot = std::numeric_limits<std::uint32_t>::max();
+
+	private:
+		std::vector<Slot> m_Slots;
+		std::uint32_t m_FirstFree = NoFreeSlot;
+		std::size_t m_Count = 0;
+
+	public:
+		HandleTable() = default;
+		HandleTable(HandleTable&& table) noexcept = default;
+		~HandleTable() = default;
+
+	public:
+		HandleTable& operator=(HandleTable&& table) noexcept = default;
+		bool operator==(const HandleTable&) = delete;
+		bool operator!=(const HandleTable&) = delete;
+
+	public:
+		std::uint64_t Add(T&& value);
+		bool Remove(std::uint64_t handle);
+		bool IsValid(std::uint64_t handle) const noexcept;
+		T* Get(std::uint64_t handle) noexcept;
+		const T* Get(std::uint64_t handle) const noexcept;
+		std::size_t GetCount() const noexcept;
+
+		template<typename F>
+		void ForEach(F&& function);
+
+	private:
+		const Slot* GetSlot(std::uint64_t handle) const noexcept;
+	};
+}
+
+#include "impl/HandleTable.hpp"
\ No newline at end of file
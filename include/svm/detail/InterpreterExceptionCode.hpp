@@ -1,5 +1,7 @@
 #pragma once
 
+#define SVM_IEC_NONE							0xFFFFFFFF // Not an exception; returned by native functions that succeeded
+
 #define SVM_IEC_TYPE_OUTOFRANGE					0x00000000
 
 #define SVM_IEC_STACK_OVERFLOW					0x00000001
@@ -35,4 +37,13 @@
 
 #define SVM_IEC_STDLIB_TYPEASSERTFAIL			0x00000017
 #define SVM_IEC_STDLIB_ARRAY_OUTOFRANGE			0x00000018
-#define SVM_IEC_STDLIB_IO_INVALIDSTREAM			0x00000019
\ No newline at end of file
+#define SVM_IEC_STDLIB_IO_INVALIDSTREAM			0x00000019
+#define SVM_IEC_STDLIB_MMAP_INVALIDMAPPING		0x0000001A
+#define SVM_IEC_STDLIB_MMAP_FAILED				0x0000001B
+#define SVM_IEC_STDLIB_MMAP_OUTOFRANGE			0x0000001C
+#define SVM_IEC_STDLIB_MMAP_READONLY			0x0000001D
+#define SVM_IEC_STDLIB_MAP_INVALIDMAP			0x0000001E
+#define SVM_IEC_STDLIB_MAP_KEYNOTFOUND			0x0000001F
+#define SVM_IEC_STDLIB_VECTOR_INVALIDVECTOR		0x00000020
+#define SVM_IEC_STDLIB_VECTOR_OUTOFRANGE		0x00000021
+#define SVM_IEC_STDLIB_OUTOFMEMORY				0x00000022
\ No newline at end of file
@@ -0,0 +1,33 @@
+#pragma once
+
+#include <svm/Object.hpp>
+#include <svm/Type.hpp>
+
+#include <cstddef>
+#include <cstdint>
+
+namespace svm::detail {
+	// Arrays of Int, Long, Single or Double are packed: the ArrayObject header is followed by a single element Type
+	// and then the raw values, so the elements carry no Type headers of their own.
+	// A pointer to a packed element cannot reach that Type, so it carries a tag in the alignment bits instead.
+	// Every object starts with an 8-byte aligned Type header, while packed elements are aligned to their own size:
+	//   Int     address | 1      Long     address | 3
+	//   Single  address | 2      Double   address | 7
+	// The upper bits are left untouched, so tagged or 57-bit addresses are fine.
+	inline constexpr std::uintptr_t PackedPointerTagMask = 3;
+
+	inline bool IsPackedElementType(Type type) noexcept;
+	inline std::size_t GetPackedElementSize(Type type) noexcept;
+	// Returns 0 if the size does not fit in std::size_t
+	inline std::size_t CalcPackedArraySize(Type type, std::uint64_t count) noexcept;
+	inline bool IsPackedArray(const ArrayObject* array) noexcept;
+	inline void* GetPackedElements(ArrayObject* array) noexcept;
+	inline const void* GetPackedElements(const ArrayObject* array) noexcept;
+
+	inline void* MakePackedPointer(void* address, Type type) noexcept;
+	inline bool IsPackedPointer(const void* pointer) noexcept;
+	inline Type GetPackedPointerType(const void* pointer) noexcept;
+	inline void* GetPackedPointerAddress(const void* pointer) noexcept;
+}
+
+#include "impl/PackedArray.hpp"
\ No newline at end of file
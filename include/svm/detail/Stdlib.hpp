@@ -0,0 +1,167 @@
+#pragma once
+
+#include <svm/Loader.hpp>
+#include <svm/Object.hpp>
+#include <svm/Type.hpp>
+#include <svm/detail/InterpreterExceptionCode.hpp>
+#include <svm/detail/PackedArray.hpp>
+#include <svm/virtual/VirtualContext.hpp>
+#include <svm/virtual/VirtualFunction.hpp>
+#include <svm/virtual/VirtualModule.hpp>
+#include <svm/virtual/VirtualObject.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <string_view>
+
+namespace svm::detail::stdlib {
+	template<typename T>
+	struct DescriptorTable final {
+		const T* Data = nullptr;
+		std::size_t Count = 0;
+
+		constexpr DescriptorTable() noexcept = default;
+		template<std::size_t N>
+		constexpr DescriptorTable(const T(&data)[N]) noexcept
+			: Data(data), Count(N) {}
+
+		constexpr const T* begin() const noexcept {
+			return Data;
+		}
+		constexpr const T* end() const noexcept {
+			return Data + Count;
+		}
+	};
+
+	struct FieldDescriptor final {
+		TypeCode Type;
+		std::uint64_t Count;
+	};
+	struct StructureDescriptor final {
+		std::string_view Name;
+		DescriptorTable<FieldDescriptor> Fields;
+	};
+	struct MappingDescriptor final {
+		std::uint32_t Dependency;
+		std::string_view Name;
+	};
+	struct FunctionDescriptor final {
+		std::string_view Name;
+		std::uint16_t Arity;
+		bool HasResult;
+		NativeFunction Function;
+		DescriptorTable<TypeCode> Parameters = {}; // Checked by the interpreter if not empty; TypeCode::None accepts any parameter
+	};
+
+	struct ModuleDescriptor final {
+		std::string_view Path;
+		DescriptorTable<std::string_view> Dependencies;
+		DescriptorTable<MappingDescriptor> StructureMappings;
+		DescriptorTable<StructureDescriptor> Structures;
+		DescriptorTable<FunctionDescriptor> Functions;
+	};
+
+	extern const ModuleDescriptor ArrayModule;
+	extern const ModuleDescriptor IOModule;
+	extern const ModuleDescriptor MapModule;
+	extern const ModuleDescriptor MmapModule;
+	extern const ModuleDescriptor StringModule;
+	extern const ModuleDescriptor VectorModule;
+
+	void BuildModule(Loader& loader, const ModuleDescriptor& descriptor);
+}
+
+#define PREF(o) (context.GetPointer(o)) // Pointer reference
+#define PDREF(p) (context.GetObject(p.ToPointer())) // Pointer Dereference
+#define STRUCT(i) (context.GetStructure(i))
+#define FIELD(s, i) (context.GetField(s, i))
+#define ITEM(a, i) (context.GetElement(a, i)) // Array element
+#define PARAM(i) (context.GetParameter(i))
+
+namespace svm::detail::stdlib {
+	inline VirtualObject Assert(const VirtualObject& object, Type type) {
+		if (object.GetType() == type) return object;
+		else throw SVM_IEC_STDLIB_TYPEASSERTFAIL;
+	}
+	inline void Assert(bool pass, int code) {
+		if (!pass) throw code;
+	}
+}
+
+#define ASSERT_BEGIN try
+#define ASSERT_END catch (int code) { return static_cast<std::uint32_t>(code); }
+
+#define PDREF_A(p, t) (Assert(PDREF(p), t))
+#define PARAM_A(i, t) (Assert(PARAM(i), t))
+
+namespace svm::detail::stdlib {
+	// Whether [begin, begin + count) is in [0, size), written so that script-controlled values cannot overflow
+	constexpr bool IsValidRange(std::uint64_t begin, std::uint64_t count, std::uint64_t size) noexcept {
+		return begin <= size && count <= size - begin;
+	}
+
+	// Arrays of numbers are packed, so their values can be accessed as a plain C++ array
+	// The span is empty when the elements are not of type T, so that is checked before any pointer arithmetic
+	template<typename T>
+	T* GetElementData(VirtualContext& context, const VirtualObject& array, std::uint64_t begin) {
+		const auto span = context.GetSpan<T>(array);
+		Assert(!span.IsEmpty(), SVM_IEC_STDLIB_TYPEASSERTFAIL);
+		return span.GetData() + begin;
+	}
+
+	// Values held by native containers keep their Type header, so the GC can mark and relocate GCPointer values in place
+	struct ValueObject final {
+		Type ValueType = NoneType;
+		std::uint64_t Value = 0;
+	};
+	static_assert(sizeof(ValueObject) == sizeof(GCPointerObject));
+
+	inline ValueObject ToValueObject(const VirtualObject& object) {
+		ValueObject result;
+		result.ValueType = object.GetType();
+		if (object.IsInt()) {
+			result.Value = object.ToInt();
+		} else if (object.IsLong()) {
+			result.Value = object.ToLong();
+		} else if (object.IsDouble()) {
+			const double value = object.ToDouble();
+			std::memcpy(&result.Value, &value, sizeof(value));
+		} else if (object.IsPointer()) {
+			result.Value = static_cast<std::uint64_t>(object.ToPointer());
+		} else if (object.IsGCPointer()) {
+			result.Value = static_cast<std::uint64_t>(object.ToGCPointer());
+		} else throw SVM_IEC_STDLIB_TYPEASSERTFAIL;
+		return result;
+	}
+	inline void PushValueObject(VirtualContext& context, const ValueObject& value) {
+		context.PushFundamental(reinterpret_cast<const Object&>(value));
+	}
+
+	// Results of comparisons are pushed as a signed int, -1, 0 or 1, so they must be tested with icmp
+	inline void PushOrdering(VirtualContext& context, std::int32_t ordering) {
+		context.PushFundamental(IntObject(static_cast<std::uint32_t>(ordering)));
+	}
+}
+
+namespace svm::detail::stdlib::string {
+	constexpr std::uint32_t StringData = 0;
+	constexpr std::uint32_t StringLength = 1;
+	constexpr std::uint32_t StringCapacity = 2;
+
+	constexpr std::uint32_t ReplacementCharacter = 0xFFFD;
+
+	constexpr VirtualModule::StructureIndex VirtualString32 = static_cast<VirtualModule::StructureIndex>(0);
+
+	void Expand32(VirtualContext& context, const VirtualObject& string, std::uint64_t required);
+	std::uint32_t* GetData32(VirtualContext& context, const VirtualObject& string);
+	std::u32string ConvertToCppString32(VirtualContext& context, const VirtualObject& string);
+	void ConvertFromCppString32(VirtualContext& context, const std::u32string& cppString, const VirtualObject& string);
+
+	// Invalid UTF-8 sequences are decoded as U+FFFD; dest must have room for size characters
+	std::size_t DecodeUtf8(const char* src, std::size_t size, std::uint32_t* dest) noexcept;
+	void EncodeUtf8(const std::uint32_t* src, std::size_t count, std::string& dest);
+	void ConvertFromUtf8(VirtualContext& context, std::string_view utf8, const VirtualObject& string);
+	void ConvertToUtf8(VirtualContext& context, const VirtualObject& string, std::string& utf8);
+}
\ No newline at end of file
@@ -0,0 +1,75 @@
+#pragma once
+#include <svm/detail/HandleTable.hpp>
+
+#include <utility>
+
+namespace svm::detail {
+	template<typename T>
+	std::uint64_t HandleTable<T>::Add(T&& value) {
+		std::uint32_t index;
+		if (m_FirstFree != NoFreeSlot) {
+			index = m_FirstFree;
+			m_FirstFree = m_Slots[index].NextFree;
+		} else {
+			index = static_cast<std::uint32_t>(m_Slots.size());
+			m_Slots.emplace_back();
+		}
+
+		Slot& slot = m_Slots[index];
+		slot.Value.emplace(std::move(value));
+		++m_Count;
+		return static_cast<std::uint64_t>(slot.Generation) << 32 | index;
+	}
+	template<typename T>
+	bool HandleTable<T>::Remove(std::uint64_t handle) {
+		if (!GetSlot(handle)) return false;
+
+		const auto index = static_cast<std::uint32_t>(handle);
+		Slot& slot = m_Slots[index];
+		slot.Value.reset();
+		if (++slot.Generation == 0) {
+			slot.Generation = 1; // Zero is never a valid generation
+		}
+		slot.NextFree = m_FirstFree;
+		m_FirstFree = index;
+		--m_Count;
+		return true;
+	}
+	template<typename T>
+	bool HandleTable<T>::IsValid(std::uint64_t handle) const noexcept {
+		return GetSlot(handle) != nullptr;
+	}
+	template<typename T>
+	T* HandleTable<T>::Get(std::uint64_t handle) noexcept {
+		return const_cast<T*>(std::as_const(*this).Get(handle));
+	}
+	template<typename T>
+	const T* HandleTable<T>::Get(std::uint64_t handle) const noexcept {
+		const Slot* const slot = GetSlot(handle);
+		return slot ? &*slot->Value : nullptr;
+	}
+	template<typename T>
+	std::size_t HandleTable<T>::GetCount() const noexcept {
+		return m_Count;
+	}
+
+	template<typename T>
+	template<typename F>
+	void HandleTable<T>::ForEach(F&& function) {
+		for (Slot& slot : m_Slots) {
+			if (slot.Value) {
+				function(*slot.Value);
+			}
+		}
+	}
+
+	template<typename T>
+	const typename HandleTable<T>::Slot* HandleTable<T>::GetSlot(std::uint64_t handle) const noexcept {
+		const auto index = static_cast<std::uint32_t>(handle);
+		const auto generation = static_cast<std::uint32_t>(handle >> 32);
+		if (index >= m_Slots.size()) return nullptr;
+
+		const Slot& slot = m_Slots[index];
+		return slot.Generation == generation && slot.Value ? &slot : nullptr;
+	}
+}
\ No newline at end of file
@@ -0,0 +1,30 @@
+#pragma once
+#include <svm/LocalStateTable.hpp>
+
+#include <type_traits>
+#include <utility>
+
+namespace svm {
+	template<typename T>
+	T& LocalStateTable::Get() {
+		std::shared_ptr<void>& state = m_States[typeid(T)];
+		if (!state) {
+			std::shared_ptr<T> newState = std::make_shared<T>();
+			if constexpr (std::is_base_of_v<GCRootProvider, T>) {
+				m_GCRootProviders.push_back(newState.get());
+			}
+			state = std::move(newState);
+		}
+		return *static_cast<T*>(state.get());
+	}
+	template<typename T>
+	T* LocalStateTable::Find() {
+		const auto iter = m_States.find(typeid(T));
+		return iter != m_States.end() ? static_cast<T*>(iter->second.get()) : nullptr;
+	}
+	template<typename T>
+	const T* LocalStateTable::Find() const {
+		const auto iter = m_States.find(typeid(T));
+		return iter != m_States.end() ? static_cast<const T*>(iter->second.get()) : nullptr;
+	}
+}
\ No newline at end of file
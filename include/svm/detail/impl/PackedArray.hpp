@@ -0,0 +1,67 @@
+#pragma once
+#include <svm/detail/PackedArray.hpp>
+
+#include <limits>
+
+namespace svm::detail {
+	inline bool IsPackedElementType(Type type) noexcept {
+		return type == IntType || type == LongType || type == SingleType || type == DoubleType;
+	}
+	inline std::size_t GetPackedElementSize(Type type) noexcept {
+		return type == IntType || type == SingleType ? 4 : 8;
+	}
+	inline std::size_t CalcPackedArraySize(Type type, std::uint64_t count) noexcept {
+		constexpr std::size_t headerSize = sizeof(ArrayObject) + sizeof(Type);
+		const std::size_t elementSize = GetPackedElementSize(type);
+		if (count > (std::numeric_limits<std::size_t>::max() - headerSize - 7) / elementSize) return 0;
+
+		// Rounded up to a multiple of 8 bytes so that the arrays on the stack stay aligned
+		const std::size_t valueSize = (elementSize * static_cast<std::size_t>(count) + 7) & ~static_cast<std::size_t>(7);
+		return headerSize + valueSize;
+	}
+	inline bool IsPackedArray(const ArrayObject* array) noexcept {
+		return IsPackedElementType(*reinterpret_cast<const Type*>(array + 1));
+	}
+	inline void* GetPackedElements(ArrayObject* array) noexcept {
+		return reinterpret_cast<Type*>(array + 1) + 1;
+	}
+	inline const void* GetPackedElements(const ArrayObject* array) noexcept {
+		return reinterpret_cast<const Type*>(array + 1) + 1;
+	}
+
+	inline void* MakePackedPointer(void* address, Type type) noexcept {
+		std::uintptr_t tag = 0;
+		if (type == IntType) {
+			tag = 1;
+		} else if (type == SingleType) {
+			tag = 2;
+		} else if (type == LongType) {
+			tag = 3;
+		} else if (type == DoubleType) {
+			tag = 7;
+		}
+		return reinterpret_cast<void*>(reinterpret_cast<std::uintptr_t>(address) | tag);
+	}
+	inline bool IsPackedPointer(const void* pointer) noexcept {
+		return (reinterpret_cast<std::uintptr_t>(pointer) & PackedPointerTagMask) != 0;
+	}
+	inline Type GetPackedPointerType(const void* pointer) noexcept {
+		switch (reinterpret_cast<std::uintptr_t>(pointer) & 7) {
+		case 1:
+		case 5:
+			return IntType;
+		case 2:
+		case 6:
+			return SingleType;
+		case 3:
+			return LongType;
+		default:
+			return DoubleType;
+		}
+	}
+	inline void* GetPackedPointerAddress(const void* pointer) noexcept {
+		const std::uintptr_t address = reinterpret_cast<std::uintptr_t>(pointer);
+		const std::uintptr_t tagMask = (address & PackedPointerTagMask) == 3 ? 7 : PackedPointerTagMask; // Long and Double also use the third bit
+		return reinterpret_cast<void*>(address & ~tagMask);
+	}
+}
\ No newline at end of file
@@ -0,0 +1,29 @@
+#pragma once
+#include <svm/Profiler.hpp>
+
+#include <svm/Macro.hpp>
+
+#if defined(SVM_X86) && defined(SVM_MSVC)
+#	include <intrin.h>
+#elif defined(SVM_X86)
+#	include <x86intrin.h>
+#else
+#	include <chrono>
+#endif
+
+namespace svm {
+	inline std::uint64_t Profiler::GetTimestamp() noexcept {
+#ifdef SVM_X86
+		return static_cast<std::uint64_t>(__rdtsc());
+#else
+		return static_cast<std::uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+			std::chrono::steady_clock::now().time_since_epoch()).count());
+#endif
+	}
+
+	inline void Profiler::RecordInstruction(OpCode opCode, std::uint64_t cycles) noexcept {
+		OpCodeProfile& profile = m_OpCodes[static_cast<std::uint8_t>(opCode)];
+		++profile.Count;
+		profile.Cycles += cycles;
+	}
+}
\ No newline at end of file
@@ -0,0 +1,20 @@
+#pragma once
+#include <svm/ThreadPool.hpp>
+
+#include <memory>
+#include <utility>
+
+namespace svm {
+	template<typename F>
+	std::future<std::invoke_result_t<F>> ThreadPool::Submit(F&& job) {
+		using Result = std::invoke_result_t<F>;
+
+		const auto task = std::make_shared<std::packaged_task<Result()>>(std::forward<F>(job));
+		std::future<Result> result = task->get_future();
+
+		Post([task] {
+			(*task)();
+		});
+		return result;
+	}
+}
@@ -0,0 +1,73 @@
+#pragma once
+#include <svm/Tracer.hpp>
+
+namespace svm::detail {
+	inline bool HasTraceValue(std::uint32_t typeCode) noexcept {
+		switch (static_cast<TypeCode>(typeCode)) {
+		case TypeCode::Int:
+		case TypeCode::Long:
+		case TypeCode::Single:
+		case TypeCode::Double:
+		case TypeCode::Pointer:
+		case TypeCode::GCPointer:
+			return true;
+
+		default:
+			return false;
+		}
+	}
+}
+
+namespace svm {
+	inline void Tracer::SetLocation(std::uint32_t module, std::uint32_t function) noexcept {
+		m_Module = module;
+		m_Function = function;
+		m_HasMoved = true;
+	}
+	inline void Tracer::RecordInstruction(std::uint64_t index, OpCode opCode) {
+		if (m_Chunk.Size + detail::MaxTraceRecordSize > detail::TraceChunkSize) {
+			SubmitChunk();
+		}
+
+		const std::uint64_t header = static_cast<std::uint64_t>(static_cast<std::uint8_t>(opCode)) << 2;
+		if (m_HasMoved) {
+			WriteVarint(header | detail::TraceHasLocation);
+			WriteVarint(m_Module);
+			WriteVarint(m_Function);
+			WriteVarint(index);
+			m_HasMoved = false;
+		} else if (index != m_Index + 1) {
+			WriteVarint(header | detail::TraceHasJump);
+			WriteZigzag(index - (m_Index + 1));
+		} else {
+			WriteVarint(header);
+		}
+
+		m_Index = index;
+		++m_RecordCount;
+	}
+	inline void Tracer::RecordTopValue(std::optional<std::uint32_t> typeCode, std::uint64_t value) noexcept {
+		if (!typeCode) {
+			WriteVarint(0);
+			return;
+		}
+
+		WriteVarint(static_cast<std::uint64_t>(*typeCode) + 1);
+		if (detail::HasTraceValue(*typeCode)) {
+			WriteZigzag(value - m_TopValue);
+			m_TopValue = value;
+		}
+	}
+
+	inline void Tracer::WriteVarint(std::uint64_t value) noexcept {
+		std::uint8_t* const data = m_Chunk.Data.get();
+		while (value >= 0x80) {
+			data[m_Chunk.Size++] = static_cast<std::uint8_t>(value | 0x80);
+			value >>= 7;
+		}
+		data[m_Chunk.Size++] = static_cast<std::uint8_t>(value);
+	}
+	inline void Tracer::WriteZigzag(std::uint64_t delta) noexcept {
+		WriteVarint((delta << 1) ^ (0 - (delta >> 63)));
+	}
+}
\ No newline at end of file
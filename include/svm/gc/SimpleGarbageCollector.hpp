@@ -38,12 +38,17 @@ namespace svm {
 		virtual void* Allocate(Interpreter& interpreter, std::size_t size) override;
 		virtual void MakeDirty(const void* address) noexcept override;
 
+		// Forces a collection regardless of the free space. Does nothing while pinned
+		void ForceMinorGC(Interpreter& interpreter);
+		void ForceMajorGC(Interpreter& interpreter);
+
 	private:
 		void* AllocateOnYoungGeneration(Interpreter& interpreter, std::size_t size);
 		void* AllocateOnOldGeneration(Interpreter& interpreter, PointerTable* minorPointerTable, std::size_t size);
 
 		void MajorGC(Interpreter& interpreter, PointerTable* minorPointerTable);
 		void MinorGC(Interpreter& interpreter);
+		void UpdatePeakHeapSize() noexcept;
 
 		void MarkGCRoots(Interpreter& interpreter, ManagedHeapGeneration* generation, PointerTable& pointerTable, PointerList& grayColorList);
 		void MarkGCObjects(Interpreter& interpreter, ManagedHeapGeneration* generation, PointerTable& pointerTable, PointerList& grayColorList);
@@ -1,8 +1,10 @@
 #pragma once
 
+#include <svm/LocalStateTable.hpp>
 #include <svm/Structure.hpp>
 #include <svm/virtual/VirtualModule.hpp>
 #include <svm/virtual/VirtualObject.hpp>
+#include <svm/virtual/VirtualSpan.hpp>
 #include <svm/virtual/VirtualStack.hpp>
 
 #include <cstdint>
@@ -17,11 +19,12 @@ namespace svm {
 		Interpreter& m_Interpreter;
 		VirtualStack& m_Stack;
 		Heap& m_Heap;
+		bool m_IsPinning = false;
 
 	public:
 		VirtualContext(Interpreter& interpreter, VirtualStack& stack, Heap& heap) noexcept;
 		VirtualContext(const VirtualContext&) = delete;
-		~VirtualContext() = default;
+		~VirtualContext();
 
 	public:
 		VirtualContext& operator=(const VirtualContext&) = delete;
@@ -30,12 +33,21 @@ namespace svm {
 
 	public:
 		void OccurException(std::uint32_t code) noexcept;
+		LocalStateTable& GetLocalStates() noexcept;
+		template<typename T>
+		T& GetLocalState();
 
 		Structure GetStructure(VirtualModule::StructureIndex structure);
 		Structure GetStructure(VirtualModule::MappedStructureIndex structure);
+		Structure GetStructure(Type type);
+		// Number of the structures the module of the native function declares, without the mapped ones
+		std::uint32_t GetStructureCount() const noexcept;
 
 		VirtualObject GetField(const VirtualObject& structure, std::uint32_t index);
 		VirtualObject GetElement(const VirtualObject& array, std::uint64_t index);
+		// The managed heap is pinned until the context is destroyed, so the span stays valid for the whole native call
+		template<typename T>
+		VirtualSpan<T> GetSpan(const VirtualObject& array);
 
 		VirtualObject GetParameter(std::uint16_t index);
 
@@ -51,15 +63,20 @@ namespace svm {
 		VirtualObject GCNewFundamental(const Object& object, std::uint64_t count = 0);
 		VirtualObject NewStructure(Structure structure, std::uint64_t count = 0);
 		VirtualObject GCNewStructure(Structure structure, std::uint64_t count = 0);
+		bool ReallocateFundamental(const VirtualObject& object, std::uint64_t count);
 		void DeleteObject(const VirtualObject& object);
 
 		void CopyObject(const VirtualObject& dest, const VirtualObject& src);
 		void CopyObjectUnsafe(VirtualObject::PointerTarget dest, VirtualObject::PointerTarget src, std::uint64_t count);
 
 	private:
+		void PinManagedHeap() noexcept;
+		static void* GetValuePtr(Object* object) noexcept;
 		void InitFundamental(void* target, const Object& object, const Type& type);
 		void InitFundamental(void* target, const Type& type, std::uint64_t count);
 		void InitStructure(void* target, Structure structure);
 		void InitStructure(void* target, Structure structure, std::uint64_t count);
 	};
-}
\ No newline at end of file
+}
+
+#include "detail/impl/VirtualContext.hpp"
\ No newline at end of file
@@ -1,25 +1,29 @@
 #pragma once
 
+#include <svm/Extension.h>
+#include <svm/Type.hpp>
 #include <svm/core/virtual/VirtualFunction.hpp>
 
 #include <cstdint>
-#include <functional>
 #include <string>
-#include <type_traits>
-#include <utility>
+#include <vector>
 
 namespace svm {
 	class VirtualContext;
 
+	// Returns SVM_IEC_NONE, or the code of the exception to occur
+	using NativeFunction = std::uint32_t(*)(VirtualContext& context);
+
 	class VirtualFunctionInfo final : public core::VirtualFunctionInfo {
 	private:
-		std::function<void(VirtualContext&)> m_Function;
+		NativeFunction m_Function = nullptr;
+		SvmNativeFunction m_ExtensionFunction = nullptr;
+		std::vector<Type> m_Parameters;
 
 	public:
 		VirtualFunctionInfo() noexcept = default;
-		template<typename F>
-		VirtualFunctionInfo(std::string name, std::uint16_t arity, bool hasResult, F&& function)
-			noexcept(noexcept(std::is_nothrow_constructible_v<decltype(m_Function), decltype(std::forward<F>(function))>));
+		VirtualFunctionInfo(std::string name, std::uint16_t arity, bool hasResult, NativeFunction function, std::vector<Type> parameters = {}) noexcept;
+		VirtualFunctionInfo(std::string name, std::uint16_t arity, bool hasResult, SvmNativeFunction function, std::vector<Type> parameters = {}) noexcept;
 		VirtualFunctionInfo(VirtualFunctionInfo&& functionInfo) noexcept;
 		~VirtualFunctionInfo() = default;
 
@@ -27,7 +31,11 @@ namespace svm {
 		VirtualFunctionInfo& operator=(VirtualFunctionInfo&& functionInfo) noexcept;
 		bool operator==(const VirtualFunctionInfo&) = delete;
 		bool operator!=(const VirtualFunctionInfo&) = delete;
-		void operator()(VirtualContext& context) const;
+		std::uint32_t operator()(VirtualContext& context) const;
+
+	public:
+		// Empty if the function checks its parameters itself. NoneType accepts any parameter.
+		const std::vector<Type>& GetParameters() const noexcept;
 	};
 }
 
@@ -35,9 +35,7 @@ namespace svm {
 		DependencyIndex AddDependency(std::string dependency);
 		MappedStructureIndex AddStructureMapping(DependencyIndex dependency, std::string name);
 		StructureIndex AddStructure(std::string name, std::vector<std::pair<Type, std::uint64_t>> fields);
-		template<typename F>
-		void AddFunction(std::string name, std::uint16_t arity, bool hasResult, F&& function);
+		void AddFunction(std::string name, std::uint16_t arity, bool hasResult, NativeFunction function, std::vector<Type> parameters = {});
+		void AddFunction(std::string name, std::uint16_t arity, bool hasResult, SvmNativeFunction function, std::vector<Type> parameters = {});
 	};
-}
-
-#include "detail/impl/VirtualModule.hpp"
\ No newline at end of file
+}
\ No newline at end of file
@@ -0,0 +1,37 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+namespace svm {
+	// A view of the elements of an array. Numbers are packed, so a span of std::uint32_t, std::uint64_t, float or double
+	// is contiguous; other elements keep their Type header and are stepped over by the size of their type.
+	template<typename T>
+	class VirtualSpan final {
+	private:
+		std::uint8_t* m_Data = nullptr;
+		std::size_t m_Stride = 0;
+		std::uint64_t m_Count = 0;
+
+	public:
+		VirtualSpan() noexcept = default;
+		VirtualSpan(T* data, std::size_t stride, std::uint64_t count) noexcept;
+		VirtualSpan(const VirtualSpan& span) noexcept = default;
+		~VirtualSpan() = default;
+
+	public:
+		VirtualSpan& operator=(const VirtualSpan& span) noexcept = default;
+		bool operator==(const VirtualSpan&) = delete;
+		bool operator!=(const VirtualSpan&) = delete;
+		T& operator[](std::uint64_t index) const noexcept;
+
+	public:
+		bool IsEmpty() const noexcept;
+		bool IsContiguous() const noexcept;
+		T* GetData() const noexcept;
+		std::size_t GetStride() const noexcept;
+		std::uint64_t GetCount() const noexcept;
+	};
+}
+
+#include "detail/impl/VirtualSpan.hpp"
\ No newline at end of file
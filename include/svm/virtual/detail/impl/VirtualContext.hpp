@@ -0,0 +1,46 @@
+#pragma once
+#include <svm/virtual/VirtualContext.hpp>
+
+#include <svm/Object.hpp>
+#include <svm/detail/PackedArray.hpp>
+
+#include <type_traits>
+
+namespace svm {
+	template<typename T>
+	T& VirtualContext::GetLocalState() {
+		return GetLocalStates().Get<T>();
+	}
+	template<typename T>
+	VirtualSpan<T> VirtualContext::GetSpan(const VirtualObject& array) {
+		using E = std::remove_cv_t<T>; // Signed integers view the same packed elements
+
+		const Type elementType = array.IsArray();
+		if (elementType == nullptr) return {};
+		else if constexpr (std::is_integral_v<E> && sizeof(E) == sizeof(std::uint32_t)) {
+			if (elementType != IntType) return {};
+		} else if constexpr (std::is_integral_v<E> && sizeof(E) == sizeof(std::uint64_t)) {
+			if (elementType != LongType) return {};
+		} else if constexpr (std::is_same_v<E, float>) {
+			if (elementType != SingleType) return {};
+		} else if constexpr (std::is_same_v<E, double>) {
+			if (elementType != DoubleType) return {};
+		} else if constexpr (std::is_same_v<E, PointerObject>) {
+			if (elementType != PointerType) return {};
+		} else if constexpr (std::is_same_v<E, GCPointerObject>) {
+			if (elementType != GCPointerType) return {};
+		} else {
+			static_assert(std::is_same_v<E, StructureObject>, "T must be an element type of arrays");
+			if (!elementType.IsStructure()) return {};
+		}
+
+		PinManagedHeap();
+
+		ArrayObject* const arrayPtr = static_cast<ArrayObject*>(array.GetObjectPtr());
+		if constexpr (std::is_arithmetic_v<E>) {
+			return { static_cast<T*>(detail::GetPackedElements(arrayPtr)), sizeof(T), arrayPtr->Count };
+		} else {
+			return { reinterpret_cast<T*>(arrayPtr + 1), elementType->Size, arrayPtr->Count };
+		}
+	}
+}
\ No newline at end of file
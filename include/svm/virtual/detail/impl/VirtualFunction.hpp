@@ -2,8 +2,11 @@
 #include <svm/virtual/VirtualFunction.hpp>
 
 namespace svm {
-	template<typename F>
-	VirtualFunctionInfo::VirtualFunctionInfo(std::string name, std::uint16_t arity, bool hasResult, F&& function)
-		noexcept(noexcept(std::is_nothrow_constructible_v<decltype(m_Function), decltype(std::forward<F>(function))>))
-		: core::VirtualFunctionInfo(std::move(name), arity, hasResult), m_Function(std::forward<F>(function)) {}
+	inline std::uint32_t VirtualFunctionInfo::operator()(VirtualContext& context) const {
+		if (m_Function) return m_Function(context);
+		else return m_ExtensionFunction(reinterpret_cast<SvmContext*>(&context));
+	}
+	inline const std::vector<Type>& VirtualFunctionInfo::GetParameters() const noexcept {
+		return m_Parameters;
+	}
 }
\ No newline at end of file
@@ -1,9 +1,13 @@
 #pragma once
 #include <svm/virtual/VirtualObject.hpp>
 
+#include <svm/detail/PackedArray.hpp>
+
 namespace svm {
 	template<typename T>
 	decltype(std::declval<T>().Value)& VirtualObject::GetValue() const noexcept {
-		return static_cast<T*>(GetObjectPtr())->Value;
+		Object* const object = GetObjectPtr();
+		if (detail::IsPackedPointer(object)) return *static_cast<decltype(std::declval<T>().Value)*>(detail::GetPackedPointerAddress(object));
+		else return static_cast<T*>(object)->Value;
 	}
 }
\ No newline at end of file
@@ -0,0 +1,34 @@
+#pragma once
+#include <svm/virtual/VirtualSpan.hpp>
+
+namespace svm {
+	template<typename T>
+	VirtualSpan<T>::VirtualSpan(T* data, std::size_t stride, std::uint64_t count) noexcept
+		: m_Data(reinterpret_cast<std::uint8_t*>(data)), m_Stride(stride), m_Count(count) {}
+
+	template<typename T>
+	T& VirtualSpan<T>::operator[](std::uint64_t index) const noexcept {
+		return *reinterpret_cast<T*>(m_Data + index * m_Stride);
+	}
+
+	template<typename T>
+	bool VirtualSpan<T>::IsEmpty() const noexcept {
+		return m_Count == 0;
+	}
+	template<typename T>
+	bool VirtualSpan<T>::IsContiguous() const noexcept {
+		return m_Stride == sizeof(T);
+	}
+	template<typename T>
+	T* VirtualSpan<T>::GetData() const noexcept {
+		return reinterpret_cast<T*>(m_Data);
+	}
+	template<typename T>
+	std::size_t VirtualSpan<T>::GetStride() const noexcept {
+		return m_Stride;
+	}
+	template<typename T>
+	std::uint64_t VirtualSpan<T>::GetCount() const noexcept {
+		return m_Count;
+	}
+}
\ No newline at end of file
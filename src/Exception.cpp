@@ -43,6 +43,15 @@ namespace svm {
 		case SVM_IEC_STDLIB_TYPEASSERTFAIL: return "Some parameter has inappropriate type."sv;
 		case SVM_IEC_STDLIB_ARRAY_OUTOFRANGE: return "Index is out of range."sv;
 		case SVM_IEC_STDLIB_IO_INVALIDSTREAM: return "Invalid stream."sv;
+		case SVM_IEC_STDLIB_MMAP_INVALIDMAPPING: return "Invalid mapping."sv;
+		case SVM_IEC_STDLIB_MMAP_FAILED: return "Failed to map the file."sv;
+		case SVM_IEC_STDLIB_MMAP_OUTOFRANGE: return "Index is out of the mapping."sv;
+		case SVM_IEC_STDLIB_MMAP_READONLY: return "Mapping is read-only."sv;
+		case SVM_IEC_STDLIB_MAP_INVALIDMAP: return "Invalid map."sv;
+		case SVM_IEC_STDLIB_MAP_KEYNOTFOUND: return "Key does not exist in the map."sv;
+		case SVM_IEC_STDLIB_VECTOR_INVALIDVECTOR: return "Invalid vector."sv;
+		case SVM_IEC_STDLIB_VECTOR_OUTOFRANGE: return "Index is out of the vector."sv;
+		case SVM_IEC_STDLIB_OUTOFMEMORY: return "Out of memory."sv;
 
 		default: return ""sv;
 		}
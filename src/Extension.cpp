@@ -0,0 +1,288 @@
+#include <svm/Extension.hpp>
+
+#include <svm/Macro.hpp>
+#include <svm/Object.hpp>
+#include <svm/Structure.hpp>
+#include <svm/Type.hpp>
+#include <svm/detail/InterpreterExceptionCode.hpp>
+#include <svm/virtual/VirtualContext.hpp>
+#include <svm/virtual/VirtualModule.hpp>
+#include <svm/virtual/VirtualObject.hpp>
+
+#include <cstdint>
+#include <string>
+#include <utility>
+#include <vector>
+
+#ifdef SVM_WINDOWS
+#	define NOMINMAX
+#	include <Windows.h>
+#else
+#	include <dlfcn.h>
+#endif
+
+namespace svm {
+	Extension::Extension(const std::filesystem::path& path) {
+#ifdef SVM_WINDOWS
+		m_Handle = LoadLibraryW(path.c_str());
+#else
+		m_Handle = dlopen(path.c_str(), RTLD_NOW | RTLD_LOCAL);
+#endif
+	}
+	Extension::Extension(Extension&& extension) noexcept
+		: m_Handle(std::exchange(extension.m_Handle, nullptr)) {}
+	Extension::~Extension() {
+		Close();
+	}
+
+	Extension& Extension::operator=(Extension&& extension) noexcept {
+		Close();
+
+		m_Handle = std::exchange(extension.m_Handle, nullptr);
+		return *this;
+	}
+
+	void Extension::Close() noexcept {
+		if (!m_Handle) return;
+
+#ifdef SVM_WINDOWS
+		FreeLibrary(static_cast<HMODULE>(m_Handle));
+#else
+		dlclose(m_Handle);
+#endif
+		m_Handle = nullptr;
+	}
+	bool Extension::IsOpen() const noexcept {
+		return m_Handle != nullptr;
+	}
+	SvmExtensionInit Extension::GetInit() const noexcept {
+		if (!m_Handle) return nullptr;
+
+#ifdef SVM_WINDOWS
+		return reinterpret_cast<SvmExtensionInit>(GetProcAddress(static_cast<HMODULE>(m_Handle), SVM_EXTENSION_INIT));
+#else
+		return reinterpret_cast<SvmExtensionInit>(dlsym(m_Handle, SVM_EXTENSION_INIT));
+#endif
+	}
+
+	const char* Extension::GetFileExtension() noexcept {
+#if defined(SVM_WINDOWS)
+		return ".dll";
+#elif defined(__APPLE__)
+		return ".dylib";
+#else
+		return ".so";
+#endif
+	}
+}
+
+namespace svm::detail::extension {
+	VirtualModule& ToModule(SvmModule* module) noexcept {
+		return *reinterpret_cast<VirtualModule*>(module);
+	}
+	VirtualContext& ToContext(SvmContext* context) noexcept {
+		return *reinterpret_cast<VirtualContext*>(context);
+	}
+
+	Type ToType(std::uint32_t type) noexcept {
+		switch (type) {
+		case SVM_EXTENSION_TYPE_NONE: return NoneType;
+		case SVM_EXTENSION_TYPE_INT: return IntType;
+		case SVM_EXTENSION_TYPE_LONG: return LongType;
+		case SVM_EXTENSION_TYPE_DOUBLE: return DoubleType;
+		case SVM_EXTENSION_TYPE_POINTER: return PointerType;
+		case SVM_EXTENSION_TYPE_GCPOINTER: return GCPointerType;
+		default: return nullptr;
+		}
+	}
+	std::uint32_t FromType(Type type) noexcept {
+		if (type == IntType) return SVM_EXTENSION_TYPE_INT;
+		else if (type == LongType) return SVM_EXTENSION_TYPE_LONG;
+		else if (type == DoubleType) return SVM_EXTENSION_TYPE_DOUBLE;
+		else if (type == PointerType) return SVM_EXTENSION_TYPE_POINTER;
+		else if (type == GCPointerType) return SVM_EXTENSION_TYPE_GCPOINTER;
+		else return SVM_EXTENSION_TYPE_NONE;
+	}
+
+	std::uint32_t GetValue(const VirtualObject& object, SvmValue* value) noexcept {
+		value->Type = FromType(object.GetType());
+		switch (value->Type) {
+		case SVM_EXTENSION_TYPE_INT: value->Value.Int = object.ToInt(); break;
+		case SVM_EXTENSION_TYPE_LONG: value->Value.Long = object.ToLong(); break;
+		case SVM_EXTENSION_TYPE_DOUBLE: value->Value.Double = object.ToDouble(); break;
+		case SVM_EXTENSION_TYPE_POINTER: value->Value.Pointer = static_cast<std::uint64_t>(object.ToPointer()); break;
+		case SVM_EXTENSION_TYPE_GCPOINTER: value->Value.Pointer = static_cast<std::uint64_t>(object.ToGCPointer()); break;
+		default: return SVM_IEC_STDLIB_TYPEASSERTFAIL;
+		}
+		return SVM_IEC_NONE;
+	}
+	void SetValue(const VirtualObject& object, const SvmValue& value) noexcept {
+		switch (value.Type) {
+		case SVM_EXTENSION_TYPE_INT: object.SetInt(value.Value.Int); break;
+		case SVM_EXTENSION_TYPE_LONG: object.SetLong(value.Value.Long); break;
+		case SVM_EXTENSION_TYPE_DOUBLE: object.SetDouble(value.Value.Double); break;
+		case SVM_EXTENSION_TYPE_POINTER: object.SetPointer(static_cast<VirtualObject::PointerTarget>(value.Value.Pointer)); break;
+		case SVM_EXTENSION_TYPE_GCPOINTER: object.SetGCPointer(static_cast<VirtualObject::GCPointerTarget>(value.Value.Pointer)); break;
+		}
+	}
+
+	// Structures and arrays may be passed by a pointer
+	std::uint32_t GetReferencedParameter(VirtualContext& context, std::uint16_t index, VirtualObject& object) {
+		object = context.GetParameter(index);
+		if (object.IsEmpty()) return SVM_IEC_LOCALVARIABLE_OUTOFRANGE;
+
+		if (object.IsPointer()) {
+			if (object.ToPointer() == VPNULL) return SVM_IEC_POINTER_NULLPOINTER;
+			object = context.GetObject(object.ToPointer());
+		} else if (object.IsGCPointer()) {
+			if (object.ToGCPointer() == VGPNULL) return SVM_IEC_POINTER_NULLPOINTER;
+			object = context.GetObject(object.ToGCPointer());
+		}
+		return SVM_IEC_NONE;
+	}
+
+	std::uint32_t AddStructure(SvmModule* module, const char* name, const std::uint32_t* fieldTypes, std::uint32_t fieldCount, std::uint32_t* structure) {
+		std::vector<std::pair<Type, std::uint64_t>> fields;
+		for (std::uint32_t i = 0; i < fieldCount; ++i) {
+			const Type type = ToType(fieldTypes[i]);
+			if (type == nullptr || type == NoneType) return SVM_IEC_TYPE_OUTOFRANGE;
+
+			fields.emplace_back(type, 0);
+		}
+
+		*structure = static_cast<std::uint32_t>(ToModule(module).AddStructure(name, std::move(fields)));
+		return SVM_IEC_NONE;
+	}
+	std::uint32_t AddFunction(SvmModule* module, const char* name, std::uint16_t arity, int hasResult, SvmNativeFunction function, const std::uint32_t* parameterTypes) {
+		std::vector<Type> parameters;
+		if (parameterTypes) {
+			for (std::uint16_t i = 0; i < arity; ++i) {
+				const Type type = ToType(parameterTypes[i]);
+				if (type == nullptr) return SVM_IEC_TYPE_OUTOFRANGE;
+
+				parameters.push_back(type);
+			}
+		}
+
+		ToModule(module).AddFunction(name, arity, hasResult != 0, function, std::move(parameters));
+		return SVM_IEC_NONE;
+	}
+
+	std::uint32_t GetParameter(SvmContext* context, std::uint16_t index, SvmValue* value) {
+		const VirtualObject parameter = ToContext(context).GetParameter(index);
+		if (parameter.IsEmpty()) return SVM_IEC_LOCALVARIABLE_OUTOFRANGE;
+
+		return GetValue(parameter, value);
+	}
+	std::uint32_t GetField(SvmContext* context, std::uint16_t index, std::uint32_t field, SvmValue* value) {
+		VirtualContext& virtualContext = ToContext(context);
+
+		VirtualObject structure;
+		if (const std::uint32_t code = GetReferencedParameter(virtualContext, index, structure); code != SVM_IEC_NONE) return code;
+		else if (structure.IsStructure() == nullptr) return SVM_IEC_STRUCTURE_NOTSTRUCTURE;
+		else if (field >= virtualContext.GetStructure(structure.IsStructure())->Fields.size()) return SVM_IEC_STRUCTURE_FIELD_OUTOFRANGE;
+
+		return GetValue(virtualContext.GetField(structure, field), value);
+	}
+	std::uint32_t GetArray(SvmContext* context, std::uint16_t index, SvmArray* array) {
+		VirtualContext& virtualContext = ToContext(context);
+
+		VirtualObject object;
+		if (const std::uint32_t code = GetReferencedParameter(virtualContext, index, object); code != SVM_IEC_NONE) return code;
+		else if (object.IsArray() == nullptr) return SVM_IEC_ARRAY_NOTARRAY;
+
+		array->ElementType = FromType(object.IsArray());
+		array->Count = object.GetCount();
+		switch (array->ElementType) {
+		case SVM_EXTENSION_TYPE_INT: array->Data = virtualContext.GetSpan<std::uint32_t>(object).GetData(); break;
+		case SVM_EXTENSION_TYPE_LONG: array->Data = virtualContext.GetSpan<std::uint64_t>(object).GetData(); break;
+		case SVM_EXTENSION_TYPE_DOUBLE: array->Data = virtualContext.GetSpan<double>(object).GetData(); break;
+		default: return SVM_IEC_STDLIB_TYPEASSERTFAIL;
+		}
+		return SVM_IEC_NONE;
+	}
+	std::uint32_t Push(SvmContext* context, const SvmValue* value) {
+		VirtualContext& virtualContext = ToContext(context);
+
+		VirtualObject result;
+		switch (value->Type) {
+		case SVM_EXTENSION_TYPE_INT: result = virtualContext.PushFundamental(IntObject(value->Value.Int)); break;
+		case SVM_EXTENSION_TYPE_LONG: result = virtualContext.PushFundamental(LongObject(value->Value.Long)); break;
+		case SVM_EXTENSION_TYPE_DOUBLE: result = virtualContext.PushFundamental(DoubleObject(value->Value.Double)); break;
+		case SVM_EXTENSION_TYPE_POINTER: result = virtualContext.PushFundamental(PointerObject()); break;
+		case SVM_EXTENSION_TYPE_GCPOINTER: result = virtualContext.PushFundamental(GCPointerObject()); break;
+		default: return SVM_IEC_TYPE_OUTOFRANGE;
+		}
+		if (result.IsEmpty()) return SVM_IEC_STACK_OVERFLOW;
+
+		SetValue(result, *value);
+		return SVM_IEC_NONE;
+	}
+	std::uint32_t PushStructure(SvmContext* context, std::uint32_t structure, const SvmValue* fields, std::uint32_t fieldCount) {
+		VirtualContext& virtualContext = ToContext(context);
+		if (structure >= virtualContext.GetStructureCount()) return SVM_IEC_TYPE_OUTOFRANGE;
+
+		const Structure structureInfo = virtualContext.GetStructure(static_cast<VirtualModule::StructureIndex>(structure));
+		if (fieldCount != structureInfo->Fields.size()) return SVM_IEC_STRUCTURE_FIELD_OUTOFRANGE;
+		for (std::size_t i = 0; i < structureInfo->Fields.size(); ++i) {
+			if (ToType(fields[i].Type) != structureInfo->Fields[i].Type) return SVM_IEC_STDLIB_TYPEASSERTFAIL;
+		}
+
+		const VirtualObject result = virtualContext.PushStructure(structureInfo);
+		if (result.IsEmpty()) return SVM_IEC_STACK_OVERFLOW;
+
+		for (std::size_t i = 0; i < structureInfo->Fields.size(); ++i) {
+			SetValue(virtualContext.GetField(result, static_cast<std::uint32_t>(i)), fields[i]);
+		}
+		return SVM_IEC_NONE;
+	}
+	std::uint32_t NewArray(SvmContext* context, std::uint32_t elementType, std::uint64_t count, SvmArray* array) {
+		VirtualContext& virtualContext = ToContext(context);
+		if (count == 0) return SVM_IEC_ARRAY_COUNT_CANNOTBEZERO;
+
+		VirtualObject object;
+		switch (elementType) {
+		case SVM_EXTENSION_TYPE_INT: object = virtualContext.NewFundamental(IntObject(), count); break;
+		case SVM_EXTENSION_TYPE_LONG: object = virtualContext.NewFundamental(LongObject(), count); break;
+		case SVM_EXTENSION_TYPE_DOUBLE: object = virtualContext.NewFundamental(DoubleObject(), count); break;
+		default: return SVM_IEC_TYPE_OUTOFRANGE;
+		}
+		if (object.IsEmpty()) return SVM_IEC_POINTER_UNKNOWNADDRESS;
+
+		const VirtualObject::PointerTarget pointer = virtualContext.GetPointer(object);
+		if (virtualContext.PushFundamental(PointerObject(reinterpret_cast<void*>(static_cast<std::uintptr_t>(pointer)))).IsEmpty()) {
+			virtualContext.DeleteObject(object);
+			return SVM_IEC_STACK_OVERFLOW;
+		}
+
+		array->ElementType = elementType;
+		array->Count = count;
+		switch (elementType) {
+		case SVM_EXTENSION_TYPE_INT: array->Data = virtualContext.GetSpan<std::uint32_t>(object).GetData(); break;
+		case SVM_EXTENSION_TYPE_LONG: array->Data = virtualContext.GetSpan<std::uint64_t>(object).GetData(); break;
+		case SVM_EXTENSION_TYPE_DOUBLE: array->Data = virtualContext.GetSpan<double>(object).GetData(); break;
+		}
+		return SVM_IEC_NONE;
+	}
+}
+
+namespace svm {
+	const SvmExtensionApi& Extension::GetApi() noexcept {
+		using namespace detail::extension;
+
+		static const SvmExtensionApi api = {
+			SVM_EXTENSION_VERSION,
+
+			AddStructure,
+			AddFunction,
+
+			GetParameter,
+			GetField,
+			GetArray,
+			Push,
+			PushStructure,
+			NewArray,
+		};
+		return api;
+	}
+}
\ No newline at end of file
@@ -26,17 +26,20 @@ namespace svm {
 		Initialize(defaultBlockSize);
 	}
 	ManagedHeapGeneration::ManagedHeapGeneration(ManagedHeapGeneration&& generation) noexcept
-		: m_Blocks(std::move(generation.m_Blocks)), m_CurrentBlock(generation.m_CurrentBlock), m_DefaultBlockSize(generation.m_DefaultBlockSize) {}
+		: m_Blocks(std::move(generation.m_Blocks)), m_CurrentBlock(generation.m_CurrentBlock), m_DefaultBlockSize(generation.m_DefaultBlockSize),
+		m_Size(generation.m_Size) {}
 
 	ManagedHeapGeneration& ManagedHeapGeneration::operator=(ManagedHeapGeneration&& generation) noexcept {
 		m_Blocks = std::move(generation.m_Blocks);
 		m_CurrentBlock = generation.m_CurrentBlock;
 		m_DefaultBlockSize = generation.m_DefaultBlockSize;
+		m_Size = generation.m_Size;
 		return *this;
 	}
 
 	void ManagedHeapGeneration::Reset() noexcept {
 		m_Blocks.clear();
+		m_Size = 0;
 	}
 	void ManagedHeapGeneration::Initialize(std::size_t defaultBlockSize) {
 		assert(!IsInitalized());
@@ -44,6 +47,7 @@ namespace svm {
 		m_Blocks.emplace_back(defaultBlockSize);
 		m_CurrentBlock = m_Blocks.begin();
 		m_DefaultBlockSize = defaultBlockSize;
+		m_Size = defaultBlockSize;
 	}
 	bool ManagedHeapGeneration::IsInitalized() const noexcept {
 		return !m_Blocks.empty();
@@ -60,6 +64,7 @@ namespace svm {
 			newBlock.SetUsedSize(size);
 
 			void* const result = m_Blocks.insert(std::next(m_CurrentBlock), std::move(newBlock))->GetTop<std::uint8_t>();
+			m_Size += std::max(size, m_DefaultBlockSize);
 			return ++m_CurrentBlock, result;
 		} catch (...) {
 			return nullptr;
@@ -68,8 +73,11 @@ namespace svm {
 	ManagedHeapGeneration::Block ManagedHeapGeneration::GetEmptyBlock() {
 		const Block iter = Next(m_CurrentBlock);
 
-		if (iter->GetUsedSize() != 0) return m_Blocks.insert(iter, Stack(m_DefaultBlockSize));
-		else return iter;
+		if (iter->GetUsedSize() != 0) {
+			const Block result = m_Blocks.insert(iter, Stack(m_DefaultBlockSize));
+			m_Size += m_DefaultBlockSize;
+			return result;
+		} else return iter;
 	}
 	void ManagedHeapGeneration::DeleteEmptyBlocks() {
 		std::vector<Block> blocks;
@@ -80,6 +88,7 @@ namespace svm {
 		}
 
 		for (std::size_t i = 8; i < blocks.size(); ++i) {
+			m_Size -= blocks[i]->GetSize();
 			m_Blocks.erase(blocks[i]);
 		}
 	}
@@ -135,4 +144,24 @@ namespace svm {
 	std::size_t ManagedHeapGeneration::GetBlockCount() const noexcept {
 		return m_Blocks.size();
 	}
+	std::size_t ManagedHeapGeneration::GetSize() const noexcept {
+		return m_Size;
+	}
+}
+
+namespace svm {
+	void GarbageCollector::Pin() noexcept {
+		++m_PinCount;
+	}
+	void GarbageCollector::Unpin() noexcept {
+		assert(m_PinCount != 0);
+
+		--m_PinCount;
+	}
+	bool GarbageCollector::IsPinned() const noexcept {
+		return m_PinCount != 0;
+	}
+	const GarbageCollectorStatistics& GarbageCollector::GetStatistics() const noexcept {
+		return m_Statistics;
+	}
 }
\ No newline at end of file
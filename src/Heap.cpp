@@ -1,18 +1,23 @@
 #include <svm/Heap.hpp>
 
 #include <algorithm>
+#include <cstdint>
 #include <cstdlib>
+#include <cstring>
 #include <utility>
 
 namespace svm {
 	Heap::Heap(Heap&& heap) noexcept
-		: m_UnmanagedHeap(std::move(heap.m_UnmanagedHeap)), m_GarbageCollector(std::move(heap.m_GarbageCollector)) {}
+		: m_UnmanagedHeap(std::move(heap.m_UnmanagedHeap)), m_UnmanagedHeapSize(heap.m_UnmanagedHeapSize), m_PeakUnmanagedHeapSize(heap.m_PeakUnmanagedHeapSize),
+		m_GarbageCollector(std::move(heap.m_GarbageCollector)) {}
 	Heap::~Heap() {
 		Deallocate();
 	}
 
 	Heap& Heap::operator=(Heap&& heap) noexcept {
 		m_UnmanagedHeap = std::move(heap.m_UnmanagedHeap);
+		m_UnmanagedHeapSize = heap.m_UnmanagedHeapSize;
+		m_PeakUnmanagedHeapSize = heap.m_PeakUnmanagedHeapSize;
 		m_GarbageCollector = std::move(heap.m_GarbageCollector);
 		return *this;
 	}
@@ -23,6 +28,8 @@ namespace svm {
 		}
 
 		m_UnmanagedHeap.clear();
+		m_UnmanagedHeapSize = 0;
+		m_PeakUnmanagedHeapSize = 0;
 		m_GarbageCollector.reset();
 	}
 
@@ -36,24 +43,65 @@ namespace svm {
 
 		if (memory) {
 			m_UnmanagedHeap[memory.get()] = size;
+			m_UnmanagedHeapSize += size;
+			m_PeakUnmanagedHeapSize = std::max(m_PeakUnmanagedHeapSize, m_UnmanagedHeapSize);
 		}
 
 		return memory.release();
 	}
+	void* Heap::ReallocateUnmanagedHeap(void* address, std::size_t size) noexcept {
+		const auto iter = m_UnmanagedHeap.find(address);
+		if (iter == m_UnmanagedHeap.end()) return nullptr;
+
+		const std::size_t oldSize = iter->second;
+		void* const newAddress = std::realloc(address, size);
+		if (!newAddress) return nullptr;
+
+		// Grown memory is zeroed like a fresh allocation
+		if (size > oldSize) {
+			std::memset(static_cast<std::uint8_t*>(newAddress) + oldSize, 0, size - oldSize);
+		}
+
+		m_UnmanagedHeap.erase(iter);
+		m_UnmanagedHeap[newAddress] = size;
+		m_UnmanagedHeapSize = m_UnmanagedHeapSize - oldSize + size;
+		m_PeakUnmanagedHeapSize = std::max(m_PeakUnmanagedHeapSize, m_UnmanagedHeapSize);
+		return newAddress;
+	}
 	bool Heap::DeallocateUnmanagedHeap(void* address) noexcept {
 		const auto iter = m_UnmanagedHeap.find(address);
 		if (iter == m_UnmanagedHeap.end()) return false;
 
 		std::free(iter->first);
+		m_UnmanagedHeapSize -= iter->second;
 		m_UnmanagedHeap.erase(iter);
 		return true;
 	}
+	std::size_t Heap::GetUnmanagedHeapSize() const noexcept {
+		return m_UnmanagedHeapSize;
+	}
+	std::size_t Heap::GetPeakUnmanagedHeapSize() const noexcept {
+		return m_PeakUnmanagedHeapSize;
+	}
 
 	void Heap::SetGarbageCollector(std::unique_ptr<GarbageCollector>&& gc) noexcept {
 		m_GarbageCollector = std::move(gc);
 	}
+	const GarbageCollector* Heap::GetGarbageCollector() const noexcept {
+		return m_GarbageCollector.get();
+	}
 	void* Heap::AllocateManagedHeap(Interpreter& interpreter, std::size_t size) {
 		if (!m_GarbageCollector) return nullptr;
 		else return m_GarbageCollector->Allocate(interpreter, size);
 	}
+	void Heap::PinManagedHeap() noexcept {
+		if (m_GarbageCollector) {
+			m_GarbageCollector->Pin();
+		}
+	}
+	void Heap::UnpinManagedHeap() noexcept {
+		if (m_GarbageCollector) {
+			m_GarbageCollector->Unpin();
+		}
+	}
 }
\ No newline at end of file
@@ -3,11 +3,37 @@
 #include <svm/Object.hpp>
 #include <svm/core/ByteFile.hpp>
 #include <svm/detail/InterpreterExceptionCode.hpp>
+#include <svm/detail/PackedArray.hpp>
 
+#include <cstring>
+#include <exception>
+#include <limits>
 #include <utility>
 
 namespace svm {
-	Interpreter::Interpreter(Loader&& loader, Module program) noexcept
+	namespace {
+		struct TrampolineContext final {
+			svm::Interpreter* Interpreter = nullptr;
+			std::uint64_t* InstructionCount = nullptr;
+			std::chrono::steady_clock::time_point Deadline;
+			InterpretResult Result = InterpretResult::Completed;
+			std::exception_ptr Exception;
+		};
+
+		// Adds to the total even if an instruction throws, while the loop only touches a local
+		struct InstructionCounter final {
+			std::uint64_t& Total;
+			std::uint64_t Count = 0;
+
+			~InstructionCounter() {
+				Total += Count;
+			}
+		};
+	}
+
+	Interpreter::Interpreter(Loader&& loader, Module program)
+		: Interpreter(std::make_shared<const Loader>(std::move(loader)), program) {}
+	Interpreter::Interpreter(ModuleStore loader, Module program) noexcept
 		: m_Loader(std::move(loader)) {
 		m_StackFrame.Program = program;
 		m_StackFrame.Instructions = &std::get<core::ByteFile>(program->Module).GetEntrypoint();
@@ -15,8 +41,11 @@ namespace svm {
 	Interpreter::Interpreter(Interpreter&& interpreter) noexcept
 		: m_Loader(std::move(interpreter.m_Loader)), m_Exception(std::move(interpreter.m_Exception)),
 		m_Stack(std::move(interpreter.m_Stack)), m_StackFrame(interpreter.m_StackFrame), m_Depth(interpreter.m_Depth),
+		m_MaxDepth(interpreter.m_MaxDepth), m_InstructionCount(interpreter.m_InstructionCount),
 		m_LocalVariables(std::move(interpreter.m_LocalVariables)),
-		m_Heap(std::move(interpreter.m_Heap)) {}
+		m_Heap(std::move(interpreter.m_Heap)), m_LocalStates(std::move(interpreter.m_LocalStates)),
+		m_Profiler(std::move(interpreter.m_Profiler)), m_PerfCounters(interpreter.m_PerfCounters), m_PerfMap(std::move(interpreter.m_PerfMap)),
+		m_Tracer(std::move(interpreter.m_Tracer)) {}
 
 	Interpreter& Interpreter::operator=(Interpreter&& interpreter) noexcept {
 		m_Loader = std::move(interpreter.m_Loader);
@@ -25,26 +54,45 @@ namespace svm {
 		m_Stack = std::move(interpreter.m_Stack);
 		m_StackFrame = interpreter.m_StackFrame;
 		m_Depth = interpreter.m_Depth;
+		m_MaxDepth = interpreter.m_MaxDepth;
+		m_InstructionCount = interpreter.m_InstructionCount;
 
 		m_LocalVariables = std::move(interpreter.m_LocalVariables);
 
 		m_Heap = std::move(interpreter.m_Heap);
+		m_LocalStates = std::move(interpreter.m_LocalStates);
+
+		m_Profiler = std::move(interpreter.m_Profiler);
+		m_PerfCounters = interpreter.m_PerfCounters;
+		m_PerfMap = std::move(interpreter.m_PerfMap);
+		m_Tracer = std::move(interpreter.m_Tracer);
 		return *this;
 	}
 
 	void Interpreter::Clear() noexcept {
-		m_Loader.Clear();
+		m_Loader.reset();
 		m_Exception.reset();
 
 		m_Stack.Deallocate();
 		m_StackFrame = {};
 		m_Depth = 0;
+		m_MaxDepth = 0;
+		m_InstructionCount = 0;
 
 		m_LocalVariables.clear();
 
 		m_Heap.Deallocate();
+		m_LocalStates.Clear();
+
+		m_Profiler.reset();
+		m_PerfCounters = nullptr;
+		m_PerfMap.reset();
+		m_Tracer.reset();
 	}
-	void Interpreter::Load(Loader&& loader, Module program) noexcept {
+	void Interpreter::Load(Loader&& loader, Module program) {
+		Load(std::make_shared<const Loader>(std::move(loader)), program);
+	}
+	void Interpreter::Load(ModuleStore loader, Module program) noexcept {
 		m_Loader = std::move(loader);
 		m_StackFrame.Program = program;
 		m_StackFrame.Instructions = &std::get<core::ByteFile>(program->Module).GetEntrypoint();
@@ -59,10 +107,124 @@ namespace svm {
 	void Interpreter::SetGarbageCollector(std::unique_ptr<GarbageCollector>&& gc) noexcept {
 		m_Heap.SetGarbageCollector(std::move(gc));
 	}
+	void Interpreter::SetProfiler(std::unique_ptr<Profiler>&& profiler) noexcept {
+		m_Profiler = std::move(profiler);
+	}
+	Profiler* Interpreter::GetProfiler() noexcept {
+		return m_Profiler.get();
+	}
+	void Interpreter::SetPerfCounters(PerfCounters* perfCounters) noexcept {
+		m_PerfCounters = perfCounters;
+	}
+	PerfCounters* Interpreter::GetPerfCounters() noexcept {
+		return m_PerfCounters;
+	}
+	void Interpreter::SetPerfMap(std::unique_ptr<PerfMap>&& perfMap) noexcept {
+		m_PerfMap = std::move(perfMap);
+	}
+	PerfMap* Interpreter::GetPerfMap() noexcept {
+		return m_PerfMap.get();
+	}
+	void Interpreter::SetTracer(std::unique_ptr<Tracer>&& tracer) noexcept {
+		m_Tracer = std::move(tracer);
+	}
+	Tracer* Interpreter::GetTracer() noexcept {
+		return m_Tracer.get();
+	}
 
 	bool Interpreter::Interpret() {
+		InterpretResult result;
+		if (m_Tracer) result = m_Profiler ? InterpretLoop<false, true, true>(0, {}) : InterpretLoop<false, false, true>(0, {});
+		else result = m_Profiler ? InterpretLoop<false, true, false>(0, {}) : InterpretLoop<false, false, false>(0, {});
+		return result == InterpretResult::Completed;
+	}
+	InterpretResult Interpreter::Interpret(const InterpretBudget& budget) {
+		const std::uint64_t instructionCount = budget.InstructionCount ? budget.InstructionCount : std::numeric_limits<std::uint64_t>::max();
+		if (m_Tracer) return m_Profiler ?
+			InterpretLoop<true, true, true>(instructionCount, budget.Deadline) :
+			InterpretLoop<true, false, true>(instructionCount, budget.Deadline);
+		else return m_Profiler ?
+			InterpretLoop<true, true, false>(instructionCount, budget.Deadline) :
+			InterpretLoop<true, false, false>(instructionCount, budget.Deadline);
+	}
+	template<bool UseBudget, bool UseProfiler, bool UseTracer>
+	InterpretResult Interpreter::InterpretLoop(std::uint64_t instructionCount, std::chrono::steady_clock::time_point deadline) {
+		const PerfPhaseScope perfPhase(m_PerfCounters, VMPhase::Interpreting);
+		if constexpr (UseProfiler) {
+			m_Profiler->Resume(Profiler::GetTimestamp());
+		}
+
+		// The profiler attributes the functions by itself, so trampolines are only for native profilers
+		const InterpretResult result = !UseProfiler && !UseTracer && m_PerfMap ?
+			InterpretInTrampolines<UseBudget>(instructionCount, deadline) :
+			InterpretInstructions<UseBudget, UseProfiler, UseTracer>(instructionCount, deadline);
+
+		if constexpr (UseProfiler) {
+			m_Profiler->Pause(Profiler::GetTimestamp());
+		}
+		return result;
+	}
+	template<bool UseBudget>
+	InterpretResult Interpreter::InterpretInTrampolines(std::uint64_t& instructionCount, std::chrono::steady_clock::time_point deadline) {
+		TrampolineContext context;
+		context.Interpreter = this;
+		context.InstructionCount = &instructionCount;
+		context.Deadline = deadline;
+
+		while (true) {
+			const std::size_t depth = m_Depth;
+			const Trampoline trampoline = m_PerfMap->GetTrampoline(m_StackFrame.Function, *m_Loader);
+			if (trampoline) {
+				trampoline(&context, &InterpretTrampolineFrame<UseBudget>);
+			} else {
+				InterpretTrampolineFrame<UseBudget>(&context);
+			}
+
+			if (context.Exception) std::rethrow_exception(std::exchange(context.Exception, nullptr));
+			// Leaving a trampoline without changing the function means that the budget is exhausted
+			else if (context.Result != InterpretResult::Suspended || m_Depth == depth) return context.Result;
+		}
+	}
+	template<bool UseBudget>
+	void Interpreter::InterpretTrampolineFrame(void* context) {
+		TrampolineContext& frame = *static_cast<TrampolineContext*>(context);
+		try {
+			frame.Result = frame.Interpreter->InterpretInstructions<UseBudget, false, false, true>(*frame.InstructionCount, frame.Deadline);
+		} catch (...) {
+			// Trampolines have no unwind information, so no exception may propagate through them
+			frame.Exception = std::current_exception();
+		}
+	}
+	template<bool UseBudget, bool UseProfiler, bool UseTracer, bool UseTrampoline>
+	InterpretResult Interpreter::InterpretInstructions(std::uint64_t& instructionCount, std::chrono::steady_clock::time_point deadline) {
+		[[maybe_unused]] const svm::Instructions* tracedInstructions = nullptr;
+		InstructionCounter counter{ m_InstructionCount };
 		for (; m_StackFrame.Caller < m_StackFrame.Instructions->GetInstructionCount(); ++m_StackFrame.Caller) {
+			if constexpr (UseBudget) {
+				// Caller already points at the next instruction, so a later call resumes from here
+				if (instructionCount-- == 0) return InterpretResult::Suspended;
+				if ((instructionCount & (DeadlineCheckInterval - 1)) == 0 &&
+					std::chrono::steady_clock::now() >= deadline) return InterpretResult::Suspended;
+			}
+			++counter.Count;
+
 			const Instruction& inst = m_StackFrame.Instructions->GetInstruction(m_StackFrame.Caller);
+			[[maybe_unused]] std::size_t depth;
+			[[maybe_unused]] std::uint64_t begin;
+			if constexpr (UseProfiler || UseTrampoline) {
+				depth = m_Depth;
+			}
+			if constexpr (UseProfiler) {
+				begin = Profiler::GetTimestamp();
+			}
+			if constexpr (UseTracer) {
+				if (m_StackFrame.Instructions != tracedInstructions) {
+					tracedInstructions = m_StackFrame.Instructions;
+					TraceLocation();
+				}
+				m_Tracer->RecordInstruction(m_StackFrame.Caller, inst.OpCode);
+			}
+
 			switch (inst.OpCode) {
 			case OpCode::Push: InterpretPush(inst.Operand); break;
 			case OpCode::Pop: InterpretPop(); break;
@@ -125,13 +287,81 @@ namespace svm {
 			case OpCode::Count: InterpretCount(); break;
 			}
 
-			if (m_Exception.has_value()) return false;
+			if constexpr (UseProfiler) {
+				const std::uint64_t end = Profiler::GetTimestamp();
+				m_Profiler->RecordInstruction(inst.OpCode, end - begin);
+
+				if (m_Depth > depth) {
+					m_Profiler->EnterFunction(m_StackFrame.Function, begin);
+				} else if (m_Depth < depth) {
+					m_Profiler->LeaveFunction(end);
+				} else if (inst.OpCode == OpCode::Call && !m_Exception) {
+					// Virtual functions return before InterpretCall does
+					m_Profiler->EnterFunction(GetFunction(inst.Operand), begin);
+					m_Profiler->LeaveFunction(end);
+				}
+			}
+
+			if constexpr (UseTracer) {
+				if (m_Tracer->RecordsTopValue()) {
+					TraceTopValue();
+				}
+			}
+
+			if (m_Exception.has_value()) return InterpretResult::Exception;
+			if constexpr (UseTrampoline) {
+				if (m_Depth != depth) {
+					// Advances Caller as the loop does, and lets InterpretInTrampolines enter the trampoline of the new function
+					++m_StackFrame.Caller;
+					return InterpretResult::Suspended;
+				}
+			}
 		}
 
 		if (m_Depth != 0) {
 			OccurException(SVM_IEC_FUNCTION_NORETINSTRUCTION);
-			return false;
-		} else return true;
+			return InterpretResult::Exception;
+		} else return InterpretResult::Completed;
+	}
+	void Interpreter::TraceLocation() noexcept {
+		if (std::holds_alternative<Function>(m_StackFrame.Function)) {
+			const Function function = std::get<Function>(m_StackFrame.Function);
+			const auto& functions = std::get<core::ByteFile>(m_Loader->GetModule(function->Module)->Module).GetFunctions();
+			m_Tracer->SetLocation(function->Module, static_cast<std::uint32_t>(function - functions.data()) + 1);
+			return;
+		}
+
+		for (std::uint32_t i = 0; i < m_Loader->GetModuleCount(); ++i) {
+			if (m_Loader->GetModule(i) == m_StackFrame.Program) {
+				m_Tracer->SetLocation(i, 0);
+				return;
+			}
+		}
+	}
+	void Interpreter::TraceTopValue() noexcept {
+		// Below StackBegin is the frame of the caller, which is not an object
+		const Type* const typePtr = m_Stack.GetUsedSize() > m_StackFrame.StackBegin ? m_Stack.GetTopType() : nullptr;
+		if (!typePtr || !typePtr->IsValidType()) {
+			m_Tracer->RecordTopValue(std::nullopt, 0);
+			return;
+		}
+
+		const Type type = *typePtr;
+		std::uint64_t value = 0;
+		if (type == IntType) {
+			value = static_cast<std::uint64_t>(reinterpret_cast<const IntObject*>(typePtr)->Value);
+		} else if (type == LongType) {
+			value = static_cast<std::uint64_t>(reinterpret_cast<const LongObject*>(typePtr)->Value);
+		} else if (type == SingleType) {
+			std::uint32_t bits;
+			std::memcpy(&bits, &reinterpret_cast<const SingleObject*>(typePtr)->Value, sizeof(bits));
+			value = bits;
+		} else if (type == DoubleType) {
+			std::memcpy(&value, &reinterpret_cast<const DoubleObject*>(typePtr)->Value, sizeof(value));
+		} else if (type == PointerType || type == GCPointerType) {
+			value = reinterpret_cast<std::uintptr_t>(reinterpret_cast<const PointerObject*>(typePtr)->Value);
+		}
+		m_Tracer->RecordTopValue(static_cast<std::uint32_t>(type->Code), value);
 	}
 	bool Interpreter::HasResult() const noexcept {
 		return m_Stack.GetUsedSize();
@@ -181,11 +411,18 @@ namespace svm {
 			const Type* const elementType = reinterpret_cast<const Type*>(&array + 1);
 			stream << elementType->GetReference().Name << '[' << array.Count << "]{";
 
+			const bool isPacked = detail::IsPackedElementType(*elementType);
 			for (std::uint64_t i = 0; i < array.Count; ++i) {
 				if (i != 0) {
 					stream << ", ";
 				}
-				PrintObject(stream, reinterpret_cast<const Object*>(reinterpret_cast<const std::uint8_t*>(elementType) + i * elementType->GetReference().Size));
+
+				if (isPacked) {
+					PrintPackedElement(stream, *elementType,
+						static_cast<const std::uint8_t*>(detail::GetPackedElements(&array)) + i * detail::GetPackedElementSize(*elementType));
+				} else {
+					PrintObject(stream, reinterpret_cast<const Object*>(reinterpret_cast<const std::uint8_t*>(elementType) + i * elementType->GetReference().Size));
+				}
 			}
 
 			stream << '}';
@@ -226,6 +463,26 @@ namespace svm {
 		}
 		return result;
 	}
+	void Interpreter::CaptureSample(detail::Sample& sample) const noexcept {
+		const StackFrame* frame = &m_StackFrame;
+		std::size_t depth = 0;
+		while (true) {
+			detail::SampleFrame& sampleFrame = sample.Frames[depth];
+			std::memcpy(static_cast<void*>(&sampleFrame.Function), &frame->Function, sizeof(sampleFrame.Function));
+			if (sampleFrame.Function.index() >= std::variant_size_v<ProfiledFunction>) {
+				sampleFrame.Function = std::monostate();
+			}
+			sampleFrame.Instruction = frame->Caller;
+
+			if (++depth > m_Depth || depth == detail::MaxSampleDepth) break;
+
+			// The caller's frame is pushed right below the stack of the callee
+			const std::size_t stackOffset = frame->StackBegin;
+			if (stackOffset < sizeof(StackFrame) || stackOffset > m_Stack.GetUsedSize()) break;
+			frame = m_Stack.Get<StackFrame>(stackOffset);
+		}
+		sample.Depth = depth;
+	}
 
 	Type Interpreter::GetType(TypeCode code) const noexcept {
 		auto result = GetFundamentalType(code);
@@ -233,7 +490,7 @@ namespace svm {
 		else return GetStructure(code)->Type;
 	}
 	Structure Interpreter::GetStructure(Type type) const noexcept {
-		return m_Loader.GetModule(type->Module)->GetStructure(static_cast<std::uint32_t>(type->Code) - static_cast<std::uint32_t>(TypeCode::Structure));
+		return m_Loader->GetModule(type->Module)->GetStructure(static_cast<std::uint32_t>(type->Code) - static_cast<std::uint32_t>(TypeCode::Structure));
 	}
 	Structure Interpreter::GetStructure(TypeCode code) const noexcept {
 		std::uint32_t index = static_cast<std::uint32_t>(code) - static_cast<std::uint32_t>(TypeCode::Structure);
@@ -285,11 +542,44 @@ namespace svm {
 	std::uint32_t Interpreter::GetLocalVariableCount() const noexcept {
 		return static_cast<std::uint32_t>(m_LocalVariables.size());
 	}
+	const ModuleStore& Interpreter::GetModuleStore() const noexcept {
+		return m_Loader;
+	}
+	LocalStateTable& Interpreter::GetLocalStates() noexcept {
+		return m_LocalStates;
+	}
+	const Stack& Interpreter::GetStack() const noexcept {
+		return m_Stack;
+	}
+	const Heap& Interpreter::GetHeap() const noexcept {
+		return m_Heap;
+	}
+	std::uint64_t Interpreter::GetInstructionCount() const noexcept {
+		return m_InstructionCount;
+	}
+	std::size_t Interpreter::GetMaxDepth() const noexcept {
+		return m_MaxDepth;
+	}
 
+	void Interpreter::PrintPackedElement(std::ostream& stream, Type type, const void* value) const {
+		if (type == IntType) {
+			stream << *static_cast<const std::uint32_t*>(value);
+		} else if (type == LongType) {
+			stream << *static_cast<const std::uint64_t*>(value);
+		} else if (type == SingleType) {
+			stream << *static_cast<const float*>(value);
+		} else if (type == DoubleType) {
+			stream << *static_cast<const double*>(value);
+		}
+	}
 	void Interpreter::PrintPointerTaget(std::ostream& stream, const Object& object) const {
 		if (object.GetType() == PointerType) {
 			const PointerObject& pointer = static_cast<const PointerObject&>(object);
-			if (pointer.Value) {
+			if (detail::IsPackedPointer(pointer.Value)) {
+				stream << '(';
+				PrintPackedElement(stream, detail::GetPackedPointerType(pointer.Value), detail::GetPackedPointerAddress(pointer.Value));
+				stream << ')';
+			} else if (pointer.Value) {
 				stream << '(';
 				PrintObject(stream, static_cast<const Object*>(pointer.Value), true);
 				stream << ')';
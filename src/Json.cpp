@@ -0,0 +1,26 @@
+#include <svm/Json.hpp>
+
+#include <iomanip>
+
+namespace svm {
+	void WriteJsonString(std::ostream& stream, std::string_view string) {
+		stream << '"';
+		for (const char c : string) {
+			switch (c) {
+			case '"': stream << "\\\""; break;
+			case '\\': stream << "\\\\"; break;
+			case '\n': stream << "\\n"; break;
+			case '\r': stream << "\\r"; break;
+			case '\t': stream << "\\t"; break;
+			default:
+				if (static_cast<unsigned char>(c) < 0x20) {
+					stream << "\\u" << std::hex << std::setw(4) << std::setfill('0') << static_cast<int>(c) << std::dec << std::setfill(' ');
+				} else {
+					stream << c;
+				}
+				break;
+			}
+		}
+		stream << '"';
+	}
+}
\ No newline at end of file
@@ -1,20 +1,17 @@
 #include <svm/Loader.hpp>
 
-#include <svm/detail/InterpreterExceptionCode.hpp>
-#include <svm/virtual/VirtualContext.hpp>
+#include <svm/Parser.hpp>
+#include <svm/detail/Stdlib.hpp>
 #include <svm/virtual/VirtualModule.hpp>
 
 #include <algorithm>
+#include <cassert>
+#include <chrono>
 #include <cstddef>
 #include <cstdint>
-#include <cstring>
 #include <filesystem>
-#include <fstream>
-#include <functional>
-#include <iostream>
-#include <iterator>
-#include <list>
-#include <utf8.h>
+#include <future>
+#include <stdexcept>
 #include <utility>
 #include <vector>
 
@@ -26,701 +23,220 @@ namespace svm {
 	}
 
 	VirtualModule& Loader::Create(std::string virtualPath) {
+		m_ModulePaths.insert(virtualPath);
 		return CreateWrapped(std::move(virtualPath));
 	}
-}
-
-#define PREF(o) (context.GetPointer(o)) // Pointer reference
-#define PDREF(p) (context.GetObject(p.ToPointer())) // Pointer Dereference
-#define STRUCT(i) (context.GetStructure(i))
-#define FIELD(s, i) (context.GetField(s, i))
-#define ITEM(a, i) (context.GetElement(a, i)) // Array element
-#define PARAM(i) (context.GetParameter(i))
-
-namespace svm::detail::stdlib {
-	VirtualObject Assert(const VirtualObject& object, Type type) {
-		if (object.GetType() == type) return object;
-		else throw SVM_IEC_STDLIB_TYPEASSERTFAIL;
+	void Loader::AddLibraryDirectory(std::string directory) {
+		m_LibraryDirectories.push_back(directory);
+		detail::LoaderAdapter::AddLibraryDirectory(std::move(directory));
 	}
-	void Assert(bool pass, int code) {
-		if (!pass) throw code;
+	void Loader::AddModuleProvider(std::string virtualPath, ModuleProvider provider) {
+		m_ModuleProviders[std::move(virtualPath)] = std::move(provider);
 	}
-}
-
-#define ASSERT_BEGIN try
-#define ASSERT_END catch (int code) { context.OccurException(code); return; }
-
-#define PDREF_A(p, t) (Assert(PDREF(p), t))
-#define PARAM_A(i, t) (Assert(PARAM(i), t))
-
-namespace svm::detail::stdlib::array {
-	struct State {
-		void Init(Loader& loader, std::vector<VirtualModule*>& modules) {
-			auto& module = loader.Create("/std/array.sbf");
-			modules.push_back(&module);
-
-			module.AddFunction("copy", 5, false, [this](VirtualContext& context) {
-				ASSERT_BEGIN {
-					const auto dest = PDREF_A(PARAM_A(0, PointerType), ArrayType);
-					const auto destBegin = PARAM_A(1, LongType).ToLong();
-					const auto src = PDREF_A(PARAM_A(2, PointerType), ArrayType);
-					const auto srcBegin = PARAM_A(3, LongType).ToLong();
-					const auto count = PARAM_A(4, LongType).ToLong();
-
-					Assert(dest.IsArray() == src.IsArray(), SVM_IEC_STDLIB_TYPEASSERTFAIL);
-					Assert(destBegin + count <= dest.GetCount(), SVM_IEC_STDLIB_ARRAY_OUTOFRANGE);
-					Assert(srcBegin + count <= src.GetCount(), SVM_IEC_STDLIB_ARRAY_OUTOFRANGE);
-
-					context.CopyObjectUnsafe(PREF(ITEM(dest, destBegin)), PREF(ITEM(src, srcBegin)), count);
-				} ASSERT_END;
-			});
-		}
-	};
-}
+	bool Loader::Provide(const std::string& virtualPath) {
+		const auto iter = m_ModuleProviders.find(virtualPath);
+		if (iter == m_ModuleProviders.end()) return LoadExtension(virtualPath);
+
+		// Erased first so that a provider is never run twice, even on a dependency cycle
+		const ModuleProvider provider = std::move(iter->second);
+		m_ModuleProviders.erase(iter);
+		provider(*this);
+		return true;
+	}
+	Module Loader::Load(const std::string& path) {
+		const std::string root = std::filesystem::canonical(path).string();
+		if (m_ModulePaths.count(root)) return detail::LoaderAdapter::Load(root);
+
+		std::unordered_map<std::string, detail::ParsedModule> modules;
+		std::vector<std::string> wave = { root };
+		std::optional<ThreadPool> threadPool;
+
+		// Parse every reachable module, one dependency level at a time
+		while (!wave.empty()) {
+			std::vector<detail::ParsedModule> parsedModules = ParseModules(wave, threadPool);
+			for (std::size_t i = 0; i < wave.size(); ++i) {
+				modules[wave[i]] = std::move(parsedModules[i]);
+			}
 
-namespace svm::detail::stdlib::string {
-	constexpr std::uint32_t StringData = 0;
-	constexpr std::uint32_t StringLength = 1;
-	constexpr std::uint32_t StringCapacity = 2;
+			std::vector<std::string> nextWave;
+			for (const auto& modulePath : wave) {
+				detail::ParsedModule& module = modules[modulePath];
+				for (const auto& dependency : module.ByteFile.GetDependencies()) {
+					Provide(dependency.Path);
 
-	void Expand32(VirtualContext& context, const VirtualObject& string, std::uint64_t required) {
-		auto capacity = FIELD(string, StringCapacity).ToLong();
-		if (required <= capacity) return;
+					std::string dependencyPath = ResolveDependency(modulePath, dependency.Path);
+					if (dependencyPath.empty()) continue;
 
-		if (capacity == 0) {
-			capacity = required;
-		} else {
-			do {
-				capacity <<= 1; // Doubling
-			} while (required > capacity);
-		}
+					if (modules.find(dependencyPath) == modules.end() &&
+						std::find(nextWave.begin(), nextWave.end(), dependencyPath) == nextWave.end()) {
+						nextWave.push_back(dependencyPath);
+					}
+					module.Dependencies.push_back(std::move(dependencyPath));
+				}
+			}
 
-		const auto data = FIELD(string, StringData);
-		const auto newData = context.NewFundamental(IntObject(), capacity);
-		if (data.ToPointer() != VPNULL) {
-			context.CopyObject(newData, PDREF(data));
-			context.DeleteObject(data);
+			wave = std::move(nextWave);
 		}
 
-		data.SetPointer(PREF(newData));
-		FIELD(string, StringCapacity).SetLong(capacity);
-	}
-
-	std::u32string ConvertToCppString32(VirtualContext& context, const VirtualObject& string) {
-		const auto length = static_cast<std::size_t>(FIELD(string, StringLength).ToLong());
-		const auto data = PDREF(FIELD(string, StringData));
+		// Link dependencies before their dependents
+		std::vector<std::string> order;
+		std::unordered_set<std::string> visited;
+		SortModules(root, modules, visited, order);
 
-		std::u32string result(length, 0);
-		for (std::size_t i = 0; i < length; ++i) {
-			result[i] = ITEM(data, i).ToInt();
+		Module result = nullptr;
+		for (const auto& modulePath : order) {
+			detail::ParsedModule& parsedModule = modules[modulePath];
+			const auto beginLinking = std::chrono::steady_clock::now();
+			const Module module = detail::LoaderAdapter::Load(std::move(parsedModule.ByteFile), modulePath);
+			m_LoadTimes.push_back({ modulePath, parsedModule.ParseTime, std::chrono::steady_clock::now() - beginLinking });
+			m_ModulePaths.insert(modulePath);
+			if (modulePath == root) {
+				result = module;
+			}
 		}
 		return result;
 	}
-	void ConvertFromCppString32(VirtualContext& context, const std::u32string& cppString, const VirtualObject& string) {
-		const auto size = static_cast<std::uint64_t>(cppString.size());
-		Expand32(context, string, size);
-		FIELD(string, StringLength).SetLong(size);
-
-		const auto data = PDREF(FIELD(string, StringData));
-		for (std::size_t i = 0; i < static_cast<std::size_t>(size); ++i) {
-			ITEM(data, i).SetInt(cppString[i]);
-		}
+	const std::vector<ModuleLoadTime>& Loader::GetModuleLoadTimes() const noexcept {
+		return m_LoadTimes;
 	}
 
-	struct State {
-		VirtualModule::StructureIndex VirtualString32;
-
-		void Init(Loader& loader, std::vector<VirtualModule*>& modules) {
-			auto& module = loader.Create("/std/string.sbf");
-			modules.push_back(&module);
+	bool Loader::LoadExtension(const std::string& virtualPath) {
+		if (virtualPath.empty() || virtualPath.front() != '/' || m_ModulePaths.count(virtualPath)) return false;
 
-			VirtualString32 = module.AddStructure("String32", {
-				{ svm::PointerType, 0 }, // data
-				{ svm::LongType, 0 }, // length
-				{ svm::LongType, 0 }, // capacity
-			});
-
-			module.AddFunction("create32", 0, true, [this](VirtualContext& context) {
-				const auto result = context.PushStructure(STRUCT(VirtualString32));
-				FIELD(result, StringData).SetPointer(VPNULL);
-				FIELD(result, StringLength).SetLong(0);
-				FIELD(result, StringCapacity).SetLong(0);
-			});
+		for (const auto& directory : m_LibraryDirectories) {
+			std::filesystem::path path = std::filesystem::path(directory) / virtualPath.substr(1);
+			path.replace_extension(Extension::GetFileExtension());
+			if (!std::filesystem::exists(path)) continue;
 
-			module.AddFunction("push", 2, false, [this](VirtualContext& context) {
-				ASSERT_BEGIN {
-					const auto string = PDREF_A(PARAM_A(0, PointerType), STRUCT(VirtualString32)->Type);
-					const auto stringLength = FIELD(string, StringLength).ToLong();
-					const auto value = PARAM_A(1, IntType).ToInt();
+			Extension extension(path);
+			const SvmExtensionInit init = extension.GetInit();
+			if (!init) throw std::runtime_error("Failed to load the extension '" + path.string() + "'.");
 
-					Expand32(context, string, stringLength + 1);
-					ITEM(PDREF(FIELD(string, StringData)), stringLength).SetInt(value);
-					FIELD(string, StringLength).SetLong(stringLength + 1);
-				} ASSERT_END;
-			});
-			module.AddFunction("concat", 2, false, [this](VirtualContext& context) {
-				ASSERT_BEGIN {
-					const auto dest = PDREF_A(PARAM_A(0, PointerType), STRUCT(VirtualString32)->Type);
-					const auto destLength = FIELD(dest, StringLength).ToLong();
-					const auto src = PDREF_A(PARAM_A(1, PointerType), STRUCT(VirtualString32)->Type);
-					const auto srcLength = FIELD(src, StringLength).ToLong();
-
-					Expand32(context, dest, destLength + srcLength);
-					context.CopyObjectUnsafe(
-						PREF(ITEM(PDREF(FIELD(dest, StringData)), destLength)),
-						PREF(ITEM(PDREF(FIELD(src, StringData)), 0)), srcLength);
-					FIELD(dest, StringLength).SetLong(destLength + srcLength);
-				} ASSERT_END;
-			});
-
-			module.AddFunction("destroy", 1, false, [this](VirtualContext& context) {
-				ASSERT_BEGIN {
-					const auto string = PDREF_A(PARAM_A(0, PointerType), STRUCT(VirtualString32)->Type);
-					const auto data = FIELD(string, StringData);
-					if (data.ToPointer() != VPNULL) {
-						context.DeleteObject(data);
-					}
-				} ASSERT_END;
-			});
-		}
-	};
-}
-
-namespace svm::detail::stdlib::io {
-	constexpr std::uint32_t StreamHandle = 0;
-
-	struct Stream {
-		bool IsReadable = false;
-		bool IsWriteable = false;
-
-		virtual ~Stream() = default;
-
-		virtual std::uint32_t ReadInt() = 0;
-		virtual std::uint32_t ReadSignedInt() = 0;
-		virtual std::uint64_t ReadLong() = 0;
-		virtual std::uint64_t ReadSignedLong() = 0;
-		virtual double ReadDouble() = 0;
-		virtual std::uint32_t ReadChar32() = 0;
-		virtual std::u32string ReadString32() = 0;
-
-		virtual void WriteInt(std::uint32_t value) = 0;
-		virtual void WriteSignedInt(std::uint32_t value) = 0;
-		virtual void WriteLong(std::uint64_t value) = 0;
-		virtual void WriteSignedLong(std::uint64_t value) = 0;
-		virtual void WriteDouble(double value) = 0;
-		virtual void WriteChar32(std::uint32_t value) = 0;
-		virtual void WriteString32(const std::u32string& value) = 0;
-
-	protected:
-		template<typename T>
-		static std::uint32_t ReadChar32(T& stream) {
-			char utf8[4];
-			stream >> utf8[0];
-
-			if (static_cast<std::uint8_t>(utf8[0]) < 0x80) {
-				return utf8[0];
-			} else if (static_cast<std::uint8_t>(utf8[0]) >= 0xF0) {
-				stream >> utf8[1] >> utf8[2] >> utf8[3];
-				return ((utf8[0] & 0x07) << 18) + ((utf8[1] & 0x3F) << 12) + ((utf8[2] & 0x3F) << 6) + ((utf8[3] & 0x3F) << 0);
-			} else if (static_cast<std::uint8_t>(utf8[0]) >= 0xE0) {
-				stream >> utf8[1] >> utf8[2];
-				return ((utf8[0] & 0x0F) << 12) + ((utf8[1] & 0x3F) << 6) + ((utf8[2] & 0x3F) << 0);
-			} else {
-				stream >> utf8[1];
-				return ((utf8[0] & 0x1F) << 6) + ((utf8[1] & 0x3F) << 0);
+			// Initialized apart first, so that a failing extension leaves no half-created module behind
+			VirtualModule initializedModule(virtualPath);
+			if (init(&Extension::GetApi(), reinterpret_cast<SvmModule*>(&initializedModule)) != SVM_IEC_NONE) {
+				throw std::runtime_error("Failed to initialize the extension '" + path.string() + "'.");
 			}
-		}
-		template<typename T>
-		static std::u32string ReadString32(T& stream) {
-			std::string utf8;
-			stream >> utf8;
-
-			std::u32string utf32;
-			utf8::utf8to32(utf8.begin(), utf8.end(), std::back_inserter(utf32));
-			return utf32;
-		}
-
-		template<typename T>
-		static void WriteChar32(T& stream, std::uint32_t value) {
-			const char32_t utf32[2] = { value, 0 };
-			char utf8[5] = {};
-			utf8::utf32to8(std::begin(utf32), std::end(utf32), std::begin(utf8));
-			stream << utf8;
-		}
-		template<typename T>
-		static void WriteString32(T& stream, const std::u32string& value) {
-			std::string utf8;
-			utf8::utf32to8(value.begin(), value.end(), std::back_inserter(utf8));
-			stream << utf8;
-		}
-	};
-
-	struct ReadonlyStream : Stream {
-		ReadonlyStream() {
-			IsReadable = true;
-		}
 
-		virtual void WriteInt(std::uint32_t) override {
-			throw std::bad_function_call();
-		}
-		virtual void WriteSignedInt(std::uint32_t) override {
-			throw std::bad_function_call();
-		}
-		virtual void WriteLong(std::uint64_t) override {
-			throw std::bad_function_call();
-		}
-		virtual void WriteSignedLong(std::uint64_t) override {
-			throw std::bad_function_call();
-		}
-		virtual void WriteDouble(double) override {
-			throw std::bad_function_call();
-		}
-		virtual void WriteChar32(std::uint32_t) override {
-			throw std::bad_function_call();
-		}
-		virtual void WriteString32(const std::u32string&) override {
-			throw std::bad_function_call();
-		}
-	};
-
-	struct WriteonlyStream : Stream {
-		WriteonlyStream() {
-			IsWriteable = true;
+			VirtualModule& module = Create(virtualPath);
+			module = std::move(initializedModule);
+			Build(module);
+			m_Extensions.push_back(std::move(extension));
+			return true;
 		}
+		return false;
+	}
+	std::vector<detail::ParsedModule> Loader::ParseModules(const std::vector<std::string>& paths, std::optional<ThreadPool>& threadPool) const {
+		std::vector<detail::ParsedModule> result;
+		result.reserve(paths.size());
 
-		virtual std::uint32_t ReadInt() override {
-			throw std::bad_function_call();
-		}
-		virtual std::uint32_t ReadSignedInt() override {
-			throw std::bad_function_call();
+		if (paths.size() == 1) {
+			result.push_back(ParseModule(paths.front()));
+			return result;
+		} else if (!threadPool) {
+			threadPool.emplace(std::min(paths.size(), ThreadPool::GetDefaultWorkerCount()));
 		}
-		virtual std::uint64_t ReadLong() override {
-			throw std::bad_function_call();
-		}
-		virtual std::uint64_t ReadSignedLong() override {
-			throw std::bad_function_call();
-		}
-		virtual double ReadDouble() override {
-			throw std::bad_function_call();
-		}
-		virtual std::uint32_t ReadChar32() override {
-			throw std::bad_function_call();
-		}
-		virtual std::u32string ReadString32() override {
-			throw std::bad_function_call();
-		}
-	};
 
-	struct StdinStream : ReadonlyStream {
-		virtual std::uint32_t ReadInt() override {
-			std::uint32_t value;
-			std::cin >> value;
-			return value;
-		}
-		virtual std::uint32_t ReadSignedInt() override {
-			std::int32_t value;
-			std::cin >> value;
-			return value;
+		std::vector<std::future<detail::ParsedModule>> parsedModules;
+		for (const auto& path : paths) {
+			parsedModules.push_back(threadPool->Submit([path] {
+				return ParseModule(path);
+			}));
 		}
-		virtual std::uint64_t ReadLong() override {
-			std::uint64_t value;
-			std::cin >> value;
-			return value;
+		for (auto& parsedModule : parsedModules) {
+			result.push_back(parsedModule.get());
 		}
-		virtual std::uint64_t ReadSignedLong() override {
-			std::int64_t value;
-			std::cin >> value;
-			return value;
-		}
-		virtual double ReadDouble() override {
-			double value;
-			std::cin >> value;
-			return value;
-		}
-		virtual std::uint32_t ReadChar32() override {
-			return Stream::ReadChar32(std::cin);
-		}
-		virtual std::u32string ReadString32() override {
-			return Stream::ReadString32(std::cin);
+		return result;
+	}
+	std::string Loader::ResolveDependency(const std::string& modulePath, const std::string& dependency) const {
+		if (m_ModulePaths.count(dependency)) return {};
+
+		std::filesystem::path path;
+		if (!dependency.empty() && dependency.front() == '/') {
+			for (const auto& directory : m_LibraryDirectories) {
+				const std::filesystem::path candidate = std::filesystem::path(directory) / dependency.substr(1);
+				if (std::filesystem::exists(candidate)) {
+					path = candidate;
+					break;
+				}
+			}
+		} else {
+			path = std::filesystem::path(modulePath).parent_path() / dependency;
 		}
-	};
 
-	struct StdoutStream : WriteonlyStream {
-		virtual void WriteInt(std::uint32_t value) override {
-			std::cout << value;
-		}
-		virtual void WriteSignedInt(std::uint32_t value) override {
-			std::cout << static_cast<std::int32_t>(value);
-		}
-		virtual void WriteLong(std::uint64_t value) override {
-			std::cout << value;
-		}
-		virtual void WriteSignedLong(std::uint64_t value) override {
-			std::cout << static_cast<std::int64_t>(value);
-		}
-		virtual void WriteDouble(double value) override {
-			std::cout << value;
-		}
-		virtual void WriteChar32(std::uint32_t value) override {
-			Stream::WriteChar32(std::cout, value);
-		}
-		virtual void WriteString32(const std::u32string& value) override {
-			Stream::WriteString32(std::cout, value);
-		}
-	};
+		// Unresolvable dependencies are left to the core loader, which reports them
+		if (path.empty() || !std::filesystem::exists(path)) return {};
 
-	struct FileStream : Stream {
-		std::fstream Stream;
+		std::string result = std::filesystem::canonical(path).string();
+		if (m_ModulePaths.count(result)) return {};
+		else return result;
+	}
+	void Loader::SortModules(const std::string& path, const std::unordered_map<std::string, detail::ParsedModule>& modules,
+		std::unordered_set<std::string>& visited, std::vector<std::string>& result) const {
+		if (!visited.insert(path).second) return;
 
-		explicit FileStream(std::fstream stream)
-			: Stream(std::move(stream)) {
-			IsReadable = true;
-			IsWriteable = true;
+		for (const auto& dependency : modules.at(path).Dependencies) {
+			SortModules(dependency, modules, visited, result);
 		}
+		result.push_back(path);
+	}
 
-		virtual std::uint32_t ReadInt() override {
-			std::uint32_t value;
-			Stream >> value;
-			return value;
-		}
-		virtual std::uint32_t ReadSignedInt() override {
-			std::int32_t value;
-			Stream >> value;
-			return value;
-		}
-		virtual std::uint64_t ReadLong() override {
-			std::uint64_t value;
-			Stream >> value;
-			return value;
-		}
-		virtual std::uint64_t ReadSignedLong() override {
-			std::int64_t value;
-			Stream >> value;
-			return value;
-		}
-		virtual double ReadDouble() override {
-			double value;
-			Stream >> value;
-			return value;
-		}
-		virtual std::uint32_t ReadChar32() override {
-			return Stream::ReadChar32(Stream);
-		}
-		virtual std::u32string ReadString32() override {
-			return Stream::ReadString32(Stream);
-		}
+	detail::ParsedModule Loader::ParseModule(const std::string& path) {
+		const auto begin = std::chrono::steady_clock::now();
+		Parser parser;
+		parser.Open(path);
+		parser.Parse();
 
-		virtual void WriteInt(std::uint32_t value) override {
-			Stream << value;
-		}
-		virtual void WriteSignedInt(std::uint32_t value) override {
-			Stream << static_cast<std::int32_t>(value);
-		}
-		virtual void WriteLong(std::uint64_t value) override {
-			Stream << value;
-		}
-		virtual void WriteSignedLong(std::uint64_t value) override {
-			Stream << static_cast<std::int64_t>(value);
-		}
-		virtual void WriteDouble(double value) override {
-			Stream << value;
-		}
-		virtual void WriteChar32(std::uint32_t value) override {
-			Stream::WriteChar32(Stream, value);
-		}
-		virtual void WriteString32(const std::u32string& value) override {
-			Stream::WriteString32(Stream, value);
-		}
-	};
-
-	struct StreamManager {
-		std::list<std::unique_ptr<Stream>> Streams;
-		std::uint64_t Stdin, Stdout;
+		detail::ParsedModule result;
+		result.ByteFile = std::move(parser.GetResult());
+		result.ParseTime = std::chrono::steady_clock::now() - begin;
+		return result;
+	}
+}
 
-		StreamManager() {
-			Stdin = AddStream(std::make_unique<StdinStream>());
-			Stdout = AddStream(std::make_unique<StdoutStream>());
+namespace svm::detail::stdlib {
+	void BuildModule(Loader& loader, const ModuleDescriptor& descriptor) {
+		for (const auto dependency : descriptor.Dependencies) {
+			loader.Provide(std::string(dependency));
 		}
 
-		Stream& GetStream(std::uint64_t stream) {
-			return *reinterpret_cast<std::unique_ptr<Stream>*>(stream)->get();
+		VirtualModule& module = loader.Create(std::string(descriptor.Path));
+		for (const auto dependency : descriptor.Dependencies) {
+			module.AddDependency(std::string(dependency));
 		}
-		std::uint64_t AddStream(std::unique_ptr<Stream>&& stream) {
-			return reinterpret_cast<std::uint64_t>(&Streams.emplace_back(std::move(stream)));
+		for (const auto& mapping : descriptor.StructureMappings) {
+			module.AddStructureMapping(static_cast<VirtualModule::DependencyIndex>(mapping.Dependency), std::string(mapping.Name));
 		}
-		bool RemoveStream(std::uint64_t stream) {
-			const auto iter = FindStream(stream);
-			if (iter == Streams.end()) return false;
 
-			Streams.erase(iter);
-			return true;
-		}
-		bool IsValidStream(std::uint64_t stream) {
-			return FindStream(stream) != Streams.end();
+		for (const auto& structure : descriptor.Structures) {
+			std::vector<std::pair<Type, std::uint64_t>> fields;
+			for (const auto& field : structure.Fields) {
+				fields.emplace_back(GetFundamentalType(field.Type), field.Count);
+			}
+			module.AddStructure(std::string(structure.Name), std::move(fields));
 		}
+		for (const auto& function : descriptor.Functions) {
+			assert(function.Parameters.Count == 0 || function.Parameters.Count == function.Arity);
 
-	private:
-		decltype(Streams)::iterator FindStream(std::uint64_t stream) {
-			return std::find_if(Streams.begin(), Streams.end(), [stream](const auto& streamPtr) {
-				return stream == reinterpret_cast<std::uint64_t>(&streamPtr);
-			});
+			std::vector<Type> parameters;
+			for (const auto parameter : function.Parameters) {
+				parameters.push_back(GetFundamentalType(parameter));
+			}
+			module.AddFunction(std::string(function.Name), function.Arity, function.HasResult, function.Function, std::move(parameters));
 		}
-	};
-
-	struct State {
-		io::StreamManager StreamManager;
-
-		VirtualModule::StructureIndex VirtualStream;
-
-		VirtualModule::DependencyIndex StringModule;
-		VirtualModule::MappedStructureIndex VirtualString32;
-
-		void Init(Loader& loader, std::vector<VirtualModule*>& modules) {
-			auto& module = loader.Create("/std/io.sbf");
-			modules.push_back(&module);
-
-			VirtualStream = module.AddStructure("Stream", {
-				{ svm::LongType, 0 }, // _handle
-			});
-
-			module.AddFunction("getStdin", 0, true, [this](VirtualContext& context) {
-				const auto result = context.PushStructure(STRUCT(VirtualStream));
-				FIELD(result, 0).SetLong(StreamManager.Stdin);
-			});
-			module.AddFunction("getStdout", 0, true, [this](VirtualContext& context) {
-				const auto result = context.PushStructure(STRUCT(VirtualStream));
-				FIELD(result, 0).SetLong(StreamManager.Stdout);
-			});
-
-			module.AddFunction("openReadonlyFile", 1, true, [this](VirtualContext& context) {
-				ASSERT_BEGIN {
-					const auto path = PDREF_A(PARAM_A(0, PointerType), STRUCT(VirtualString32)->Type);
-					const auto cppPath = string::ConvertToCppString32(context, path);
-
-					const auto streamHandle = StreamManager.AddStream(std::make_unique<FileStream>(
-						std::fstream(std::filesystem::path(cppPath), std::fstream::in)));
-					const auto result = context.PushStructure(STRUCT(VirtualStream));
-					FIELD(result, StreamHandle).SetLong(streamHandle);
-				} ASSERT_END;
-			});
-			module.AddFunction("openWriteonlyFile", 1, true, [this](VirtualContext& context) {
-				ASSERT_BEGIN {
-					const auto path = PDREF_A(PARAM_A(0, PointerType), STRUCT(VirtualString32)->Type);
-					const auto cppPath = string::ConvertToCppString32(context, path);
-
-					const auto streamHandle = StreamManager.AddStream(std::make_unique<FileStream>(
-						std::fstream(std::filesystem::path(cppPath), std::fstream::out)));
-					const auto result = context.PushStructure(STRUCT(VirtualStream));
-					FIELD(result, StreamHandle).SetLong(streamHandle);
-				} ASSERT_END;
-			});
-			module.AddFunction("closeFile", 1, false, [this](VirtualContext& context) {
-				ASSERT_BEGIN {
-					const auto stream = PARAM_A(0, STRUCT(VirtualStream)->Type);
-					const auto streamHandle = FIELD(stream, StreamHandle).ToLong();
-
-					Assert(StreamManager.IsValidStream(streamHandle), SVM_IEC_STDLIB_IO_INVALIDSTREAM);
-
-					auto& cppStream = static_cast<FileStream&>(StreamManager.GetStream(streamHandle));
-					cppStream.Stream.close();
-					StreamManager.RemoveStream(streamHandle);
-				} ASSERT_END;
-			});
-
-			module.AddFunction("readInt", 1, true, [this](VirtualContext& context) {
-				ASSERT_BEGIN {
-					const auto stream = PARAM_A(0, STRUCT(VirtualStream)->Type);
-					const auto streamHandle = FIELD(stream, StreamHandle).ToLong();
-
-					Assert(StreamManager.IsValidStream(streamHandle), SVM_IEC_STDLIB_IO_INVALIDSTREAM);
-
-					auto& cppStream = static_cast<FileStream&>(StreamManager.GetStream(streamHandle));
-					context.PushFundamental(IntObject(cppStream.ReadInt()));
-				} ASSERT_END;
-			});
-			module.AddFunction("writeInt", 2, false, [this](VirtualContext& context) {
-				ASSERT_BEGIN {
-					const auto stream = PARAM_A(0, STRUCT(VirtualStream)->Type);
-					const auto streamHandle = FIELD(stream, StreamHandle).ToLong();
-					const auto value = PARAM_A(1, IntType).ToInt();
-
-					Assert(StreamManager.IsValidStream(streamHandle), SVM_IEC_STDLIB_IO_INVALIDSTREAM);
-
-					auto& cppStream = static_cast<FileStream&>(StreamManager.GetStream(streamHandle));
-					cppStream.WriteInt(value);
-				} ASSERT_END;
-			});
-			module.AddFunction("readSignedInt", 1, true, [this](VirtualContext& context) {
-				ASSERT_BEGIN {
-					const auto stream = PARAM_A(0, STRUCT(VirtualStream)->Type);
-					const auto streamHandle = FIELD(stream, StreamHandle).ToLong();
-
-					Assert(StreamManager.IsValidStream(streamHandle), SVM_IEC_STDLIB_IO_INVALIDSTREAM);
-
-					auto& cppStream = static_cast<FileStream&>(StreamManager.GetStream(streamHandle));
-					context.PushFundamental(IntObject(cppStream.ReadSignedInt()));
-				} ASSERT_END;
-			});
-			module.AddFunction("writeSignedInt", 2, false, [this](VirtualContext& context) {
-				ASSERT_BEGIN {
-					const auto stream = PARAM_A(0, STRUCT(VirtualStream)->Type);
-					const auto streamHandle = FIELD(stream, StreamHandle).ToLong();
-					const auto value = PARAM_A(1, IntType).ToInt();
-
-					Assert(StreamManager.IsValidStream(streamHandle), SVM_IEC_STDLIB_IO_INVALIDSTREAM);
-
-					auto& cppStream = static_cast<FileStream&>(StreamManager.GetStream(streamHandle));
-					cppStream.WriteSignedInt(value);
-				} ASSERT_END;
-			});
 
-			module.AddFunction("readLong", 1, true, [this](VirtualContext& context) {
-				ASSERT_BEGIN {
-					const auto stream = PARAM_A(0, STRUCT(VirtualStream)->Type);
-					const auto streamHandle = FIELD(stream, StreamHandle).ToLong();
-
-					Assert(StreamManager.IsValidStream(streamHandle), SVM_IEC_STDLIB_IO_INVALIDSTREAM);
-
-					auto& cppStream = static_cast<FileStream&>(StreamManager.GetStream(streamHandle));
-					context.PushFundamental(LongObject(cppStream.ReadLong()));
-				} ASSERT_END;
-			});
-			module.AddFunction("writeLong", 2, false, [this](VirtualContext& context) {
-				ASSERT_BEGIN {
-					const auto stream = PARAM_A(0, STRUCT(VirtualStream)->Type);
-					const auto streamHandle = FIELD(stream, StreamHandle).ToLong();
-					const auto value = PARAM_A(1, LongType).ToLong();
-
-					Assert(StreamManager.IsValidStream(streamHandle), SVM_IEC_STDLIB_IO_INVALIDSTREAM);
-
-					auto& cppStream = static_cast<FileStream&>(StreamManager.GetStream(streamHandle));
-					cppStream.WriteLong(value);
-				} ASSERT_END;
-			});
-			module.AddFunction("readSignedLong", 1, true, [this](VirtualContext& context) {
-				ASSERT_BEGIN {
-					const auto stream = PARAM_A(0, STRUCT(VirtualStream)->Type);
-					const auto streamHandle = FIELD(stream, StreamHandle).ToLong();
-
-					Assert(StreamManager.IsValidStream(streamHandle), SVM_IEC_STDLIB_IO_INVALIDSTREAM);
-
-					auto& cppStream = static_cast<FileStream&>(StreamManager.GetStream(streamHandle));
-					context.PushFundamental(LongObject(cppStream.ReadSignedLong()));
-				} ASSERT_END;
-			});
-			module.AddFunction("writeSignedLong", 2, false, [this](VirtualContext& context) {
-				ASSERT_BEGIN {
-					const auto stream = PARAM_A(0, STRUCT(VirtualStream)->Type);
-					const auto streamHandle = FIELD(stream, StreamHandle).ToLong();
-					const auto value = PARAM_A(1, LongType).ToLong();
-
-					Assert(StreamManager.IsValidStream(streamHandle), SVM_IEC_STDLIB_IO_INVALIDSTREAM);
-
-					auto& cppStream = static_cast<FileStream&>(StreamManager.GetStream(streamHandle));
-					cppStream.WriteSignedLong(value);
-				} ASSERT_END;
-			});
-
-			module.AddFunction("readDouble", 1, true, [this](VirtualContext& context) {
-				ASSERT_BEGIN {
-					const auto stream = PARAM_A(0, STRUCT(VirtualStream)->Type);
-					const auto streamHandle = FIELD(stream, StreamHandle).ToLong();
-
-					Assert(StreamManager.IsValidStream(streamHandle), SVM_IEC_STDLIB_IO_INVALIDSTREAM);
-
-					auto& cppStream = static_cast<FileStream&>(StreamManager.GetStream(streamHandle));
-					context.PushFundamental(DoubleObject(cppStream.ReadDouble()));
-				} ASSERT_END;
-			});
-			module.AddFunction("writeDouble", 2, false, [this](VirtualContext& context) {
-				ASSERT_BEGIN {
-					const auto stream = PARAM_A(0, STRUCT(VirtualStream)->Type);
-					const auto streamHandle = FIELD(stream, StreamHandle).ToLong();
-					const auto value = PARAM_A(1, DoubleType).ToDouble();
-
-					Assert(StreamManager.IsValidStream(streamHandle), SVM_IEC_STDLIB_IO_INVALIDSTREAM);
-
-					auto& cppStream = static_cast<FileStream&>(StreamManager.GetStream(streamHandle));
-					cppStream.WriteDouble(value);
-				} ASSERT_END;
-			});
-
-			module.AddFunction("readChar32", 1, true, [this](VirtualContext& context) {
-				ASSERT_BEGIN {
-					const auto stream = PARAM_A(0, STRUCT(VirtualStream)->Type);
-					const auto streamHandle = FIELD(stream, StreamHandle).ToLong();
-
-					Assert(StreamManager.IsValidStream(streamHandle), SVM_IEC_STDLIB_IO_INVALIDSTREAM);
-
-					auto& cppStream = static_cast<FileStream&>(StreamManager.GetStream(streamHandle));
-					context.PushFundamental(IntObject(cppStream.ReadChar32()));
-				} ASSERT_END;
-			});
-			module.AddFunction("writeChar32", 2, false, [this](VirtualContext& context) {
-				ASSERT_BEGIN {
-					const auto stream = PARAM_A(0, STRUCT(VirtualStream)->Type);
-					const auto streamHandle = FIELD(stream, StreamHandle).ToLong();
-					const auto value = PARAM_A(1, IntType).ToInt();
-
-					Assert(StreamManager.IsValidStream(streamHandle), SVM_IEC_STDLIB_IO_INVALIDSTREAM);
-
-					auto& cppStream = static_cast<FileStream&>(StreamManager.GetStream(streamHandle));
-					cppStream.WriteChar32(value);
-				} ASSERT_END;
-			});
-
-			module.AddFunction("readString32", 1, true, [this](VirtualContext& context) {
-				ASSERT_BEGIN {
-					const auto stream = PARAM_A(0, STRUCT(VirtualStream)->Type);
-					const auto streamHandle = FIELD(stream, StreamHandle).ToLong();
-
-					Assert(StreamManager.IsValidStream(streamHandle), SVM_IEC_STDLIB_IO_INVALIDSTREAM);
-
-					auto& cppStream = static_cast<FileStream&>(StreamManager.GetStream(streamHandle));
-					const auto result = context.PushStructure(STRUCT(VirtualString32));
-					string::ConvertFromCppString32(context, cppStream.ReadString32(), result);
-				} ASSERT_END;
-			});
-			module.AddFunction("writeString32", 2, false, [this](VirtualContext& context) {
-				ASSERT_BEGIN {
-					const auto stream = PARAM_A(0, STRUCT(VirtualStream)->Type);
-					const auto streamHandle = FIELD(stream, StreamHandle).ToLong();
-					const auto value = PDREF_A(PARAM_A(1, PointerType), STRUCT(VirtualString32)->Type);
-
-					Assert(StreamManager.IsValidStream(streamHandle), SVM_IEC_STDLIB_IO_INVALIDSTREAM);
-
-					auto& cppStream = static_cast<FileStream&>(StreamManager.GetStream(streamHandle));
-					cppStream.WriteString32(string::ConvertToCppString32(context, value));
-				} ASSERT_END;
-			});
-
-			StringModule = module.AddDependency("/std/string.sbf");
-			VirtualString32 = module.AddStructureMapping(StringModule, "String32");
-		}
-	};
+		loader.Build(module);
+	}
 }
 
 namespace svm {
-	namespace detail {
-		struct StdModuleState {
-			stdlib::array::State ArrayState;
-			stdlib::io::State IOState;
-			stdlib::string::State StringState;
-		};
-	}
-
-	StdModule InitStdModule(Loader& loader) {
-		StdModule stdModule = std::make_shared<detail::StdModuleState>();
-		std::vector<VirtualModule*> modules;
-
-		stdModule->ArrayState.Init(loader, modules);
-		stdModule->IOState.Init(loader, modules);
-		stdModule->StringState.Init(loader, modules);
+	void InitStdModule(Loader& loader) {
+		using namespace detail::stdlib;
 
-		for (const auto& module : modules) {
-			loader.Build(*module);
+		for (const ModuleDescriptor* descriptor : { &ArrayModule, &IOModule, &MapModule, &MmapModule, &StringModule, &VectorModule }) {
+			loader.AddModuleProvider(std::string(descriptor->Path), [descriptor](Loader& loader) {
+				BuildModule(loader, *descriptor);
+			});
 		}
-
-		return stdModule;
 	}
 }
\ No newline at end of file
@@ -0,0 +1,13 @@
+#include <svm/LocalStateTable.hpp>
+
+namespace svm {
+	void LocalStateTable::Clear() noexcept {
+		m_States.clear();
+		m_GCRootProviders.clear();
+	}
+	void LocalStateTable::VisitGCRoots(const std::function<void(Type*)>& visitor) {
+		for (GCRootProvider* provider : m_GCRootProviders) {
+			provider->VisitGCRoots(visitor);
+		}
+	}
+}
\ No newline at end of file
@@ -1,7 +1,12 @@
 #include <svm/Interpreter.hpp>
 #include <svm/IO.hpp>
+#include <svm/Json.hpp>
 #include <svm/Parser.hpp>
+#include <svm/PerfCounters.hpp>
+#include <svm/PerfMap.hpp>
 #include <svm/ProgramOption.hpp>
+#include <svm/Sampler.hpp>
+#include <svm/Tracer.hpp>
 #include <svm/Version.hpp>
 #include <svm/core/Version.hpp>
 #include <svm/gc/SimpleGarbageCollector.hpp>
@@ -9,19 +14,37 @@
 #include <chrono>
 #include <cstdlib>
 #include <exception>
+#include <fstream>
 #include <iomanip>
 #include <iostream>
+#include <string>
+#include <string_view>
 #include <variant>
 
 int Run(const svm::ProgramOption& option);
+void WriteProfile(const svm::ProgramOption& option, svm::Interpreter& interpreter);
+void WriteSamples(const svm::ProgramOption& option, const svm::Interpreter& interpreter, const svm::Sampler& sampler);
+void CloseTrace(const svm::ProgramOption& option, svm::Interpreter& interpreter);
+void WriteMetrics(const svm::ProgramOption& option, svm::Interpreter& interpreter, bool isSucceed,
+	std::chrono::duration<double> loading, std::chrono::duration<double> interpreting);
 
 int main(int argc, char* argv[]) {
+	std::ios::sync_with_stdio(false);
+
 	svm::ProgramOption option;
 	option.AddOption("version")
 		  .AddOption("dump-bytefile")
+		  .AddOption("profile")
+		  .AddOption("sample")
+		  .AddOption("perf-counters")
+		  .AddOption("perf-map")
+		  .AddOption("trace-top")
+		  .AddVariable("sample-interval", 1000)
 		  .AddVariable("stack", 1 * 1024 * 1024)
 		  .AddVariable("young", 8 * 1024 * 1024)
 		  .AddVariable("old", 32 * 1024 * 1024)
+		  .AddStringVariable("trace")
+		  .AddStringVariable("metrics")
 		  .AddFlag("gc", true)
 		  .AddStringList('L');
 
@@ -41,6 +64,11 @@ int main(int argc, char* argv[]) {
 }
 
 int Run(const svm::ProgramOption& option) {
+	svm::PerfCounters perfCounters;
+	if (option.GetOption("perf-counters") && !perfCounters.Open()) {
+		std::cout << "Warning: Performance counters are not available.\n";
+	}
+
 	std::cout << "Started loading...\n";
 	const auto startLoading = std::chrono::system_clock::now();
 
@@ -49,10 +77,11 @@ int Run(const svm::ProgramOption& option) {
 		loader.AddLibraryDirectory(directory);
 	}
 
-	svm::StdModule stdModule;
+	svm::InitStdModule(loader);
+
 	svm::Module program;
 	try {
-		stdModule = svm::InitStdModule(loader);
+		const svm::PerfPhaseScope perfPhase(&perfCounters, svm::VMPhase::Loading);
 		program = loader.Load(option.Path);
 	} catch (const std::exception& e) {
 		std::cout << "Occured exception!\n"
@@ -77,8 +106,41 @@ int Run(const svm::ProgramOption& option) {
 		interpreter.SetGarbageCollector(std::make_unique<svm::SimpleGarbageCollector>(
 			static_cast<std::size_t>(option.GetVariable("young")), static_cast<std::size_t>(option.GetVariable("old"))));
 	}
+	if (option.GetOption("profile")) {
+		interpreter.SetProfiler(std::make_unique<svm::Profiler>());
+	}
+	if (perfCounters.IsOpened()) {
+		interpreter.SetPerfCounters(&perfCounters);
+	}
+	if (option.GetOption("perf-map")) {
+		auto perfMap = std::make_unique<svm::PerfMap>();
+		if (perfMap->Open()) {
+			interpreter.SetPerfMap(std::move(perfMap));
+		} else {
+			std::cout << "Warning: Perf maps are not supported on this platform.\n";
+		}
+	}
+	if (const std::string& tracePath = option.GetStringVariable("trace"); !tracePath.empty()) {
+		auto tracer = std::make_unique<svm::Tracer>();
+		if (tracer->Open(tracePath, option.GetOption("trace-top"))) {
+			interpreter.SetTracer(std::move(tracer));
+		} else {
+			std::cout << "Warning: Failed to open the trace \"" << tracePath << "\".\n";
+		}
+	}
+
+	svm::Sampler sampler(std::chrono::microseconds(option.GetVariable("sample-interval")));
+	if (option.GetOption("sample") && !sampler.Start(interpreter)) {
+		std::cout << "Warning: Sampling is not supported on this platform.\n";
+	}
+
+	const bool isSucceed = interpreter.Interpret();
+	sampler.Stop();
 
-	if (!interpreter.Interpret()) {
+	const auto endInterpreting = std::chrono::system_clock::now();
+	const std::chrono::duration<double> interpreting = endInterpreting - startInterpreting;
+
+	if (!isSucceed) {
 		const auto& exception = interpreter.GetException();
 		const auto callStacks = interpreter.GetCallStacks();
 		std::cout << "Occured exception!\n"
@@ -107,11 +169,24 @@ int Run(const svm::ProgramOption& option) {
 			std::cout << '\n';
 		}
 
+		if (perfCounters.IsOpened()) {
+			perfCounters.WriteReport(std::cout);
+		}
+		if (option.GetOption("profile")) {
+			WriteProfile(option, interpreter);
+		}
+		if (option.GetOption("sample") && svm::Sampler::IsSupported()) {
+			WriteSamples(option, interpreter, sampler);
+		}
+		if (interpreter.GetTracer()) {
+			CloseTrace(option, interpreter);
+		}
+		if (!option.GetStringVariable("metrics").empty()) {
+			WriteMetrics(option, interpreter, false, loading, interpreting);
+		}
 		return EXIT_FAILURE;
 	}
 
-	const auto endInterpreting = std::chrono::system_clock::now();
-	const std::chrono::duration<double> interpreting = endInterpreting - startInterpreting;
 	std::cout << "Succeed interpreting in " << std::fixed << std::setprecision(6) << interpreting.count() << "s!\n";
 
 	if (interpreter.HasResult()) {
@@ -124,6 +199,118 @@ int Run(const svm::ProgramOption& option) {
 	std::cout << "\n----------------------------------------\n"
 			  << "Total used: " << std::fixed << std::setprecision(6) << loading.count() + interpreting.count() << "s\n";
 
+	if (perfCounters.IsOpened()) {
+		perfCounters.WriteReport(std::cout);
+	}
+
+	if (option.GetOption("profile")) {
+		WriteProfile(option, interpreter);
+	}
+	if (option.GetOption("sample") && svm::Sampler::IsSupported()) {
+		WriteSamples(option, interpreter, sampler);
+	}
+	if (interpreter.GetTracer()) {
+		CloseTrace(option, interpreter);
+	}
+	if (!option.GetStringVariable("metrics").empty()) {
+		WriteMetrics(option, interpreter, true, loading, interpreting);
+	}
 	return EXIT_SUCCESS;
+}
+
+void WriteProfile(const svm::ProgramOption& option, svm::Interpreter& interpreter) {
+	svm::Profiler& profiler = *interpreter.GetProfiler();
+	profiler.Stop();
+
+	const std::string reportPath = option.Path + ".profile.txt";
+	const std::string stacksPath = option.Path + ".folded";
+	std::ofstream report(reportPath);
+	std::ofstream stacks(stacksPath);
+	if (!report || !stacks) {
+		std::cout << "Failed to write the profile!\n";
+		return;
+	}
+
+	profiler.WriteReport(report, *interpreter.GetModuleStore());
+	profiler.WriteCollapsedStacks(stacks, *interpreter.GetModuleStore());
+	std::cout << "Wrote the profile to \"" << reportPath << "\" and \"" << stacksPath << "\".\n";
+}
+
+void WriteSamples(const svm::ProgramOption& option, const svm::Interpreter& interpreter, const svm::Sampler& sampler) {
+	const std::string reportPath = option.Path + ".samples.txt";
+	const std::string stacksPath = option.Path + ".samples.folded";
+	std::ofstream report(reportPath);
+	std::ofstream stacks(stacksPath);
+	if (!report || !stacks) {
+		std::cout << "Failed to write the samples!\n";
+		return;
+	}
+
+	sampler.WriteReport(report, *interpreter.GetModuleStore());
+	sampler.WriteCollapsedStacks(stacks, *interpreter.GetModuleStore());
+	std::cout << "Wrote " << sampler.GetSampleCount() << " samples to \"" << reportPath << "\" and \"" << stacksPath << "\".\n";
+}
 
+void CloseTrace(const svm::ProgramOption& option, svm::Interpreter& interpreter) {
+	svm::Tracer& tracer = *interpreter.GetTracer();
+	const std::string& tracePath = option.GetStringVariable("trace");
+	if (!tracer.Close()) {
+		std::cout << "Failed to write the trace!\n";
+		return;
+	}
+
+	std::cout << "Wrote " << tracer.GetRecordCount() << " instructions to \"" << tracePath << "\".\n";
+}
+
+namespace {
+	double ToSeconds(std::chrono::steady_clock::duration duration) {
+		return std::chrono::duration<double>(duration).count();
+	}
+}
+
+void WriteMetrics(const svm::ProgramOption& option, svm::Interpreter& interpreter, bool isSucceed,
+	std::chrono::duration<double> loading, std::chrono::duration<double> interpreting) {
+	const std::string& metricsPath = option.GetStringVariable("metrics");
+	std::ofstream metrics(metricsPath);
+	if (!metrics) {
+		std::cout << "Failed to write the metrics!\n";
+		return;
+	}
+
+	const svm::Heap& heap = interpreter.GetHeap();
+	const svm::GarbageCollector* const gc = heap.GetGarbageCollector();
+	const svm::GarbageCollectorStatistics gcStatistics = gc ? gc->GetStatistics() : svm::GarbageCollectorStatistics();
+	const svm::StdIOStatistics ioStatistics = svm::GetStdIOStatistics(interpreter.GetLocalStates());
+
+	metrics << std::fixed << std::setprecision(9)
+			<< "{\n"
+			<< "\t\"succeeded\": " << (isSucceed ? "true" : "false") << ",\n"
+			<< "\t\"loading_seconds\": " << loading.count() << ",\n"
+			<< "\t\"modules\": [";
+	bool isFirst = true;
+	for (const auto& module : interpreter.GetModuleStore()->GetModuleLoadTimes()) {
+		metrics << (isFirst ? "\n" : ",\n") << "\t\t{ \"path\": ";
+		svm::WriteJsonString(metrics, module.Path);
+		metrics << ", \"parse_seconds\": " << ToSeconds(module.Parse) << ", \"link_seconds\": " << ToSeconds(module.Link) << " }";
+		isFirst = false;
+	}
+	metrics << (isFirst ? "],\n" : "\n\t],\n")
+			<< "\t\"interpreting_seconds\": " << interpreting.count() << ",\n"
+			<< "\t\"instructions\": " << interpreter.GetInstructionCount() << ",\n"
+			<< "\t\"max_call_depth\": " << interpreter.GetMaxDepth() << ",\n"
+			<< "\t\"stack\": { \"size_bytes\": " << interpreter.GetStack().GetSize()
+			<< ", \"peak_used_bytes\": " << interpreter.GetStack().GetPeakUsedSize() << " },\n"
+			<< "\t\"heap\": { \"unmanaged_peak_bytes\": " << heap.GetPeakUnmanagedHeapSize()
+			<< ", \"managed_peak_bytes\": " << gcStatistics.PeakHeapSize << " },\n"
+			<< "\t\"gc\": { \"minor_count\": " << gcStatistics.MinorGCCount << ", \"major_count\": " << gcStatistics.MajorGCCount
+			<< ", \"minor_pause_seconds\": " << ToSeconds(gcStatistics.MinorGCPause)
+			<< ", \"major_pause_seconds\": " << ToSeconds(gcStatistics.MajorGCPause) << " },\n"
+			<< "\t\"io\": { \"read_bytes\": " << ioStatistics.ReadSize << ", \"written_bytes\": " << ioStatistics.WrittenSize << " }\n"
+			<< "}\n";
+
+	if (!metrics) {
+		std::cout << "Failed to write the metrics!\n";
+		return;
+	}
+	std::cout << "Wrote the metrics to \"" << metricsPath << "\".\n";
 }
\ No newline at end of file
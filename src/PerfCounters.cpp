@@ -0,0 +1,211 @@
+#include <svm/PerfCounters.hpp>
+
+#include <cassert>
+#include <iomanip>
+#include <iterator>
+
+#ifdef __linux__
+#	include <linux/perf_event.h>
+#	include <sys/syscall.h>
+#	include <unistd.h>
+#endif
+
+namespace svm {
+	namespace {
+#ifdef __linux__
+		struct PerfEventConfig final {
+			std::uint32_t Type;
+			std::uint64_t Config;
+		};
+
+		constexpr PerfEventConfig PerfEventConfigs[] = {
+			{ PERF_TYPE_HARDWARE, PERF_COUNT_HW_CPU_CYCLES },
+			{ PERF_TYPE_HARDWARE, PERF_COUNT_HW_INSTRUCTIONS },
+			{ PERF_TYPE_HARDWARE, PERF_COUNT_HW_BRANCH_MISSES },
+			{ PERF_TYPE_HARDWARE, PERF_COUNT_HW_CACHE_MISSES },
+			{ PERF_TYPE_HW_CACHE, PERF_COUNT_HW_CACHE_DTLB | (PERF_COUNT_HW_CACHE_OP_READ << 8) | (PERF_COUNT_HW_CACHE_RESULT_MISS << 16) },
+		};
+		static_assert(std::size(PerfEventConfigs) == detail::PerfEventCount);
+
+		// Matches PERF_FORMAT_TOTAL_TIME_ENABLED | PERF_FORMAT_TOTAL_TIME_RUNNING
+		struct PerfReadFormat final {
+			std::uint64_t Value;
+			std::uint64_t TimeEnabled;
+			std::uint64_t TimeRunning;
+		};
+
+		int OpenPerfEvent(const PerfEventConfig& config) noexcept {
+			perf_event_attr attribute{};
+			attribute.size = sizeof(attribute);
+			attribute.type = config.Type;
+			attribute.config = config.Config;
+			attribute.read_format = PERF_FORMAT_TOTAL_TIME_ENABLED | PERF_FORMAT_TOTAL_TIME_RUNNING;
+			attribute.exclude_kernel = 1;
+			attribute.exclude_hv = 1;
+			// Threads created later, such as the parse workers of the loader, are counted too.
+			// Their counts are added when they exit, and the loader joins its workers before loading ends
+			attribute.inherit = 1;
+
+			return static_cast<int>(syscall(SYS_perf_event_open, &attribute, 0, -1, -1, 0));
+		}
+#endif
+	}
+
+	PerfCounters::PerfCounters() noexcept {
+		m_Descriptors.fill(-1);
+	}
+	PerfCounters::~PerfCounters() {
+		Close();
+	}
+
+	bool PerfCounters::Open() {
+		assert(!IsOpened());
+
+#ifdef __linux__
+		for (std::size_t i = 0; i < detail::PerfEventCount; ++i) {
+			m_Descriptors[i] = OpenPerfEvent(PerfEventConfigs[i]);
+		}
+		m_LastRead = Read();
+		m_Phases.reserve(detail::VMPhaseCount); // Phases are entered from noexcept code, such as the GC of agcnew
+#endif
+		return IsOpened();
+	}
+	void PerfCounters::Close() noexcept {
+#ifdef __linux__
+		for (int& descriptor : m_Descriptors) {
+			if (descriptor != -1) {
+				close(descriptor);
+				descriptor = -1;
+			}
+		}
+#endif
+		m_Phases.clear();
+	}
+	bool PerfCounters::IsOpened() const noexcept {
+		for (const int descriptor : m_Descriptors) {
+			if (descriptor != -1) return true;
+		}
+		return false;
+	}
+	bool PerfCounters::IsAvailable(PerfEvent event) const noexcept {
+		return m_Descriptors[static_cast<std::size_t>(event)] != -1;
+	}
+
+	void PerfCounters::EnterPhase(VMPhase phase) {
+		if (!IsOpened()) return;
+
+		Account(Read());
+		m_Phases.push_back(phase);
+		++m_EnterCounts[static_cast<std::size_t>(phase)];
+	}
+	void PerfCounters::LeavePhase() noexcept {
+		if (!IsOpened() || m_Phases.empty()) return;
+
+		Account(Read());
+		m_Phases.pop_back();
+	}
+
+	std::uint64_t PerfCounters::GetCount(VMPhase phase, PerfEvent event) const noexcept {
+		return m_Counts[static_cast<std::size_t>(phase)][static_cast<std::size_t>(event)];
+	}
+	std::uint64_t PerfCounters::GetEnterCount(VMPhase phase) const noexcept {
+		return m_EnterCounts[static_cast<std::size_t>(phase)];
+	}
+	void PerfCounters::WriteReport(std::ostream& stream) const {
+		stream << "Performance counters:\n"
+			   << std::left << std::setw(14) << "Phase" << std::right << std::setw(10) << "Entered";
+		for (std::size_t i = 0; i < detail::PerfEventCount; ++i) {
+			stream << std::setw(18) << GetEventName(static_cast<PerfEvent>(i));
+		}
+		stream << std::setw(8) << "IPC" << '\n';
+
+		for (std::size_t i = 0; i < detail::VMPhaseCount; ++i) {
+			const VMPhase phase = static_cast<VMPhase>(i);
+			stream << std::left << std::setw(14) << GetPhaseName(phase) << std::right << std::setw(10) << GetEnterCount(phase);
+
+			for (std::size_t j = 0; j < detail::PerfEventCount; ++j) {
+				const PerfEvent event = static_cast<PerfEvent>(j);
+				if (IsAvailable(event)) {
+					stream << std::setw(18) << GetCount(phase, event);
+				} else {
+					stream << std::setw(18) << '-';
+				}
+			}
+
+			const std::uint64_t cycles = GetCount(phase, PerfEvent::Cycles);
+			if (IsAvailable(PerfEvent::Cycles) && IsAvailable(PerfEvent::Instructions) && cycles) {
+				stream << std::setw(8) << std::fixed << std::setprecision(2)
+					   << static_cast<double>(GetCount(phase, PerfEvent::Instructions)) / static_cast<double>(cycles) << '\n';
+			} else {
+				stream << std::setw(8) << '-' << '\n';
+			}
+		}
+	}
+
+	bool PerfCounters::IsSupported() noexcept {
+#ifdef __linux__
+		return true;
+#else
+		return false;
+#endif
+	}
+	const char* PerfCounters::GetEventName(PerfEvent event) noexcept {
+		switch (event) {
+		case PerfEvent::Cycles: return "cycles";
+		case PerfEvent::Instructions: return "instructions";
+		case PerfEvent::BranchMisses: return "branch-misses";
+		case PerfEvent::CacheMisses: return "cache-misses";
+		case PerfEvent::DTLBMisses: return "dTLB-misses";
+		default: return nullptr;
+		}
+	}
+	const char* PerfCounters::GetPhaseName(VMPhase phase) noexcept {
+		switch (phase) {
+		case VMPhase::Loading: return "loading";
+		case VMPhase::Interpreting: return "interpreting";
+		case VMPhase::MinorGC: return "minor GC";
+		case VMPhase::MajorGC: return "major GC";
+		default: return nullptr;
+		}
+	}
+
+	detail::PerfCounts PerfCounters::Read() const noexcept {
+		detail::PerfCounts result{};
+#ifdef __linux__
+		for (std::size_t i = 0; i < detail::PerfEventCount; ++i) {
+			PerfReadFormat value;
+			if (m_Descriptors[i] == -1 || read(m_Descriptors[i], &value, sizeof(value)) != sizeof(value) || value.TimeRunning == 0) continue;
+
+			// The kernel multiplexes the events when there are not enough counters, so the value is extrapolated
+			result[i] = value.TimeEnabled == value.TimeRunning ? value.Value :
+				static_cast<std::uint64_t>(static_cast<long double>(value.Value) * value.TimeEnabled / value.TimeRunning);
+		}
+#endif
+		return result;
+	}
+	void PerfCounters::Account(const detail::PerfCounts& counts) noexcept {
+		if (!m_Phases.empty()) {
+			detail::PerfCounts& phaseCounts = m_Counts[static_cast<std::size_t>(m_Phases.back())];
+			for (std::size_t i = 0; i < detail::PerfEventCount; ++i) {
+				if (counts[i] > m_LastRead[i]) { // Extrapolated values may go backward slightly
+					phaseCounts[i] += counts[i] - m_LastRead[i];
+				}
+			}
+		}
+		m_LastRead = counts;
+	}
+}
+
+namespace svm {
+	PerfPhaseScope::PerfPhaseScope(PerfCounters* counters, VMPhase phase)
+		: m_Counters(counters) {
+		if (m_Counters) {
+			m_Counters->EnterPhase(phase);
+		}
+	}
+	PerfPhaseScope::~PerfPhaseScope() {
+		if (m_Counters) {
+			m_Counters->LeavePhase();
+		}
+	}
+}
\ No newline at end of file
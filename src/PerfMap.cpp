@@ -0,0 +1,101 @@
+#include <svm/PerfMap.hpp>
+
+#include <svm/Macro.hpp>
+
+#include <cassert>
+#include <cstring>
+#include <ios>
+#include <string>
+
+#ifdef __linux__
+#	include <sys/mman.h>
+#	include <unistd.h>
+#endif
+
+namespace svm {
+	namespace {
+#if defined(__linux__) && defined(SVM_X64)
+#	define SVM_PERF_TRAMPOLINE
+		// push rbp; mov rbp, rsp; call rsi; pop rbp; ret. The frame pointer chain is kept for perf --call-graph=fp
+		constexpr std::uint8_t TrampolineCode[] = { 0x55, 0x48, 0x89, 0xE5, 0xFF, 0xD6, 0x5D, 0xC3 };
+		constexpr std::size_t TrampolineSize = sizeof(TrampolineCode);
+#elif defined(__linux__) && defined(__aarch64__)
+#	define SVM_PERF_TRAMPOLINE
+		// stp x29, x30, [sp, #-16]!; mov x29, sp; blr x1; ldp x29, x30, [sp], #16; ret
+		constexpr std::uint32_t TrampolineCode[] = { 0xA9BF7BFD, 0x910003FD, 0xD63F0020, 0xA8C17BFD, 0xD65F03C0 };
+		constexpr std::size_t TrampolineSize = sizeof(TrampolineCode);
+#else
+		constexpr std::size_t TrampolineSize = 0;
+#endif
+
+		constexpr std::size_t TrampolineAlignment = 16;
+		constexpr std::size_t PageSize = 64 * 1024; // A multiple of the page sizes of all the supported platforms
+	}
+
+	PerfMap::~PerfMap() {
+#ifdef __linux__
+		for (const auto& [page, size] : m_Pages) {
+			munmap(page, size);
+		}
+#endif
+	}
+
+	bool PerfMap::Open() {
+		assert(!IsOpened());
+		if (!IsSupported()) return false;
+
+#ifdef __linux__
+		m_Stream.open("/tmp/perf-" + std::to_string(getpid()) + ".map", std::ios::app);
+#endif
+		return IsOpened();
+	}
+	bool PerfMap::IsOpened() const noexcept {
+		return m_Stream.is_open();
+	}
+
+	void PerfMap::AddEntry(const void* address, std::size_t size, std::string_view name) {
+		m_Stream << std::hex << reinterpret_cast<std::uintptr_t>(address) << ' ' << size << std::dec << ' ' << name << '\n';
+		m_Stream.flush(); // perf may read the map while the process is running
+	}
+	Trampoline PerfMap::GetTrampoline(const ProfiledFunction& function, const Loader& loader) {
+		const auto iter = m_Trampolines.find(function);
+		if (iter != m_Trampolines.end()) return iter->second;
+
+		const Trampoline trampoline = CreateTrampoline();
+		if (trampoline) {
+			AddEntry(reinterpret_cast<const void*>(trampoline), TrampolineSize, "svm::" + Profiler::GetFunctionName(function, loader));
+		}
+		return m_Trampolines[function] = trampoline;
+	}
+
+	bool PerfMap::IsSupported() noexcept {
+#ifdef SVM_PERF_TRAMPOLINE
+		return true;
+#else
+		return false;
+#endif
+	}
+
+	Trampoline PerfMap::CreateTrampoline() {
+#ifdef SVM_PERF_TRAMPOLINE
+		if (m_Pages.empty() || m_PageUsedSize + TrampolineSize > PageSize) {
+			void* const page = mmap(nullptr, PageSize, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+			if (page == MAP_FAILED) return nullptr;
+
+			m_Pages.emplace_back(static_cast<std::uint8_t*>(page), PageSize);
+			m_PageUsedSize = 0;
+		} else if (mprotect(m_Pages.back().first, PageSize, PROT_READ | PROT_WRITE) != 0) return nullptr;
+
+		// No trampoline is running here, since the interpreter leaves the trampoline whenever the function changes
+		std::uint8_t* const address = m_Pages.back().first + m_PageUsedSize;
+		std::memcpy(address, TrampolineCode, TrampolineSize);
+		m_PageUsedSize += (TrampolineSize + TrampolineAlignment - 1) / TrampolineAlignment * TrampolineAlignment;
+
+		if (mprotect(m_Pages.back().first, PageSize, PROT_READ | PROT_EXEC) != 0) return nullptr;
+		__builtin___clear_cache(reinterpret_cast<char*>(address), reinterpret_cast<char*>(address + TrampolineSize));
+		return reinterpret_cast<Trampoline>(address);
+#else
+		return nullptr;
+#endif
+	}
+}
\ No newline at end of file
@@ -0,0 +1,293 @@
+#include <svm/Profiler.hpp>
+
+#include <svm/core/ByteFile.hpp>
+
+#include <algorithm>
+#include <iomanip>
+#include <map>
+#include <utility>
+
+namespace svm {
+	Profiler::Profiler() {
+		Clear();
+	}
+	Profiler::Profiler(Profiler&& profiler) noexcept
+		: m_OpCodes(profiler.m_OpCodes), m_Functions(std::move(profiler.m_Functions)), m_CallNodes(std::move(profiler.m_CallNodes)),
+		m_Frames(std::move(profiler.m_Frames)), m_PausedAt(profiler.m_PausedAt) {}
+
+	Profiler& Profiler::operator=(Profiler&& profiler) noexcept {
+		m_OpCodes = profiler.m_OpCodes;
+		m_Functions = std::move(profiler.m_Functions);
+		m_CallNodes = std::move(profiler.m_CallNodes);
+		m_Frames = std::move(profiler.m_Frames);
+		m_PausedAt = profiler.m_PausedAt;
+		return *this;
+	}
+
+	void Profiler::Clear() {
+		m_OpCodes.fill({});
+		m_Functions.clear();
+		m_CallNodes.clear();
+		m_Frames.clear();
+		m_PausedAt = 0;
+
+		detail::CallNode& root = m_CallNodes.emplace_back();
+		root.Profile = &m_Functions[root.Function];
+	}
+
+	void Profiler::EnterFunction(const ProfiledFunction& function, std::uint64_t timestamp) {
+		const std::size_t parent = m_Frames.back().Node;
+
+		std::size_t node = 0;
+		for (const std::size_t child : m_CallNodes[parent].Children) {
+			if (m_CallNodes[child].Function == function) {
+				node = child;
+				break;
+			}
+		}
+		if (node == 0) {
+			node = m_CallNodes.size();
+
+			detail::CallNode& newNode = m_CallNodes.emplace_back();
+			newNode.Function = function;
+			newNode.Profile = &m_Functions[function];
+			newNode.Parent = parent;
+			m_CallNodes[parent].Children.push_back(node);
+		}
+
+		detail::CallNode& callNode = m_CallNodes[node];
+		++callNode.CallCount;
+		++callNode.Profile->CallCount;
+		++callNode.Profile->ActiveCount;
+		m_Frames.push_back({ node, timestamp, 0 });
+	}
+	void Profiler::LeaveFunction(std::uint64_t timestamp) noexcept {
+		const detail::ProfilerFrame frame = m_Frames.back();
+		m_Frames.pop_back();
+
+		const std::uint64_t inclusive = timestamp - frame.Begin;
+		const std::uint64_t exclusive = inclusive - std::min(inclusive, frame.ChildCycles);
+
+		detail::CallNode& callNode = m_CallNodes[frame.Node];
+		callNode.InclusiveCycles += inclusive;
+		callNode.ExclusiveCycles += exclusive;
+		callNode.Profile->ExclusiveCycles += exclusive;
+		if (--callNode.Profile->ActiveCount == 0) {
+			// Recursive calls are already included in the outermost one
+			callNode.Profile->InclusiveCycles += inclusive;
+		}
+
+		if (!m_Frames.empty()) {
+			m_Frames.back().ChildCycles += inclusive;
+		}
+	}
+
+	void Profiler::Pause(std::uint64_t timestamp) noexcept {
+		m_PausedAt = timestamp;
+	}
+	void Profiler::Resume(std::uint64_t timestamp) noexcept {
+		if (m_Frames.empty()) {
+			detail::CallNode& root = m_CallNodes.front();
+			++root.CallCount;
+			++root.Profile->CallCount;
+			++root.Profile->ActiveCount;
+			m_Frames.push_back({ 0, timestamp, 0 });
+			return;
+		}
+
+		const std::uint64_t paused = timestamp - m_PausedAt;
+		for (detail::ProfilerFrame& frame : m_Frames) {
+			frame.Begin += paused;
+		}
+	}
+	void Profiler::Stop() noexcept {
+		while (!m_Frames.empty()) {
+			LeaveFunction(m_PausedAt);
+		}
+	}
+
+	const OpCodeProfile& Profiler::GetOpCodeProfile(OpCode opCode) const noexcept {
+		return m_OpCodes[static_cast<std::uint8_t>(opCode)];
+	}
+	const FunctionProfile* Profiler::GetFunctionProfile(const ProfiledFunction& function) const noexcept {
+		const auto iter = m_Functions.find(function);
+		if (iter == m_Functions.end()) return nullptr;
+		else return &iter->second;
+	}
+
+	void Profiler::WriteReport(std::ostream& stream, const Loader& loader) const {
+		std::uint64_t totalCycles = 0;
+		std::vector<OpCode> opCodes;
+		for (std::size_t i = 0; i < m_OpCodes.size(); ++i) {
+			if (m_OpCodes[i].Count == 0) continue;
+
+			totalCycles += m_OpCodes[i].Cycles;
+			opCodes.push_back(static_cast<OpCode>(i));
+		}
+		std::sort(opCodes.begin(), opCodes.end(), [this](OpCode lhs, OpCode rhs) {
+			return GetOpCodeProfile(lhs).Cycles > GetOpCodeProfile(rhs).Cycles;
+		});
+
+		stream << "Opcodes:\n"
+			   << std::left << std::setw(12) << "Mnemonic" << std::right << std::setw(16) << "Count"
+			   << std::setw(20) << "Cycles" << std::setw(12) << "Cycles/op" << std::setw(10) << "Cycles%" << '\n';
+		for (const OpCode opCode : opCodes) {
+			const OpCodeProfile& profile = GetOpCodeProfile(opCode);
+			const char* const mnemonic = GetMnemonic(opCode);
+
+			stream << std::left << std::setw(12);
+			if (mnemonic) {
+				stream << mnemonic;
+			} else {
+				stream << static_cast<int>(opCode);
+			}
+			stream << std::right << std::setw(16) << profile.Count << std::setw(20) << profile.Cycles
+				   << std::setw(12) << std::fixed << std::setprecision(1) << static_cast<double>(profile.Cycles) / profile.Count
+				   << std::setw(9) << std::setprecision(2) << (totalCycles ? 100.0 * profile.Cycles / totalCycles : 0.0) << "%\n";
+		}
+
+		std::vector<std::pair<std::string, const FunctionProfile*>> functions;
+		for (const auto& [function, profile] : m_Functions) {
+			if (profile.CallCount == 0) continue;
+
+			functions.emplace_back(GetFunctionName(function, loader), &profile);
+		}
+		std::sort(functions.begin(), functions.end(), [](const auto& lhs, const auto& rhs) {
+			return lhs.second->ExclusiveCycles > rhs.second->ExclusiveCycles;
+		});
+
+		stream << "\nFunctions:\n"
+			   << std::right << std::setw(12) << "Calls" << std::setw(20) << "Inclusive" << std::setw(20) << "Exclusive" << "  Name\n";
+		for (const auto& [name, profile] : functions) {
+			stream << std::setw(12) << profile->CallCount << std::setw(20) << profile->InclusiveCycles
+				   << std::setw(20) << profile->ExclusiveCycles << "  " << name << '\n';
+		}
+
+		std::map<std::pair<std::string, std::string>, std::pair<std::uint64_t, std::uint64_t>> edges;
+		for (std::size_t i = 1; i < m_CallNodes.size(); ++i) {
+			const detail::CallNode& callee = m_CallNodes[i];
+			const detail::CallNode& caller = m_CallNodes[callee.Parent];
+
+			auto& edge = edges[{ GetFunctionName(caller.Function, loader), GetFunctionName(callee.Function, loader) }];
+			edge.first += callee.CallCount;
+			edge.second += callee.InclusiveCycles;
+		}
+
+		stream << "\nCall graph:\n"
+			   << std::right << std::setw(12) << "Calls" << std::setw(20) << "Cycles" << "  Caller -> Callee\n";
+		for (const auto& [edge, profile] : edges) {
+			stream << std::setw(12) << profile.first << std::setw(20) << profile.second
+				   << "  " << edge.first << " -> " << edge.second << '\n';
+		}
+	}
+	void Profiler::WriteCollapsedStacks(std::ostream& stream, const Loader& loader) const {
+		std::string stack;
+		std::unordered_map<ProfiledFunction, std::string> names;
+		WriteCollapsedStacks(stream, 0, stack, names, loader);
+	}
+
+	const char* Profiler::GetMnemonic(OpCode opCode) noexcept {
+		switch (opCode) {
+		case OpCode::Push: return "push";
+		case OpCode::Pop: return "pop";
+		case OpCode::Load: return "load";
+		case OpCode::Store: return "store";
+		case OpCode::Lea: return "lea";
+		case OpCode::FLea: return "flea";
+		case OpCode::TLoad: return "tload";
+		case OpCode::TStore: return "tstore";
+		case OpCode::Copy: return "copy";
+		case OpCode::Swap: return "swap";
+
+		case OpCode::Add: return "add";
+		case OpCode::Sub: return "sub";
+		case OpCode::Mul: return "mul";
+		case OpCode::IMul: return "imul";
+		case OpCode::Div: return "div";
+		case OpCode::IDiv: return "idiv";
+		case OpCode::Mod: return "mod";
+		case OpCode::IMod: return "imod";
+		case OpCode::Neg: return "neg";
+		case OpCode::Inc: return "inc";
+		case OpCode::Dec: return "dec";
+
+		case OpCode::And: return "and";
+		case OpCode::Or: return "or";
+		case OpCode::Xor: return "xor";
+		case OpCode::Not: return "not";
+		case OpCode::Shl: return "shl";
+		case OpCode::Sal: return "sal";
+		case OpCode::Shr: return "shr";
+		case OpCode::Sar: return "sar";
+
+		case OpCode::Cmp: return "cmp";
+		case OpCode::ICmp: return "icmp";
+		case OpCode::Jmp: return "jmp";
+		case OpCode::Je: return "je";
+		case OpCode::Jne: return "jne";
+		case OpCode::Ja: return "ja";
+		case OpCode::Jae: return "jae";
+		case OpCode::Jb: return "jb";
+		case OpCode::Jbe: return "jbe";
+		case OpCode::Call: return "call";
+		case OpCode::Ret: return "ret";
+
+		case OpCode::ToI: return "toi";
+		case OpCode::ToL: return "tol";
+		case OpCode::ToD: return "tod";
+
+		case OpCode::Null: return "null";
+		case OpCode::New: return "new";
+		case OpCode::Delete: return "delete";
+		case OpCode::GCNull: return "gcnull";
+		case OpCode::GCNew: return "gcnew";
+
+		case OpCode::APush: return "apush";
+		case OpCode::ANew: return "anew";
+		case OpCode::AGCNew: return "agcnew";
+		case OpCode::ALea: return "alea";
+		case OpCode::Count: return "count";
+
+		default: return nullptr;
+		}
+	}
+	std::string Profiler::GetFunctionName(const ProfiledFunction& function, const Loader& loader) {
+		if (std::holds_alternative<Function>(function)) {
+			const Function byteFunction = std::get<Function>(function);
+			const Module module = loader.GetModule(byteFunction->Module);
+			const auto& functions = std::get<core::ByteFile>(module->Module).GetFunctions();
+			return module->Path + ":[" + std::to_string(byteFunction - functions.data()) + ']';
+		} else if (std::holds_alternative<VirtualFunction>(function)) {
+			const VirtualFunction virtualFunction = std::get<VirtualFunction>(function);
+			return loader.GetModule(virtualFunction->Module)->Path + ':' + virtualFunction->GetName();
+		} else return "entrypoint";
+	}
+
+	void Profiler::WriteCollapsedStacks(std::ostream& stream, std::size_t node, std::string& stack,
+		std::unordered_map<ProfiledFunction, std::string>& names, const Loader& loader) const {
+		const detail::CallNode& callNode = m_CallNodes[node];
+
+		auto iter = names.find(callNode.Function);
+		if (iter == names.end()) {
+			std::string name = GetFunctionName(callNode.Function, loader);
+			std::replace(name.begin(), name.end(), ';', '_');
+			std::replace(name.begin(), name.end(), ' ', '_');
+			iter = names.emplace(callNode.Function, std::move(name)).first;
+		}
+
+		const std::size_t stackSize = stack.size();
+		if (!stack.empty()) {
+			stack.push_back(';');
+		}
+		stack += iter->second;
+
+		if (callNode.ExclusiveCycles) {
+			stream << stack << ' ' << callNode.ExclusiveCycles << '\n';
+		}
+		for (const std::size_t child : callNode.Children) {
+			WriteCollapsedStacks(stream, child, stack, names, loader);
+		}
+
+		stack.resize(stackSize);
+	}
+}
\ No newline at end of file
@@ -7,13 +7,15 @@
 namespace svm {
 	ProgramOption::ProgramOption(ProgramOption&& option) noexcept
 		: Path(std::move(option.Path)),
-		Options(std::move(option.Options)), Variables(std::move(option.Variables)), Flags(std::move(option.Flags)) {}
+		Options(std::move(option.Options)), Variables(std::move(option.Variables)),
+		StringVariables(std::move(option.StringVariables)), Flags(std::move(option.Flags)) {}
 
 	ProgramOption& ProgramOption::operator=(ProgramOption&& option) noexcept {
 		Path = std::move(option.Path);
 
 		Options = std::move(option.Options);
 		Variables = std::move(option.Variables);
+		StringVariables = std::move(option.StringVariables);
 		Flags = std::move(option.Flags);
 		return *this;
 	}
@@ -23,6 +25,7 @@ namespace svm {
 
 		Options.clear();
 		Variables.clear();
+		StringVariables.clear();
 		Flags.clear();
 	}
 
@@ -34,6 +37,10 @@ namespace svm {
 		Variables[name].DefaultValue = defaultValue;
 		return *this;
 	}
+	ProgramOption& ProgramOption::AddStringVariable(const char* name, std::string defaultValue) {
+		StringVariables[name].DefaultValue = std::move(defaultValue);
+		return *this;
+	}
 	ProgramOption& ProgramOption::AddFlag(const char* name, bool defaultValue) {
 		Flags[name].DefaultValue = defaultValue;
 		return *this;
@@ -48,6 +55,9 @@ namespace svm {
 	std::uint64_t ProgramOption::GetVariable(const char* name) const {
 		return *Variables.at(name).Value;
 	}
+	const std::string& ProgramOption::GetStringVariable(const char* name) const {
+		return *StringVariables.at(name).Value;
+	}
 	bool ProgramOption::GetFlag(const char* name) const {
 		return *Flags.at(name).Value;
 	}
@@ -86,6 +96,15 @@ namespace svm {
 						return false;
 					}
 					iter->second.Value = true;
+				} else if (option.size() >= 2 && option.front() == '-' && option.find('=') != std::string_view::npos) { // StringVariable
+					const std::size_t assign = option.find('=');
+					const std::string_view var = option.substr(1, assign - 1);
+					const auto iter = StringVariables.find(var);
+					if (iter == StringVariables.end()) {
+						std::cout << "Error: Unknown variable '" << var << "'.\n";
+						return false;
+					}
+					iter->second.Value = std::string(option.substr(assign + 1));
 				} else if (option.size() >= 2 && option.front() == '-') { // Option
 					const std::string_view opt = option.substr(1);
 					const auto iter = Options.find(opt);
@@ -140,6 +159,11 @@ namespace svm {
 				var.second.Value = var.second.DefaultValue;
 			}
 		}
+		for (auto& var : StringVariables) {
+			if (!var.second.Value) {
+				var.second.Value = var.second.DefaultValue;
+			}
+		}
 		for (auto& flag : Flags) {
 			if (!flag.second.Value) {
 				flag.second.Value = flag.second.DefaultValue;
@@ -174,6 +198,11 @@ namespace svm {
 			return false;
 		}
 
+		if (GetVariable("sample-interval") == 0) {
+			std::cout << "Error: Interval of sampling cannot be zero.\n";
+			return false;
+		}
+
 		const auto& linkDirs = GetStringList('L');
 		for (const auto& linkDir : linkDirs) {
 			const std::filesystem::path path(linkDir);
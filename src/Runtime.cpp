@@ -0,0 +1,73 @@
+#include <svm/Runtime.hpp>
+
+#include <svm/gc/SimpleGarbageCollector.hpp>
+
+#include <exception>
+#include <memory>
+#include <utility>
+
+namespace svm {
+	Runtime::Runtime()
+		: m_ThreadPool(ThreadPool::GetDefaultWorkerCount()) {}
+	Runtime::Runtime(std::size_t workerCount)
+		: m_ThreadPool(workerCount) {}
+
+	std::future<Interpreter> Runtime::Run(ModuleStore loader, Module program, const IsolateOption& option) {
+		const auto isolate = std::make_shared<detail::Isolate>();
+		isolate->Option = option;
+		std::future<Interpreter> result = isolate->Promise.get_future();
+
+		// The isolate is created on the worker so that its stack and heap are first touched by the thread running it
+		m_ThreadPool.Post([this, isolate, loader = std::move(loader), program]() mutable {
+			try {
+				isolate->Interpreter = CreateIsolate(std::move(loader), program, isolate->Option);
+			} catch (...) {
+				isolate->Promise.set_exception(std::current_exception());
+				return;
+			}
+			RunSlice(std::move(isolate));
+		});
+		return result;
+	}
+	std::size_t Runtime::GetWorkerCount() const noexcept {
+		return m_ThreadPool.GetWorkerCount();
+	}
+
+	void Runtime::RunSlice(std::shared_ptr<detail::Isolate> isolate) {
+		const IsolateOption& option = isolate->Option;
+		InterpretResult result = InterpretResult::Completed;
+		try {
+			if (option.SliceInstructionCount == 0 && option.SliceDuration == std::chrono::microseconds::zero()) {
+				isolate->Interpreter.Interpret();
+			} else {
+				InterpretBudget budget;
+				budget.InstructionCount = option.SliceInstructionCount;
+				if (option.SliceDuration != std::chrono::microseconds::zero()) {
+					budget.Deadline = std::chrono::steady_clock::now() + option.SliceDuration;
+				}
+				result = isolate->Interpreter.Interpret(budget);
+			}
+		} catch (...) {
+			isolate->Promise.set_exception(std::current_exception());
+			return;
+		}
+
+		if (result == InterpretResult::Suspended) {
+			m_ThreadPool.Defer([this, isolate = std::move(isolate)]() mutable {
+				RunSlice(std::move(isolate));
+			});
+		} else {
+			isolate->Promise.set_value(std::move(isolate->Interpreter));
+		}
+	}
+
+	Interpreter Runtime::CreateIsolate(ModuleStore loader, Module program, const IsolateOption& option) {
+		Interpreter interpreter(std::move(loader), program);
+		interpreter.AllocateStack(option.StackSize);
+		if (option.UseGarbageCollector) {
+			interpreter.SetGarbageCollector(std::make_unique<SimpleGarbageCollector>(
+				option.YoungGenerationSize, option.OldGenerationSize));
+		}
+		return interpreter;
+	}
+}
\ No newline at end of file
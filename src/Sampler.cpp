@@ -0,0 +1,261 @@
+#include <svm/Sampler.hpp>
+
+#include <svm/Interpreter.hpp>
+#include <svm/Macro.hpp>
+
+#include <algorithm>
+#include <cassert>
+#include <iomanip>
+#include <string>
+#include <unordered_set>
+
+#ifndef SVM_WINDOWS
+#	include <pthread.h>
+#	include <signal.h>
+#	include <sys/time.h>
+#endif
+
+namespace svm {
+	namespace {
+		// Only the thread that runs the interpreter has it, so the signals delivered to other threads are ignored
+		thread_local Sampler* CurrentSampler = nullptr;
+
+		constexpr std::chrono::milliseconds DrainInterval(10);
+		constexpr std::size_t MaxReportedInstructions = 50;
+
+		std::unordered_set<ProfiledFunction> GetKnownFunctions(const Loader& loader) {
+			std::unordered_set<ProfiledFunction> result{ std::monostate() };
+			for (std::uint32_t i = 0; i < loader.GetModuleCount(); ++i) {
+				const Module module = loader.GetModule(i);
+				for (std::uint32_t j = 0; j < module->GetFunctionCount(); ++j) {
+					const auto function = module->GetFunction(j);
+					if (std::holds_alternative<Function>(function)) {
+						result.insert(std::get<Function>(function));
+					} else if (std::holds_alternative<VirtualFunction>(function)) {
+						result.insert(std::get<VirtualFunction>(function));
+					}
+				}
+			}
+			return result;
+		}
+	}
+
+	Sampler::Sampler(std::chrono::microseconds interval) noexcept
+		: m_Interval(interval) {}
+	Sampler::~Sampler() {
+		Stop();
+	}
+
+	bool Sampler::Start(const Interpreter& interpreter) {
+		assert(!IsStarted());
+		if (!IsSupported()) return false;
+
+		m_Interpreter = &interpreter;
+		m_Ring = std::make_unique<detail::SampleRing>();
+		m_IsStopping = false;
+		m_Drainer = std::thread(&Sampler::Drain, this);
+
+#ifndef SVM_WINDOWS
+		std::atomic_signal_fence(std::memory_order_release);
+		CurrentSampler = this;
+
+		struct sigaction action {};
+		action.sa_handler = &Sampler::HandleSignal;
+		action.sa_flags = SA_RESTART;
+		sigemptyset(&action.sa_mask);
+		sigaction(SIGPROF, &action, nullptr);
+
+		itimerval timer{};
+		timer.it_interval.tv_sec = static_cast<time_t>(m_Interval.count() / 1000000);
+		timer.it_interval.tv_usec = static_cast<suseconds_t>(m_Interval.count() % 1000000);
+		timer.it_value = timer.it_interval;
+		setitimer(ITIMER_PROF, &timer, nullptr);
+#endif
+		return true;
+	}
+	void Sampler::Stop() noexcept {
+		if (!IsStarted()) return;
+
+#ifndef SVM_WINDOWS
+		itimerval timer{};
+		setitimer(ITIMER_PROF, &timer, nullptr);
+
+		// A signal may still be pending, and its default action terminates the process
+		struct sigaction action {};
+		action.sa_handler = SIG_IGN;
+		sigemptyset(&action.sa_mask);
+		sigaction(SIGPROF, &action, nullptr);
+
+		if (CurrentSampler == this) {
+			CurrentSampler = nullptr;
+		}
+#endif
+
+		{
+			std::lock_guard lock(m_Mutex);
+			m_IsStopping = true;
+		}
+		m_Condition.notify_all();
+		m_Drainer.join();
+
+		Consume();
+		m_Interpreter = nullptr;
+	}
+	bool Sampler::IsStarted() const noexcept {
+		return m_Drainer.joinable();
+	}
+
+	std::uint64_t Sampler::GetSampleCount() const noexcept {
+		return m_SampleCount;
+	}
+	std::uint64_t Sampler::GetDroppedCount() const noexcept {
+		return m_Ring ? m_Ring->DroppedCount.load(std::memory_order_relaxed) : 0;
+	}
+
+	void Sampler::WriteReport(std::ostream& stream, const Loader& loader) const {
+		const std::unordered_set<ProfiledFunction> knownFunctions = GetKnownFunctions(loader);
+		const auto getName = [&](const ProfiledFunction& function) -> std::string {
+			if (knownFunctions.find(function) == knownFunctions.end()) return "<unknown>";
+			else return Profiler::GetFunctionName(function, loader);
+		};
+		const auto getPercent = [this](std::uint64_t count) {
+			return m_SampleCount ? 100.0 * count / m_SampleCount : 0.0;
+		};
+
+		stream << "Samples: " << m_SampleCount << " (" << GetDroppedCount() << " dropped, every " << m_Interval.count() << "us)\n";
+
+		std::vector<std::pair<std::string, detail::SampleCount>> functions;
+		for (const auto& [function, count] : m_Functions) {
+			functions.emplace_back(getName(function), count);
+		}
+		std::sort(functions.begin(), functions.end(), [](const auto& lhs, const auto& rhs) {
+			return lhs.second.Self > rhs.second.Self;
+		});
+
+		stream << "\nFunctions:\n"
+			   << std::right << std::setw(12) << "Self" << std::setw(9) << "Self%" << std::setw(12) << "Total" << std::setw(9) << "Total%" << "  Name\n";
+		for (const auto& [name, count] : functions) {
+			stream << std::setw(12) << count.Self << std::setw(8) << std::fixed << std::setprecision(2) << getPercent(count.Self) << '%'
+				   << std::setw(12) << count.Total << std::setw(8) << getPercent(count.Total) << "%  " << name << '\n';
+		}
+
+		std::vector<std::pair<std::pair<ProfiledFunction, std::uint64_t>, std::uint64_t>> instructions(m_Instructions.begin(), m_Instructions.end());
+		std::sort(instructions.begin(), instructions.end(), [](const auto& lhs, const auto& rhs) {
+			return lhs.second > rhs.second;
+		});
+		if (instructions.size() > MaxReportedInstructions) {
+			instructions.resize(MaxReportedInstructions);
+		}
+
+		stream << "\nInstructions:\n"
+			   << std::right << std::setw(12) << "Samples" << std::setw(9) << "%" << "  Location\n";
+		for (const auto& [location, count] : instructions) {
+			const auto& [function, index] = location;
+			stream << std::setw(12) << count << std::setw(8) << getPercent(count) << "%  " << getName(function) << '(' << index << ')';
+
+			if (std::holds_alternative<Function>(function) && knownFunctions.find(function) != knownFunctions.end()) {
+				const Instructions& functionInstructions = std::get<Function>(function)->Instructions;
+				if (index < functionInstructions.GetInstructionCount()) {
+					if (const char* const mnemonic = Profiler::GetMnemonic(functionInstructions.GetInstruction(index).OpCode); mnemonic) {
+						stream << ' ' << mnemonic;
+					}
+				}
+			}
+			stream << '\n';
+		}
+	}
+	void Sampler::WriteCollapsedStacks(std::ostream& stream, const Loader& loader) const {
+		const std::unordered_set<ProfiledFunction> knownFunctions = GetKnownFunctions(loader);
+		std::unordered_map<ProfiledFunction, std::string> names;
+
+		for (const auto& [stack, count] : m_Stacks) {
+			for (auto iter = stack.begin(); iter < stack.end(); ++iter) {
+				auto name = names.find(*iter);
+				if (name == names.end()) {
+					std::string newName = knownFunctions.find(*iter) != knownFunctions.end() ? Profiler::GetFunctionName(*iter, loader) : "<unknown>";
+					std::replace(newName.begin(), newName.end(), ';', '_');
+					std::replace(newName.begin(), newName.end(), ' ', '_');
+					name = names.emplace(*iter, std::move(newName)).first;
+				}
+
+				if (iter != stack.begin()) {
+					stream << ';';
+				}
+				stream << name->second;
+			}
+			stream << ' ' << count << '\n';
+		}
+	}
+
+	bool Sampler::IsSupported() noexcept {
+#ifdef SVM_WINDOWS
+		return false;
+#else
+		return true;
+#endif
+	}
+
+	void Sampler::HandleSignal(int) noexcept {
+		Sampler* const sampler = CurrentSampler;
+		if (!sampler) return;
+
+		detail::SampleRing& ring = *sampler->m_Ring;
+		const std::uint64_t tail = ring.Tail.load(std::memory_order_relaxed);
+		if (tail - ring.Head.load(std::memory_order_acquire) == detail::SampleRing::Capacity) {
+			ring.DroppedCount.fetch_add(1, std::memory_order_relaxed);
+			return;
+		}
+
+		sampler->m_Interpreter->CaptureSample(ring.Samples[tail & (detail::SampleRing::Capacity - 1)]);
+		ring.Tail.store(tail + 1, std::memory_order_release);
+	}
+
+	void Sampler::Drain() {
+#ifndef SVM_WINDOWS
+		sigset_t signals;
+		sigemptyset(&signals);
+		sigaddset(&signals, SIGPROF);
+		pthread_sigmask(SIG_BLOCK, &signals, nullptr);
+#endif
+
+		std::unique_lock lock(m_Mutex);
+		while (!m_IsStopping) {
+			m_Condition.wait_for(lock, DrainInterval);
+			Consume();
+		}
+	}
+	void Sampler::Consume() {
+		detail::SampleRing& ring = *m_Ring;
+		const std::uint64_t tail = ring.Tail.load(std::memory_order_acquire);
+		for (std::uint64_t head = ring.Head.load(std::memory_order_relaxed); head < tail; ++head) {
+			Aggregate(ring.Samples[head & (detail::SampleRing::Capacity - 1)]);
+		}
+		ring.Head.store(tail, std::memory_order_release);
+	}
+	void Sampler::Aggregate(const detail::Sample& sample) {
+		if (sample.Depth == 0) return;
+
+		++m_SampleCount;
+		++m_Functions[sample.Frames[0].Function].Self;
+
+		std::vector<ProfiledFunction> stack;
+		for (std::size_t i = 0; i < sample.Depth; ++i) {
+			const ProfiledFunction& function = sample.Frames[i].Function;
+			if (std::find(stack.begin(), stack.end(), function) == stack.end()) {
+				++m_Functions[function].Total;
+			}
+			stack.push_back(function);
+		}
+		std::reverse(stack.begin(), stack.end());
+		++m_Stacks[std::move(stack)];
+
+		// Virtual functions have no instructions, so their time is charged to the call instruction
+		for (std::size_t i = 0; i < sample.Depth; ++i) {
+			const detail::SampleFrame& frame = sample.Frames[i];
+			if (!std::holds_alternative<VirtualFunction>(frame.Function)) {
+				++m_Instructions[{ frame.Function, frame.Instruction }];
+				break;
+			}
+		}
+	}
+}
\ No newline at end of file
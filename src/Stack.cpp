@@ -1,5 +1,6 @@
 #include <svm/Stack.hpp>
 
+#include <algorithm>
 #include <utility>
 
 namespace svm {
@@ -46,6 +47,14 @@ namespace svm {
 	std::size_t Stack::GetFreeSize() const noexcept {
 		return GetSize() - GetUsedSize();
 	}
+	std::size_t Stack::GetPeakUsedSize() const noexcept {
+		// The stack grows down from the end of zeroed memory and every object begins with a non-null type,
+		// so the lowest non-zero byte marks the deepest use without any bookkeeping on push
+		const auto lowest = std::find_if(m_Data.begin(), m_Data.end(), [](std::uint8_t byte) {
+			return byte != 0;
+		});
+		return std::max(static_cast<std::size_t>(m_Data.end() - lowest), m_Used);
+	}
 
 	bool Stack::Expand(std::size_t delta) noexcept {
 		if (GetFreeSize() < delta) return false;
@@ -0,0 +1,130 @@
+#include <svm/ThreadPool.hpp>
+
+#include <algorithm>
+#include <cassert>
+#include <utility>
+
+namespace svm {
+	namespace {
+		thread_local const ThreadPool* CurrentPool = nullptr;
+		thread_local std::size_t CurrentWorker = 0;
+	}
+
+	ThreadPool::ThreadPool(std::size_t workerCount) {
+		Start(workerCount);
+	}
+	ThreadPool::~ThreadPool() {
+		Stop();
+	}
+
+	void ThreadPool::Start(std::size_t workerCount) {
+		assert(!IsStarted());
+		assert(workerCount != 0);
+
+		m_IsStopping = false;
+		m_Queues.clear();
+		for (std::size_t i = 0; i < workerCount; ++i) {
+			m_Queues.push_back(std::make_unique<detail::WorkerQueue>());
+		}
+		for (std::size_t i = 0; i < workerCount; ++i) {
+			m_Workers.emplace_back(&ThreadPool::Work, this, i);
+		}
+	}
+	void ThreadPool::Stop() noexcept {
+		{
+			std::lock_guard lock(m_Mutex);
+			m_IsStopping = true;
+		}
+		m_Condition.notify_all();
+
+		for (auto& worker : m_Workers) {
+			worker.join();
+		}
+		m_Workers.clear();
+	}
+	bool ThreadPool::IsStarted() const noexcept {
+		return !m_Workers.empty();
+	}
+	std::size_t ThreadPool::GetWorkerCount() const noexcept {
+		return m_Workers.size();
+	}
+
+	void ThreadPool::Post(std::function<void()> job) {
+		Push(std::move(job), false);
+	}
+	void ThreadPool::Defer(std::function<void()> job) {
+		Push(std::move(job), true);
+	}
+
+	std::size_t ThreadPool::GetDefaultWorkerCount() noexcept {
+		return std::max<std::size_t>(std::thread::hardware_concurrency(), 1);
+	}
+
+	void ThreadPool::Push(std::function<void()> job, bool isDeferred) {
+		assert(IsStarted());
+
+		// Jobs posted by a worker stay on its own queue; others are spread round-robin
+		const std::size_t index = CurrentPool == this ? CurrentWorker : m_NextQueue++ % m_Queues.size();
+		{
+			detail::WorkerQueue& queue = *m_Queues[index];
+			std::lock_guard lock(queue.Mutex);
+
+			// A deferred job goes behind everything already queued, which is also where thieves look first
+			if (isDeferred) {
+				queue.Jobs.push_front(std::move(job));
+			} else {
+				queue.Jobs.push_back(std::move(job));
+			}
+		}
+		m_JobCount.fetch_add(1);
+
+		{
+			// Pairs with the predicate check in Work so that the notification cannot be lost
+			std::lock_guard lock(m_Mutex);
+		}
+		m_Condition.notify_one();
+	}
+	void ThreadPool::Work(std::size_t index) {
+		CurrentPool = this;
+		CurrentWorker = index;
+
+		while (true) {
+			if (auto job = TakeJob(index)) {
+				(*job)();
+				continue;
+			}
+
+			std::unique_lock lock(m_Mutex);
+			m_Condition.wait(lock, [this] {
+				return m_IsStopping || m_JobCount.load() != 0;
+			});
+			if (m_IsStopping && m_JobCount.load() == 0) return;
+		}
+	}
+	std::optional<std::function<void()>> ThreadPool::TakeJob(std::size_t index) {
+		// The newest job of the own queue is the most likely to be cache-hot
+		{
+			detail::WorkerQueue& queue = *m_Queues[index];
+			std::lock_guard lock(queue.Mutex);
+			if (!queue.Jobs.empty()) {
+				std::function<void()> job = std::move(queue.Jobs.back());
+				queue.Jobs.pop_back();
+				m_JobCount.fetch_sub(1);
+				return job;
+			}
+		}
+
+		// Steal the oldest job of another worker
+		for (std::size_t i = 1; i < m_Queues.size(); ++i) {
+			detail::WorkerQueue& queue = *m_Queues[(index + i) % m_Queues.size()];
+			std::lock_guard lock(queue.Mutex);
+			if (!queue.Jobs.empty()) {
+				std::function<void()> job = std::move(queue.Jobs.front());
+				queue.Jobs.pop_front();
+				m_JobCount.fetch_sub(1);
+				return job;
+			}
+		}
+		return std::nullopt;
+	}
+}
\ No newline at end of file
@@ -0,0 +1,165 @@
+#include <svm/Tracer.hpp>
+
+#include <cassert>
+#include <cstring>
+#include <stdexcept>
+#include <utility>
+
+namespace svm {
+	Tracer::~Tracer() {
+		Close();
+	}
+
+	bool Tracer::Open(const std::string& path, bool recordsTopValue) {
+		assert(!IsOpened());
+
+		m_Stream.open(path, std::ios::binary | std::ios::trunc);
+		if (!m_Stream) return false;
+
+		const std::uint8_t flags = recordsTopValue ? detail::TraceTopValueFlag : 0;
+		m_Stream.write(detail::TraceMagic, sizeof(detail::TraceMagic));
+		m_Stream.put(static_cast<char>(detail::TraceVersion));
+		m_Stream.put(static_cast<char>(flags));
+
+		m_RecordsTopValue = recordsTopValue;
+		m_RecordCount = 0;
+		m_HasMoved = true;
+		m_Index = 0;
+		m_TopValue = 0;
+
+		// The count of chunks bounds the memory, and the interpreter waits for the writer if it falls behind
+		m_Chunk.Data = std::make_unique<std::uint8_t[]>(detail::TraceChunkSize);
+		m_Chunk.Size = 0;
+		for (std::size_t i = 1; i < detail::TraceChunkCount; ++i) {
+			m_FreeChunks.push_back({ std::make_unique<std::uint8_t[]>(detail::TraceChunkSize), 0 });
+		}
+
+		m_IsStopping = false;
+		m_Writer = std::thread(&Tracer::Write, this);
+		return true;
+	}
+	bool Tracer::Close() {
+		if (!IsOpened()) return true;
+
+		{
+			std::lock_guard lock(m_Mutex);
+			if (m_Chunk.Size) {
+				m_FullChunks.push_back(std::move(m_Chunk));
+			}
+			m_IsStopping = true;
+		}
+		m_Condition.notify_all();
+		m_Writer.join();
+
+		m_Chunk = {};
+		m_FreeChunks.clear();
+
+		m_Stream.flush();
+		const bool isSucceed = static_cast<bool>(m_Stream);
+		m_Stream.close();
+		return isSucceed;
+	}
+	bool Tracer::IsOpened() const noexcept {
+		return m_Writer.joinable();
+	}
+	bool Tracer::RecordsTopValue() const noexcept {
+		return m_RecordsTopValue;
+	}
+	std::uint64_t Tracer::GetRecordCount() const noexcept {
+		return m_RecordCount;
+	}
+
+	void Tracer::SubmitChunk() {
+		std::unique_lock lock(m_Mutex);
+		m_FullChunks.push_back(std::move(m_Chunk));
+		m_Condition.notify_all();
+
+		m_Condition.wait(lock, [this] { return !m_FreeChunks.empty(); });
+		m_Chunk = std::move(m_FreeChunks.back());
+		m_FreeChunks.pop_back();
+	}
+	void Tracer::Write() {
+		std::unique_lock lock(m_Mutex);
+		while (true) {
+			m_Condition.wait(lock, [this] { return m_IsStopping || !m_FullChunks.empty(); });
+			if (m_FullChunks.empty()) return;
+
+			detail::TraceChunk chunk = std::move(m_FullChunks.front());
+			m_FullChunks.pop_front();
+
+			lock.unlock();
+			m_Stream.write(reinterpret_cast<const char*>(chunk.Data.get()), static_cast<std::streamsize>(chunk.Size));
+			chunk.Size = 0;
+			lock.lock();
+
+			m_FreeChunks.push_back(std::move(chunk));
+			m_Condition.notify_all();
+		}
+	}
+}
+
+namespace svm {
+	TraceReader::TraceReader(std::istream& stream)
+		: m_Stream(&stream) {
+		char magic[sizeof(detail::TraceMagic)];
+		char version = 0, flags = 0;
+		if (!stream.read(magic, sizeof(magic)) || std::memcmp(magic, detail::TraceMagic, sizeof(magic)) != 0 ||
+			!stream.get(version) || !stream.get(flags)) throw std::runtime_error("Invalid trace.");
+		else if (static_cast<std::uint8_t>(version) != detail::TraceVersion) throw std::runtime_error("Unsupported version of trace.");
+
+		m_HasTopValues = (static_cast<std::uint8_t>(flags) & detail::TraceTopValueFlag) != 0;
+	}
+
+	bool TraceReader::HasTopValues() const noexcept {
+		return m_HasTopValues;
+	}
+	bool TraceReader::Read(TraceRecord& record) {
+		if (m_Stream->peek() == std::istream::traits_type::eof()) return false;
+
+		const std::uint64_t header = ReadVarint();
+		if (header & detail::TraceHasLocation) {
+			m_Record.Module = static_cast<std::uint32_t>(ReadVarint());
+			m_Record.Function = static_cast<std::uint32_t>(ReadVarint());
+			m_Record.Index = ReadVarint();
+			m_HasLocation = true;
+		} else if (!m_HasLocation) {
+			throw std::runtime_error("Invalid trace record.");
+		} else {
+			std::uint64_t delta = 0;
+			if (header & detail::TraceHasJump) {
+				const std::uint64_t zigzag = ReadVarint();
+				delta = (zigzag >> 1) ^ (0 - (zigzag & 1));
+			}
+			m_Record.Index += delta + 1;
+		}
+		m_Record.OpCode = static_cast<OpCode>(header >> 2);
+
+		if (m_HasTopValues) {
+			const std::uint64_t typeCode = ReadVarint();
+			if (typeCode == 0) {
+				m_Record.TopTypeCode.reset();
+			} else {
+				m_Record.TopTypeCode = static_cast<std::uint32_t>(typeCode - 1);
+				if (detail::HasTraceValue(*m_Record.TopTypeCode)) {
+					const std::uint64_t zigzag = ReadVarint();
+					m_Record.TopValue += (zigzag >> 1) ^ (0 - (zigzag & 1));
+				}
+			}
+		}
+
+		record = m_Record;
+		return true;
+	}
+
+	std::uint64_t TraceReader::ReadVarint() {
+		std::uint64_t result = 0;
+		for (int shift = 0; shift < 64; shift += 7) {
+			const auto byte = m_Stream->get();
+			if (byte == std::istream::traits_type::eof()) throw std::runtime_error("Truncated trace.");
+
+			result |= static_cast<std::uint64_t>(byte & 0x7F) << shift;
+			if ((byte & 0x80) == 0) return result;
+		}
+		throw std::runtime_error("Invalid trace record.");
+	}
+}
\ No newline at end of file
@@ -2,11 +2,16 @@
 
 #include <svm/Interpreter.hpp>
 #include <svm/Object.hpp>
+#include <svm/PerfCounters.hpp>
 #include <svm/Structure.hpp>
 #include <svm/Type.hpp>
+#include <svm/detail/PackedArray.hpp>
 
+#include <algorithm>
 #include <cassert>
+#include <chrono>
 #include <cstring>
+#include <limits>
 #include <unordered_set>
 #include <utility>
 
@@ -15,7 +20,9 @@ namespace svm {
 		Initialize(youngGenerationSize, oldGenerationSize);
 	}
 	SimpleGarbageCollector::SimpleGarbageCollector(SimpleGarbageCollector&& gc) noexcept
-		: m_YoungGeneration(std::move(gc.m_YoungGeneration)), m_OldGeneration(std::move(gc.m_OldGeneration)), m_CardTable(std::move(gc.m_CardTable)) {}
+		: m_YoungGeneration(std::move(gc.m_YoungGeneration)), m_OldGeneration(std::move(gc.m_OldGeneration)), m_CardTable(std::move(gc.m_CardTable)) {
+		m_Statistics = gc.m_Statistics;
+	}
 	SimpleGarbageCollector::~SimpleGarbageCollector() {
 		Reset();
 	}
@@ -26,6 +33,7 @@ namespace svm {
 		m_YoungGeneration = std::move(gc.m_YoungGeneration);
 		m_OldGeneration = std::move(gc.m_OldGeneration);
 		m_CardTable = std::move(gc.m_CardTable);
+		m_Statistics = gc.m_Statistics;
 		return *this;
 	}
 
@@ -33,6 +41,7 @@ namespace svm {
 		m_YoungGeneration.Reset();
 		m_OldGeneration.Reset();
 		m_CardTable.clear();
+		m_Statistics = {};
 	}
 	void SimpleGarbageCollector::Initialize(std::size_t youngGenerationSize, std::size_t oldGenerationSize) {
 		assert(!IsInitialized());
@@ -41,12 +50,14 @@ namespace svm {
 
 		m_YoungGeneration.Initialize(youngGenerationSize);
 		m_OldGeneration.Initialize(oldGenerationSize);
+		UpdatePeakHeapSize();
 	}
 	bool SimpleGarbageCollector::IsInitialized() const noexcept {
 		return !m_YoungGeneration.IsInitalized() && m_YoungGeneration.IsInitalized();
 	}
 
 	void* SimpleGarbageCollector::Allocate(Interpreter& interpreter, std::size_t size) {
+		if (size > std::numeric_limits<std::size_t>::max() - sizeof(ManagedHeapInfo)) return nullptr;
 		size += sizeof(ManagedHeapInfo);
 
 		ManagedHeapInfo* address = nullptr;
@@ -59,6 +70,8 @@ namespace svm {
 		std::memset(address + 1, 0, size - sizeof(ManagedHeapInfo));
 		address->Size = size;
 		address->Age = 0;
+
+		UpdatePeakHeapSize();
 		return address;
 	}
 	void SimpleGarbageCollector::MakeDirty(const void* address) noexcept {
@@ -70,8 +83,19 @@ namespace svm {
 		card |= 1 << bit;
 	}
 
+	void SimpleGarbageCollector::ForceMinorGC(Interpreter& interpreter) {
+		if (!IsPinned()) {
+			MinorGC(interpreter);
+		}
+	}
+	void SimpleGarbageCollector::ForceMajorGC(Interpreter& interpreter) {
+		if (!IsPinned()) {
+			MajorGC(interpreter, nullptr);
+		}
+	}
+
 	void* SimpleGarbageCollector::AllocateOnYoungGeneration(Interpreter& interpreter, std::size_t size) {
-		if (size > m_YoungGeneration.GetCurrentBlockFreeSize()) {
+		if (size > m_YoungGeneration.GetCurrentBlockFreeSize() && !IsPinned()) {
 			MinorGC(interpreter);
 		}
 
@@ -83,7 +107,7 @@ namespace svm {
 	}
 	void* SimpleGarbageCollector::AllocateOnOldGeneration(Interpreter& interpreter, PointerTable* minorPointerTable, std::size_t size) {
 		if (size > m_OldGeneration.GetDefaultBlockSize()) return m_OldGeneration.CreateNewBlock(size);
-		else if (size > m_OldGeneration.GetCurrentBlockFreeSize()) {
+		else if (size > m_OldGeneration.GetCurrentBlockFreeSize() && !IsPinned()) {
 			MajorGC(interpreter, minorPointerTable);
 		}
 
@@ -95,6 +119,8 @@ namespace svm {
 	}
 
 	void SimpleGarbageCollector::MajorGC(Interpreter& interpreter, PointerTable* minorPointerTable) {
+		const PerfPhaseScope perfPhase(interpreter.GetPerfCounters(), VMPhase::MajorGC);
+		const auto begin = std::chrono::steady_clock::now();
 		PointerTable pointerTable;
 		PointerList grayColorList;
 
@@ -107,9 +133,16 @@ namespace svm {
 		const auto firstBlock = Sweep(interpreter, &m_OldGeneration, pointerTable, nullptr);
 		MoveSurvived(&m_OldGeneration, firstBlock, pointerTable);
 		UpdateTables(pointerTable, minorPointerTable);
+		UpdatePeakHeapSize();
 		m_OldGeneration.DeleteEmptyBlocks();
+
+		++m_Statistics.MajorGCCount;
+		m_Statistics.MajorGCPause += std::chrono::steady_clock::now() - begin;
 	}
 	void SimpleGarbageCollector::MinorGC(Interpreter& interpreter) {
+		const PerfPhaseScope perfPhase(interpreter.GetPerfCounters(), VMPhase::MinorGC);
+		const auto begin = std::chrono::steady_clock::now();
+		const auto majorGCPause = m_Statistics.MajorGCPause; // Promotions may start a major GC
 		PointerTable pointerTable;
 		PointerList grayColorList;
 		PointerList promoted;
@@ -123,7 +156,14 @@ namespace svm {
 		const auto firstBlock = Sweep(interpreter, &m_YoungGeneration, pointerTable, &promoted);
 		MoveSurvived(&m_YoungGeneration, firstBlock, pointerTable);
 		UpdateCardTable(interpreter, promoted);
+		UpdatePeakHeapSize();
 		m_YoungGeneration.DeleteEmptyBlocks();
+
+		++m_Statistics.MinorGCCount;
+		m_Statistics.MinorGCPause += std::chrono::steady_clock::now() - begin - (m_Statistics.MajorGCPause - majorGCPause);
+	}
+	void SimpleGarbageCollector::UpdatePeakHeapSize() noexcept {
+		m_Statistics.PeakHeapSize = std::max(m_Statistics.PeakHeapSize, m_YoungGeneration.GetSize() + m_OldGeneration.GetSize());
 	}
 
 	void SimpleGarbageCollector::MarkGCRoots(Interpreter& interpreter, ManagedHeapGeneration* generation, PointerTable& pointerTable, PointerList& grayColorList) {
@@ -131,6 +171,10 @@ namespace svm {
 		for (std::uint32_t i = 0; i < varCount; ++i) {
 			MarkObject(interpreter, generation, pointerTable, grayColorList, interpreter.GetLocalVariable(i));
 		}
+
+		interpreter.GetLocalStates().VisitGCRoots([&](Type* root) {
+			MarkObject(interpreter, generation, pointerTable, grayColorList, root);
+		});
 	}
 	void SimpleGarbageCollector::MarkGCObjects(Interpreter& interpreter, ManagedHeapGeneration* generation, PointerTable& pointerTable, PointerList& grayColorList) {
 		while (grayColorList.size()) {
@@ -159,6 +203,8 @@ namespace svm {
 			}
 		} else if (typePtr->IsArray()) {
 			ArrayObject* const array = reinterpret_cast<ArrayObject*>(typePtr);
+			if (detail::IsPackedArray(array)) return; // Packed elements never hold pointers
+
 			const std::uint64_t elementCount = array->Count;
 			Type* elementPtr = reinterpret_cast<Type*>(array + 1);
 
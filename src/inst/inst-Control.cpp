@@ -4,7 +4,9 @@
 #include <svm/virtual/VirtualContext.hpp>
 #include <svm/virtual/VirtualStack.hpp>
 
+#include <algorithm>
 #include <cstring>
+#include <vector>
 
 namespace svm {
 	template<typename T>
@@ -131,6 +133,7 @@ namespace svm {
 
 		m_StackFrame = { NoneType, m_Stack.GetUsedSize(), static_cast<std::uint32_t>(m_LocalVariables.size()) };
 		std::uint16_t arity = 0;
+		const std::vector<Type>* parameters = nullptr;
 
 		m_StackFrame.Program = orgProgram;
 		m_StackFrame.Function = GetFunction(operand);
@@ -145,6 +148,9 @@ namespace svm {
 			const VirtualFunction function = std::get<VirtualFunction>(m_StackFrame.Function);
 
 			arity = function->GetArity();
+			if (!function->GetParameters().empty()) {
+				parameters = &function->GetParameters();
+			}
 		}
 
 		std::size_t stackOffset = m_Stack.GetUsedSize() - sizeof(m_StackFrame);
@@ -169,22 +175,31 @@ namespace svm {
 				m_LocalVariables.erase(m_LocalVariables.end() - j - 1, m_LocalVariables.end());
 				return;
 			}
+
+			// Parameters of virtual functions are checked here once, so that the functions can read them unchecked
+			if (parameters && (*parameters)[j] != NoneType && (*parameters)[j] != type) {
+				OccurException(SVM_IEC_STDLIB_TYPEASSERTFAIL);
+				m_StackFrame = *m_Stack.Pop<StackFrame>();
+				m_LocalVariables.erase(m_LocalVariables.end() - j - 1, m_LocalVariables.end());
+				return;
+			}
 		}
 
 		++m_Depth;
+		m_MaxDepth = std::max(m_MaxDepth, m_Depth);
 
 		if (std::holds_alternative<Function>(m_StackFrame.Function)) {
-			m_StackFrame.Program = m_Loader.GetModule(std::get<Function>(m_StackFrame.Function)->Module);
+			m_StackFrame.Program = m_Loader->GetModule(std::get<Function>(m_StackFrame.Function)->Module);
 		} else if (std::holds_alternative<VirtualFunction>(m_StackFrame.Function)) {
-			m_StackFrame.Program = m_Loader.GetModule(std::get<VirtualFunction>(m_StackFrame.Function)->Module);
+			m_StackFrame.Program = m_Loader->GetModule(std::get<VirtualFunction>(m_StackFrame.Function)->Module);
 
 			const VirtualFunction function = std::get<VirtualFunction>(m_StackFrame.Function);
 
 			VirtualStack stack(&m_Stack, &m_StackFrame, &m_LocalVariables);
 			VirtualContext context(*this, stack, m_Heap);
-			(*function)(context);
-
-			if (!m_Exception) {
+			if (const std::uint32_t code = (*function)(context); code != SVM_IEC_NONE) {
+				OccurException(code);
+			} else if (!m_Exception) {
 				InterpretRet();
 			}
 		}
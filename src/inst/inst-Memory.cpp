@@ -1,6 +1,7 @@
 #include <svm/Interpreter.hpp>
 
 #include <svm/detail/InterpreterExceptionCode.hpp>
+#include <svm/detail/PackedArray.hpp>
 
 #include <cstring>
 
@@ -25,6 +26,15 @@ namespace svm {
 		if (!targetType) {
 			OccurException(SVM_IEC_POINTER_NULLPOINTER);
 			return;
+		} else if (detail::IsPackedPointer(targetType)) {
+			if (detail::GetPackedPointerType(targetType) != *rhsTypePtr) {
+				OccurException(SVM_IEC_STACK_DIFFERENTTYPE);
+				return;
+			}
+
+			*static_cast<decltype(T::Value)*>(detail::GetPackedPointerAddress(targetType)) = reinterpret_cast<const T*>(rhsTypePtr)->Value;
+			m_Stack.Reduce(sizeof(PointerObject) + sizeof(T));
+			return;
 		} else if (*lhsTypePtr == GCPointerType) {
 			targetType = reinterpret_cast<Type*>(reinterpret_cast<ManagedHeapInfo*>(targetType) + 1);
 		}
@@ -59,6 +69,9 @@ namespace svm {
 		if (!targetType) {
 			OccurException(SVM_IEC_POINTER_NULLPOINTER);
 			return;
+		} else if (detail::IsPackedPointer(targetType)) {
+			OccurException(SVM_IEC_STACK_DIFFERENTTYPE);
+			return;
 		} else if (*lhsTypePtr == GCPointerType) {
 			targetType = reinterpret_cast<Type*>(reinterpret_cast<ManagedHeapInfo*>(targetType) + 1);
 		}
@@ -93,6 +106,9 @@ namespace svm {
 		if (!targetType) {
 			OccurException(SVM_IEC_POINTER_NULLPOINTER);
 			return;
+		} else if (detail::IsPackedPointer(targetType)) {
+			OccurException(SVM_IEC_STACK_DIFFERENTTYPE);
+			return;
 		} else if (*lhsTypePtr == GCPointerType) {
 			targetType = reinterpret_cast<Type*>(reinterpret_cast<ManagedHeapInfo*>(targetType) + 1);
 		}
@@ -138,7 +154,7 @@ namespace svm {
 			targetTypePtr = reinterpret_cast<Type*>(reinterpret_cast<ManagedHeapInfo*>(targetTypePtr) + 1);
 		}
 
-		if (!targetTypePtr->IsStructure()) {
+		if (detail::IsPackedPointer(targetTypePtr) || !targetTypePtr->IsStructure()) {
 			m_Stack.Expand(sizeof(*ptr));
 			OccurException(SVM_IEC_STRUCTURE_NOTSTRUCTURE);
 			return;
@@ -174,6 +190,25 @@ namespace svm {
 			m_Stack.Expand(sizeof(*ptr));
 			OccurException(SVM_IEC_POINTER_NULLPOINTER);
 			return;
+		} else if (detail::IsPackedPointer(targetTypePtr)) {
+			const Type targetType = detail::GetPackedPointerType(targetTypePtr);
+			const void* const address = detail::GetPackedPointerAddress(targetTypePtr);
+			bool isSuccess = false;
+			if (targetType == IntType) {
+				isSuccess = m_Stack.Push<IntObject>(*static_cast<const std::uint32_t*>(address));
+			} else if (targetType == LongType) {
+				isSuccess = m_Stack.Push<LongObject>(*static_cast<const std::uint64_t*>(address));
+			} else if (targetType == SingleType) {
+				isSuccess = m_Stack.Push<SingleObject>(*static_cast<const float*>(address));
+			} else if (targetType == DoubleType) {
+				isSuccess = m_Stack.Push<DoubleObject>(*static_cast<const double*>(address));
+			}
+
+			if (!isSuccess) {
+				m_Stack.Expand(sizeof(*ptr));
+				OccurException(SVM_IEC_STACK_OVERFLOW);
+			}
+			return;
 		} else if (ptr->GetType() == GCPointerType) {
 			targetTypePtr = reinterpret_cast<const Type*>(reinterpret_cast<const ManagedHeapInfo*>(targetTypePtr) + 1);
 		}
@@ -331,7 +366,8 @@ namespace svm {
 			return;
 		}
 
-		void* const address = m_Heap.AllocateUnmanagedHeap(info.Size);
+		// An array too large to have a size fails like any other allocation
+		void* const address = info.Size != 0 ? m_Heap.AllocateUnmanagedHeap(info.Size) : nullptr;
 		if (address) {
 			InitArray(info, static_cast<Type*>(address));
 		}
@@ -350,7 +386,7 @@ namespace svm {
 			return;
 		}
 
-		void* const address = m_Heap.AllocateManagedHeap(*this, info.Size);
+		void* const address = info.Size != 0 ? m_Heap.AllocateManagedHeap(*this, info.Size) : nullptr;
 		Type* const addressReal = reinterpret_cast<Type*>(static_cast<ManagedHeapInfo*>(address) + 1);
 		if (address) {
 			InitArray(info, addressReal);
@@ -400,7 +436,7 @@ namespace svm {
 			targetTypePtr = reinterpret_cast<Type*>(reinterpret_cast<ManagedHeapInfo*>(targetTypePtr) + 1);
 		}
 
-		if (!targetTypePtr->IsArray()) {
+		if (detail::IsPackedPointer(targetTypePtr) || !targetTypePtr->IsArray()) {
 			OccurException(SVM_IEC_ARRAY_NOTARRAY);
 			return;
 		}
@@ -413,7 +449,12 @@ namespace svm {
 
 		Type* const elementType = reinterpret_cast<Type*>(array + 1);
 		m_Stack.Reduce(indexType->Size + sizeof(PointerObject));
-		m_Stack.Push<PointerObject>(reinterpret_cast<std::uint8_t*>(elementType) + index * elementType->GetReference().Size);
+		if (detail::IsPackedElementType(*elementType)) {
+			m_Stack.Push<PointerObject>(detail::MakePackedPointer(
+				static_cast<std::uint8_t*>(detail::GetPackedElements(array)) + index * detail::GetPackedElementSize(*elementType), *elementType));
+		} else {
+			m_Stack.Push<PointerObject>(reinterpret_cast<std::uint8_t*>(elementType) + index * elementType->GetReference().Size);
+		}
 	}
 	SVM_NOINLINE_FOR_PROFILING void Interpreter::InterpretCount() noexcept {
 		if (IsLocalVariable()) {
@@ -440,7 +481,7 @@ namespace svm {
 			targetTypePtr = reinterpret_cast<const Type*>(reinterpret_cast<const ManagedHeapInfo*>(targetTypePtr) + 1);
 		}
 
-		if (!targetTypePtr->IsArray()) {
+		if (detail::IsPackedPointer(targetTypePtr) || !targetTypePtr->IsArray()) {
 			m_Stack.Expand(sizeof(*ptr));
 			OccurException(SVM_IEC_ARRAY_NOTARRAY);
 			return;
@@ -1,6 +1,7 @@
 #include <svm/Interpreter.hpp>
 
 #include <svm/detail/InterpreterExceptionCode.hpp>
+#include <svm/detail/PackedArray.hpp>
 
 #include <cmath>
 #include <type_traits>
@@ -516,6 +517,21 @@ namespace svm {
 		if (!targetTypePtr) {
 			OccurException(SVM_IEC_POINTER_NULLPOINTER);
 			return;
+		} else if (detail::IsPackedPointer(targetTypePtr)) {
+			const Type targetType = detail::GetPackedPointerType(targetTypePtr);
+			void* const address = detail::GetPackedPointerAddress(targetTypePtr);
+			if (targetType == IntType) {
+				*static_cast<std::uint32_t*>(address) += delta;
+			} else if (targetType == LongType) {
+				*static_cast<std::uint64_t*>(address) += delta;
+			} else if (targetType == SingleType) {
+				*static_cast<float*>(address) += delta;
+			} else if (targetType == DoubleType) {
+				*static_cast<double*>(address) += delta;
+			}
+
+			m_Stack.Reduce(sizeof(PointerObject));
+			return;
 		} else if (*typePtr == GCPointerType) {
 			targetTypePtr = reinterpret_cast<Type*>(reinterpret_cast<ManagedHeapInfo*>(targetTypePtr) + 1);
 		}
@@ -2,9 +2,11 @@
 
 #include <svm/ConstantPool.hpp>
 #include <svm/detail/InterpreterExceptionCode.hpp>
+#include <svm/detail/PackedArray.hpp>
 
 #include <algorithm>
 #include <cstring>
+#include <limits>
 
 namespace svm {
 	SVM_NOINLINE_FOR_PROFILING void Interpreter::PushStructure(std::uint32_t code) noexcept {
@@ -401,6 +403,11 @@ namespace svm {
 		reinterpret_cast<ArrayObject*>(type)->Count = static_cast<std::size_t>(info.Count);
 		type = reinterpret_cast<Type*>(reinterpret_cast<std::uint8_t*>(type) + sizeof(ArrayObject));
 
+		if (detail::IsPackedElementType(info.ElementType)) {
+			*type = info.ElementType;
+			return;
+		}
+
 		for (std::uint64_t i = 0; i < info.Count; ++i) {
 			if (info.ElementType.IsStructure()) {
 				InitStructure(structure, type);
@@ -411,7 +418,10 @@ namespace svm {
 		}
 	}
 	SVM_NOINLINE_FOR_PROFILING std::size_t Interpreter::CalcArraySize(const ArrayObject* array) const noexcept {
-		const std::size_t elementSize = reinterpret_cast<const Type*>(array + 1)->GetReference().Size;
+		const Type elementType = *reinterpret_cast<const Type*>(array + 1);
+		if (detail::IsPackedElementType(elementType)) return detail::CalcPackedArraySize(elementType, array->Count);
+
+		const std::size_t elementSize = elementType->Size;
 		return static_cast<std::size_t>(array->Count * elementSize + sizeof(ArrayObject));
 	}
 
@@ -424,7 +434,11 @@ namespace svm {
 		InitArray(info, reinterpret_cast<Type*>(object));
 	}
 	std::size_t Interpreter::CalcArraySize(Type type, std::uint64_t count) const noexcept {
-		return static_cast<std::size_t>(type->Size * count + sizeof(ArrayObject));
+		if (detail::IsPackedElementType(type)) return detail::CalcPackedArraySize(type, count);
+
+		const std::size_t elementSize = type->Size;
+		if (count > (std::numeric_limits<std::size_t>::max() - sizeof(ArrayObject)) / elementSize) return 0;
+		return static_cast<std::size_t>(count) * elementSize + sizeof(ArrayObject);
 	}
 }
 
@@ -435,7 +449,7 @@ namespace svm {
 			return;
 		}
 
-		if (m_Stack.GetFreeSize() < info.Size - info.CountSize) {
+		if (info.Size == 0 || m_Stack.GetFreeSize() < info.Size - info.CountSize) {
 			OccurException(SVM_IEC_STACK_OVERFLOW);
 			return;
 		}
@@ -0,0 +1,334 @@
+#include <svm/detail/Stdlib.hpp>
+
+#include <svm/Macro.hpp>
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+
+#ifdef SVM_SSE2
+#	include <emmintrin.h>
+#endif
+
+namespace svm::detail::stdlib::array {
+	// The kernels work on the packed values directly; their loops are kept free of
+	// dependencies between iterations so that the compiler can vectorize them.
+	template<typename T>
+	T Sum(const T* elements, std::uint64_t count) noexcept {
+		T sums[4] = {};
+		std::uint64_t i = 0;
+		for (; i + 4 <= count; i += 4) {
+			sums[0] += elements[i];
+			sums[1] += elements[i + 1];
+			sums[2] += elements[i + 2];
+			sums[3] += elements[i + 3];
+		}
+		for (; i < count; ++i) {
+			sums[0] += elements[i];
+		}
+		return (sums[0] + sums[1]) + (sums[2] + sums[3]);
+	}
+	template<typename T>
+	T Dot(const T* lhs, const T* rhs, std::uint64_t count) noexcept {
+		T sums[4] = {};
+		std::uint64_t i = 0;
+		for (; i + 4 <= count; i += 4) {
+			sums[0] += lhs[i] * rhs[i];
+			sums[1] += lhs[i + 1] * rhs[i + 1];
+			sums[2] += lhs[i + 2] * rhs[i + 2];
+			sums[3] += lhs[i + 3] * rhs[i + 3];
+		}
+		for (; i < count; ++i) {
+			sums[0] += lhs[i] * rhs[i];
+		}
+		return (sums[0] + sums[1]) + (sums[2] + sums[3]);
+	}
+#ifdef SVM_SSE2
+	// Floating-point additions cannot be reordered by the compiler, so doubles are summed two lanes at a time explicitly
+	template<>
+	double Sum(const double* elements, std::uint64_t count) noexcept {
+		__m128d sums[2] = { _mm_setzero_pd(), _mm_setzero_pd() };
+		std::uint64_t i = 0;
+		for (; i + 4 <= count; i += 4) {
+			sums[0] = _mm_add_pd(sums[0], _mm_loadu_pd(elements + i));
+			sums[1] = _mm_add_pd(sums[1], _mm_loadu_pd(elements + i + 2));
+		}
+
+		double lanes[2];
+		_mm_storeu_pd(lanes, _mm_add_pd(sums[0], sums[1]));
+		double result = lanes[0] + lanes[1];
+		for (; i < count; ++i) {
+			result += elements[i];
+		}
+		return result;
+	}
+	template<>
+	double Dot(const double* lhs, const double* rhs, std::uint64_t count) noexcept {
+		__m128d sums[2] = { _mm_setzero_pd(), _mm_setzero_pd() };
+		std::uint64_t i = 0;
+		for (; i + 4 <= count; i += 4) {
+			sums[0] = _mm_add_pd(sums[0], _mm_mul_pd(_mm_loadu_pd(lhs + i), _mm_loadu_pd(rhs + i)));
+			sums[1] = _mm_add_pd(sums[1], _mm_mul_pd(_mm_loadu_pd(lhs + i + 2), _mm_loadu_pd(rhs + i + 2)));
+		}
+
+		double lanes[2];
+		_mm_storeu_pd(lanes, _mm_add_pd(sums[0], sums[1]));
+		double result = lanes[0] + lanes[1];
+		for (; i < count; ++i) {
+			result += lhs[i] * rhs[i];
+		}
+		return result;
+	}
+#endif
+	template<typename T>
+	T Min(const T* elements, std::uint64_t count) noexcept {
+		T result = elements[0];
+		for (std::uint64_t i = 1; i < count; ++i) {
+			result = elements[i] < result ? elements[i] : result;
+		}
+		return result;
+	}
+	template<typename T>
+	T Max(const T* elements, std::uint64_t count) noexcept {
+		T result = elements[0];
+		for (std::uint64_t i = 1; i < count; ++i) {
+			result = elements[i] > result ? elements[i] : result;
+		}
+		return result;
+	}
+	template<typename T>
+	std::int32_t Compare(const T* lhs, const T* rhs, std::uint64_t count) noexcept {
+		const auto [lhsEnd, rhsEnd] = std::mismatch(lhs, lhs + count, rhs);
+		if (lhsEnd == lhs + count) return 0;
+		else if (*lhsEnd > *rhsEnd) return 1;
+		else return -1;
+	}
+}
+
+namespace svm::detail::stdlib::array {
+	// Only arrays of int, long and double are supported; signed operations reinterpret int and long elements
+	template<bool IsSigned, typename F>
+	void VisitElements(Type elementType, F&& function) {
+		if (elementType == IntType) {
+			function(static_cast<std::conditional_t<IsSigned, std::int32_t, std::uint32_t>*>(nullptr));
+		} else if (elementType == LongType) {
+			function(static_cast<std::conditional_t<IsSigned, std::int64_t, std::uint64_t>*>(nullptr));
+		} else if (elementType == DoubleType) {
+			function(static_cast<double*>(nullptr));
+		} else throw SVM_IEC_STDLIB_TYPEASSERTFAIL;
+	}
+	template<typename T>
+	T* GetElements(VirtualContext& context, const VirtualObject& array, std::uint64_t begin, std::uint64_t count) {
+		Assert(IsValidRange(begin, count, array.GetCount()), SVM_IEC_STDLIB_ARRAY_OUTOFRANGE);
+		return reinterpret_cast<T*>(GetElementData<std::remove_cv_t<T>>(context, array, begin));
+	}
+
+	template<typename T>
+	T ToValue(const VirtualObject& object) {
+		if constexpr (sizeof(T) == sizeof(std::uint32_t)) return static_cast<T>(Assert(object, IntType).ToInt());
+		else if constexpr (std::is_integral_v<T>) return static_cast<T>(Assert(object, LongType).ToLong());
+		else return Assert(object, DoubleType).ToDouble();
+	}
+	template<typename T>
+	void PushValue(VirtualContext& context, T value) {
+		if constexpr (sizeof(T) == sizeof(std::uint32_t)) context.PushFundamental(IntObject(static_cast<std::uint32_t>(value)));
+		else if constexpr (std::is_integral_v<T>) context.PushFundamental(LongObject(static_cast<std::uint64_t>(value)));
+		else context.PushFundamental(DoubleObject(value));
+	}
+
+	std::uint32_t Fill(VirtualContext& context) {
+		ASSERT_BEGIN {
+			const auto array = PDREF_A(PARAM(0), ArrayType);
+			const auto begin = PARAM(1).ToLong();
+			const auto count = PARAM(2).ToLong();
+			const auto value = PARAM(3);
+
+			VisitElements<false>(array.IsArray(), [&](auto* type) {
+				using T = std::remove_pointer_t<decltype(type)>;
+				T* const elements = GetElements<T>(context, array, begin, count);
+				std::fill(elements, elements + count, ToValue<T>(value));
+			});
+		} ASSERT_END;
+		return SVM_IEC_NONE;
+	}
+	std::uint32_t SumFunction(VirtualContext& context) {
+		ASSERT_BEGIN {
+			const auto array = PDREF_A(PARAM(0), ArrayType);
+			const auto begin = PARAM(1).ToLong();
+			const auto count = PARAM(2).ToLong();
+
+			VisitElements<false>(array.IsArray(), [&](auto* type) {
+				using T = std::remove_pointer_t<decltype(type)>;
+				PushValue(context, Sum(GetElements<const T>(context, array, begin, count), count));
+			});
+		} ASSERT_END;
+		return SVM_IEC_NONE;
+	}
+	template<bool IsSigned, bool IsMax>
+	std::uint32_t MinMax(VirtualContext& context) {
+		ASSERT_BEGIN {
+			const auto array = PDREF_A(PARAM(0), ArrayType);
+			const auto begin = PARAM(1).ToLong();
+			const auto count = PARAM(2).ToLong();
+
+			Assert(count != 0, SVM_IEC_STDLIB_ARRAY_OUTOFRANGE);
+			VisitElements<IsSigned>(array.IsArray(), [&](auto* type) {
+				using T = std::remove_pointer_t<decltype(type)>;
+				const T* const elements = GetElements<const T>(context, array, begin, count);
+				if constexpr (IsMax) {
+					PushValue(context, Max(elements, count));
+				} else {
+					PushValue(context, Min(elements, count));
+				}
+			});
+		} ASSERT_END;
+		return SVM_IEC_NONE;
+	}
+	std::uint32_t DotFunction(VirtualContext& context) {
+		ASSERT_BEGIN {
+			const auto lhs = PDREF_A(PARAM(0), ArrayType);
+			const auto lhsBegin = PARAM(1).ToLong();
+			const auto rhs = PDREF_A(PARAM(2), ArrayType);
+			const auto rhsBegin = PARAM(3).ToLong();
+			const auto count = PARAM(4).ToLong();
+
+			Assert(lhs.IsArray() == rhs.IsArray(), SVM_IEC_STDLIB_TYPEASSERTFAIL);
+			VisitElements<false>(lhs.IsArray(), [&](auto* type) {
+				using T = std::remove_pointer_t<decltype(type)>;
+				PushValue(context, Dot(
+					GetElements<const T>(context, lhs, lhsBegin, count),
+					GetElements<const T>(context, rhs, rhsBegin, count), count));
+			});
+		} ASSERT_END;
+		return SVM_IEC_NONE;
+	}
+	template<bool IsMul>
+	std::uint32_t Arithmetic(VirtualContext& context) {
+		ASSERT_BEGIN {
+			const auto dest = PDREF_A(PARAM(0), ArrayType);
+			const auto destBegin = PARAM(1).ToLong();
+			const auto src = PDREF_A(PARAM(2), ArrayType);
+			const auto srcBegin = PARAM(3).ToLong();
+			const auto count = PARAM(4).ToLong();
+
+			Assert(dest.IsArray() == src.IsArray(), SVM_IEC_STDLIB_TYPEASSERTFAIL);
+			VisitElements<false>(dest.IsArray(), [&](auto* type) {
+				using T = std::remove_pointer_t<decltype(type)>;
+				T* const destElements = GetElements<T>(context, dest, destBegin, count);
+				const T* const srcElements = GetElements<const T>(context, src, srcBegin, count);
+				for (std::uint64_t i = 0; i < count; ++i) {
+					if constexpr (IsMul) {
+						destElements[i] *= srcElements[i];
+					} else {
+						destElements[i] += srcElements[i];
+					}
+				}
+			});
+		} ASSERT_END;
+		return SVM_IEC_NONE;
+	}
+	std::uint32_t IndexOf(VirtualContext& context) {
+		ASSERT_BEGIN {
+			const auto array = PDREF_A(PARAM(0), ArrayType);
+			const auto begin = PARAM(1).ToLong();
+			const auto count = PARAM(2).ToLong();
+			const auto value = PARAM(3);
+
+			VisitElements<false>(array.IsArray(), [&](auto* type) {
+				using T = std::remove_pointer_t<decltype(type)>;
+				const T* const elements = GetElements<const T>(context, array, begin, count);
+				const T* const result = std::find(elements, elements + count, ToValue<T>(value));
+				context.PushFundamental(LongObject(result == elements + count ?
+					static_cast<std::uint64_t>(-1) : begin + static_cast<std::uint64_t>(result - elements)));
+			});
+		} ASSERT_END;
+		return SVM_IEC_NONE;
+	}
+	template<bool IsSigned>
+	std::uint32_t CompareFunction(VirtualContext& context) {
+		ASSERT_BEGIN {
+			const auto lhs = PDREF_A(PARAM(0), ArrayType);
+			const auto lhsBegin = PARAM(1).ToLong();
+			const auto rhs = PDREF_A(PARAM(2), ArrayType);
+			const auto rhsBegin = PARAM(3).ToLong();
+			const auto count = PARAM(4).ToLong();
+
+			Assert(lhs.IsArray() == rhs.IsArray(), SVM_IEC_STDLIB_TYPEASSERTFAIL);
+			VisitElements<IsSigned>(lhs.IsArray(), [&](auto* type) {
+				using T = std::remove_pointer_t<decltype(type)>;
+				PushOrdering(context, Compare(
+					GetElements<const T>(context, lhs, lhsBegin, count),
+					GetElements<const T>(context, rhs, rhsBegin, count), count));
+			});
+		} ASSERT_END;
+		return SVM_IEC_NONE;
+	}
+	template<bool IsSigned>
+	std::uint32_t Sort(VirtualContext& context) {
+		ASSERT_BEGIN {
+			const auto array = PDREF_A(PARAM(0), ArrayType);
+			const auto begin = PARAM(1).ToLong();
+			const auto count = PARAM(2).ToLong();
+
+			VisitElements<IsSigned>(array.IsArray(), [&](auto* type) {
+				using T = std::remove_pointer_t<decltype(type)>;
+				T* const elements = GetElements<T>(context, array, begin, count);
+				if constexpr (std::is_floating_point_v<T>) {
+					// NaNs are moved to the end so that the ordering stays strict weak
+					std::sort(elements, elements + count, [](T lhs, T rhs) {
+						return lhs < rhs || (lhs == lhs && rhs != rhs);
+					});
+				} else {
+					std::sort(elements, elements + count);
+				}
+			});
+		} ASSERT_END;
+		return SVM_IEC_NONE;
+	}
+
+	std::uint32_t Copy(VirtualContext& context) {
+		ASSERT_BEGIN {
+			const auto dest = PDREF_A(PARAM(0), ArrayType);
+			const auto destBegin = PARAM(1).ToLong();
+			const auto src = PDREF_A(PARAM(2), ArrayType);
+			const auto srcBegin = PARAM(3).ToLong();
+			const auto count = PARAM(4).ToLong();
+
+			Assert(dest.IsArray() == src.IsArray(), SVM_IEC_STDLIB_TYPEASSERTFAIL);
+			Assert(IsValidRange(destBegin, count, dest.GetCount()), SVM_IEC_STDLIB_ARRAY_OUTOFRANGE);
+			Assert(IsValidRange(srcBegin, count, src.GetCount()), SVM_IEC_STDLIB_ARRAY_OUTOFRANGE);
+
+			context.CopyObjectUnsafe(PREF(ITEM(dest, destBegin)), PREF(ITEM(src, srcBegin)), count);
+		} ASSERT_END;
+		return SVM_IEC_NONE;
+	}
+
+	constexpr TypeCode RangeParameters[] = { TypeCode::Pointer, TypeCode::Long, TypeCode::Long }; // array, begin, count
+	constexpr TypeCode ValueParameters[] = { TypeCode::Pointer, TypeCode::Long, TypeCode::Long, TypeCode::None }; // array, begin, count, value
+	constexpr TypeCode BinaryParameters[] = { TypeCode::Pointer, TypeCode::Long, TypeCode::Pointer, TypeCode::Long, TypeCode::Long };
+
+	constexpr FunctionDescriptor Functions[] = {
+		{ "copy", 5, false, Copy, BinaryParameters },
+		{ "fill", 4, false, Fill, ValueParameters },
+		{ "sum", 3, true, SumFunction, RangeParameters },
+		{ "min", 3, true, MinMax<false, false>, RangeParameters },
+		{ "max", 3, true, MinMax<false, true>, RangeParameters },
+		{ "imin", 3, true, MinMax<true, false>, RangeParameters },
+		{ "imax", 3, true, MinMax<true, true>, RangeParameters },
+		{ "dot", 5, true, DotFunction, BinaryParameters },
+		{ "add", 5, false, Arithmetic<false>, BinaryParameters },
+		{ "mul", 5, false, Arithmetic<true>, BinaryParameters },
+		{ "indexOf", 4, true, IndexOf, ValueParameters },
+		{ "compare", 5, true, CompareFunction<false>, BinaryParameters },
+		{ "icompare", 5, true, CompareFunction<true>, BinaryParameters },
+		{ "sort", 3, false, Sort<false>, RangeParameters },
+		{ "isort", 3, false, Sort<true>, RangeParameters },
+	};
+}
+
+namespace svm::detail::stdlib {
+	constexpr ModuleDescriptor ArrayModule = {
+		"/std/array.sbf", {}, {}, {}, array::Functions,
+	};
+}
\ No newline at end of file
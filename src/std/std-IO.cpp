@@ -0,0 +1,683 @@
+#include <svm/detail/Stdlib.hpp>
+
+#include <svm/LocalStateTable.hpp>
+#include <svm/detail/HandleTable.hpp>
+
+#include <algorithm>
+#include <charconv>
+#include <filesystem>
+#include <fstream>
+#include <functional>
+#include <iostream>
+#include <iterator>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <system_error>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace svm::detail::stdlib::io {
+	constexpr std::uint32_t StreamHandle = 0;
+	constexpr std::size_t StreamBufferSize = 1 * 1024 * 1024;
+	constexpr std::size_t MaxNumberLength = 64;
+	constexpr std::size_t MaxDoubleLength = 320; // A double in fixed notation with 6 digits after the point
+
+	// Text and binary values are read and written straight through a std::streambuf,
+	// with std::from_chars/std::to_chars instead of the locale-aware iostream operators.
+	struct Stream {
+		std::streambuf* ReadBuffer = nullptr;
+		std::streambuf* WriteBuffer = nullptr;
+		std::ostream* Tie = nullptr; // Flushed before reading, like std::cin's tie
+		std::string Utf8; // Reused for transcoding String32 values
+		std::chars_format DoubleFormat = std::chars_format::general;
+		std::uint64_t ReadSize = 0;
+		std::uint64_t WrittenSize = 0;
+
+		virtual ~Stream() = default;
+
+		std::uint32_t ReadInt() {
+			return ReadNumber<std::uint32_t>();
+		}
+		std::uint32_t ReadSignedInt() {
+			return static_cast<std::uint32_t>(ReadNumber<std::int32_t>());
+		}
+		std::uint64_t ReadLong() {
+			return ReadNumber<std::uint64_t>();
+		}
+		std::uint64_t ReadSignedLong() {
+			return static_cast<std::uint64_t>(ReadNumber<std::int64_t>());
+		}
+		double ReadDouble() {
+			return ReadNumber<double>();
+		}
+		std::uint32_t ReadChar32() {
+			std::streambuf& buffer = GetReadBuffer();
+			int byte = SkipSpaces(buffer);
+			if (byte == std::char_traits<char>::eof()) return 0;
+
+			char utf8[4] = { static_cast<char>(byte) };
+			std::size_t length = 1;
+			if (static_cast<std::uint8_t>(utf8[0]) >= 0xF0) {
+				length = 4;
+			} else if (static_cast<std::uint8_t>(utf8[0]) >= 0xE0) {
+				length = 3;
+			} else if (static_cast<std::uint8_t>(utf8[0]) >= 0x80) {
+				length = 2;
+			}
+			buffer.sbumpc();
+			ReadSize += 1 + buffer.sgetn(utf8 + 1, static_cast<std::streamsize>(length - 1));
+
+			switch (length) {
+			case 1: return utf8[0];
+			case 2: return ((utf8[0] & 0x1F) << 6) + ((utf8[1] & 0x3F) << 0);
+			case 3: return ((utf8[0] & 0x0F) << 12) + ((utf8[1] & 0x3F) << 6) + ((utf8[2] & 0x3F) << 0);
+			default: return ((utf8[0] & 0x07) << 18) + ((utf8[1] & 0x3F) << 12) + ((utf8[2] & 0x3F) << 6) + ((utf8[3] & 0x3F) << 0);
+			}
+		}
+		void ReadUtf8(std::string& utf8) {
+			ReadToken(GetReadBuffer(), utf8);
+		}
+
+		void WriteInt(std::uint32_t value) {
+			WriteNumber(value);
+		}
+		void WriteSignedInt(std::uint32_t value) {
+			WriteNumber(static_cast<std::int32_t>(value));
+		}
+		void WriteLong(std::uint64_t value) {
+			WriteNumber(value);
+		}
+		void WriteSignedLong(std::uint64_t value) {
+			WriteNumber(static_cast<std::int64_t>(value));
+		}
+		void WriteDouble(double value) {
+			WriteNumber(value);
+		}
+		void WriteChar32(std::uint32_t value) {
+			std::string utf8;
+			string::EncodeUtf8(&value, 1, utf8);
+			WriteUtf8(utf8);
+		}
+		void WriteUtf8(std::string_view utf8) {
+			WrittenSize += GetWriteBuffer().sputn(utf8.data(), static_cast<std::streamsize>(utf8.size()));
+		}
+
+		std::size_t ReadBytes(void* data, std::size_t size) {
+			const auto read = static_cast<std::size_t>(GetReadBuffer().sgetn(static_cast<char*>(data), static_cast<std::streamsize>(size)));
+			ReadSize += read;
+			return read;
+		}
+		void WriteBytes(const void* data, std::size_t size) {
+			WrittenSize += GetWriteBuffer().sputn(static_cast<const char*>(data), static_cast<std::streamsize>(size));
+		}
+		void Flush() {
+			if (WriteBuffer) {
+				WriteBuffer->pubsync();
+			}
+		}
+
+		// Returns false at the end of the stream or if the token is not a number, setting value to 0 in the latter case
+		template<typename T>
+		bool TryReadNumber(T& value) {
+			char token[MaxNumberLength];
+			const std::size_t length = ReadToken(GetReadBuffer(), token);
+			if (length == 0) return false;
+
+			value = T();
+			if (length > MaxNumberLength) return false;
+
+			const char* begin = token;
+			const char* const end = token + length;
+			if (*begin == '+') {
+				++begin;
+			}
+
+			bool isNegated = false;
+			if constexpr (std::is_unsigned_v<T>) {
+				// Like strtoul, a negative number wraps around instead of being rejected
+				if (*begin == '-') {
+					++begin;
+					isNegated = true;
+				}
+			}
+
+			T result = T();
+			const auto [ptr, ec] = std::from_chars(begin, end, result);
+			if (ec != std::errc() || ptr != end) return false;
+
+			value = isNegated ? static_cast<T>(-result) : result;
+			return true;
+		}
+		template<typename T>
+		T ReadNumber() {
+			T value = T();
+			TryReadNumber(value);
+			return value;
+		}
+		template<typename T>
+		void WriteNumber(T value) {
+			char number[std::is_floating_point_v<T> ? MaxDoubleLength : MaxNumberLength];
+			std::to_chars_result result;
+			if constexpr (std::is_floating_point_v<T>) {
+				result = std::to_chars(std::begin(number), std::end(number), value, DoubleFormat, 6); // Same precision as the default of std::ostream
+			} else {
+				result = std::to_chars(std::begin(number), std::end(number), value);
+			}
+			WrittenSize += GetWriteBuffer().sputn(number, result.ptr - number);
+		}
+
+	private:
+		std::streambuf& GetReadBuffer() {
+			if (!ReadBuffer) throw std::bad_function_call();
+			if (Tie) {
+				Tie->flush();
+			}
+			return *ReadBuffer;
+		}
+		std::streambuf& GetWriteBuffer() {
+			if (!WriteBuffer) throw std::bad_function_call();
+			return *WriteBuffer;
+		}
+
+		static bool IsSpace(int c) noexcept {
+			return c == ' ' || (c >= '\t' && c <= '\r');
+		}
+		int SkipSpaces(std::streambuf& buffer) {
+			int c = buffer.sgetc();
+			while (c != std::char_traits<char>::eof() && IsSpace(c)) {
+				c = buffer.snextc();
+				++ReadSize;
+			}
+			return c;
+		}
+		// Returns the length of the whole token, which is greater than MaxNumberLength if it did not fit
+		std::size_t ReadToken(std::streambuf& buffer, char(&token)[MaxNumberLength]) {
+			std::size_t length = 0;
+			for (int c = SkipSpaces(buffer); c != std::char_traits<char>::eof() && !IsSpace(c); c = buffer.snextc()) {
+				if (length < MaxNumberLength) {
+					token[length] = static_cast<char>(c);
+				}
+				++length;
+				++ReadSize;
+			}
+			return length;
+		}
+		void ReadToken(std::streambuf& buffer, std::string& token) {
+			for (int c = SkipSpaces(buffer); c != std::char_traits<char>::eof() && !IsSpace(c); c = buffer.snextc()) {
+				token.push_back(static_cast<char>(c));
+				++ReadSize;
+			}
+		}
+	};
+
+	struct StdinStream : Stream {
+		StdinStream() {
+			ReadBuffer = std::cin.rdbuf();
+			Tie = std::cin.tie();
+		}
+	};
+
+	struct StdoutStream : Stream {
+		StdoutStream() {
+			WriteBuffer = std::cout.rdbuf();
+			DoubleFormat = std::chars_format::fixed; // The shell switches std::cout to fixed notation before interpreting
+		}
+	};
+
+	struct FileStream : Stream {
+		std::unique_ptr<char[]> Buffer;
+		std::fstream Stream;
+
+		FileStream(const std::filesystem::path& path, std::ios_base::openmode mode)
+			: Buffer(std::make_unique<char[]>(StreamBufferSize)) {
+			// The buffer must be installed before the file is opened to take effect
+			Stream.rdbuf()->pubsetbuf(Buffer.get(), static_cast<std::streamsize>(StreamBufferSize));
+			Stream.open(path, mode);
+
+			ReadBuffer = Stream.rdbuf();
+			WriteBuffer = Stream.rdbuf();
+		}
+	};
+
+	// Owned by each interpreter through its local state table
+	struct StreamManager {
+		HandleTable<std::unique_ptr<Stream>> Streams;
+		std::uint64_t Stdin, Stdout;
+		std::uint64_t ClosedReadSize = 0, ClosedWrittenSize = 0; // Sizes of the streams already removed
+
+		StreamManager() {
+			Stdin = AddStream(std::make_unique<StdinStream>());
+			Stdout = AddStream(std::make_unique<StdoutStream>());
+		}
+
+		Stream& GetStream(std::uint64_t stream) {
+			return **Streams.Get(stream);
+		}
+		std::uint64_t AddStream(std::unique_ptr<Stream>&& stream) {
+			return Streams.Add(std::move(stream));
+		}
+		bool RemoveStream(std::uint64_t stream) {
+			if (const auto streamPtr = Streams.Get(stream)) {
+				ClosedReadSize += (*streamPtr)->ReadSize;
+				ClosedWrittenSize += (*streamPtr)->WrittenSize;
+			}
+			return Streams.Remove(stream);
+		}
+		bool IsValidStream(std::uint64_t stream) const noexcept {
+			return Streams.IsValid(stream);
+		}
+	};
+}
+
+namespace svm::detail::stdlib::io {
+	// The order must match the descriptors below
+	constexpr VirtualModule::StructureIndex VirtualStream = static_cast<VirtualModule::StructureIndex>(0);
+	constexpr VirtualModule::MappedStructureIndex VirtualString32 = static_cast<VirtualModule::MappedStructureIndex>(0);
+
+	Stream& GetStream(VirtualContext& context, const VirtualObject& stream) {
+		const auto streamHandle = FIELD(stream, StreamHandle).ToLong();
+		auto& streamManager = context.GetLocalState<StreamManager>();
+
+		Assert(streamManager.IsValidStream(streamHandle), SVM_IEC_STDLIB_IO_INVALIDSTREAM);
+		return streamManager.GetStream(streamHandle);
+	}
+
+	std::uint32_t GetStdin(VirtualContext& context) {
+		const auto result = context.PushStructure(STRUCT(VirtualStream));
+		FIELD(result, 0).SetLong(context.GetLocalState<StreamManager>().Stdin);
+		return SVM_IEC_NONE;
+	}
+	std::uint32_t GetStdout(VirtualContext& context) {
+		const auto result = context.PushStructure(STRUCT(VirtualStream));
+		FIELD(result, 0).SetLong(context.GetLocalState<StreamManager>().Stdout);
+		return SVM_IEC_NONE;
+	}
+	std::uint32_t OpenFile(VirtualContext& context, std::ios_base::openmode mode) {
+		ASSERT_BEGIN {
+			const auto path = PDREF_A(PARAM_A(0, PointerType), STRUCT(VirtualString32)->Type);
+			const auto cppPath = string::ConvertToCppString32(context, path);
+
+			const auto streamHandle = context.GetLocalState<StreamManager>().AddStream(std::make_unique<FileStream>(
+				std::filesystem::path(cppPath), mode));
+			const auto result = context.PushStructure(STRUCT(VirtualStream));
+			FIELD(result, StreamHandle).SetLong(streamHandle);
+		} ASSERT_END;
+		return SVM_IEC_NONE;
+	}
+	std::uint32_t OpenReadonlyFile(VirtualContext& context) {
+		return OpenFile(context, std::fstream::in);
+	}
+	std::uint32_t OpenWriteonlyFile(VirtualContext& context) {
+		return OpenFile(context, std::fstream::out);
+	}
+	// Block I/O moves raw bytes, which text mode would translate on some platforms
+	std::uint32_t OpenReadonlyBinaryFile(VirtualContext& context) {
+		return OpenFile(context, std::fstream::in | std::fstream::binary);
+	}
+	std::uint32_t OpenWriteonlyBinaryFile(VirtualContext& context) {
+		return OpenFile(context, std::fstream::out | std::fstream::binary);
+	}
+	std::uint32_t CloseFile(VirtualContext& context) {
+		ASSERT_BEGIN {
+			const auto stream = PARAM_A(0, STRUCT(VirtualStream)->Type);
+			const auto streamHandle = FIELD(stream, StreamHandle).ToLong();
+			auto& streamManager = context.GetLocalState<StreamManager>();
+
+			Assert(streamManager.IsValidStream(streamHandle), SVM_IEC_STDLIB_IO_INVALIDSTREAM);
+
+			auto& cppStream = static_cast<FileStream&>(streamManager.GetStream(streamHandle));
+			cppStream.Stream.close();
+			streamManager.RemoveStream(streamHandle);
+		} ASSERT_END;
+		return SVM_IEC_NONE;
+	}
+	std::uint32_t ReadInt(VirtualContext& context) {
+		ASSERT_BEGIN {
+			const auto stream = PARAM_A(0, STRUCT(VirtualStream)->Type);
+
+			auto& cppStream = GetStream(context, stream);
+			context.PushFundamental(IntObject(cppStream.ReadInt()));
+		} ASSERT_END;
+		return SVM_IEC_NONE;
+	}
+	std::uint32_t WriteInt(VirtualContext& context) {
+		ASSERT_BEGIN {
+			const auto stream = PARAM_A(0, STRUCT(VirtualStream)->Type);
+			const auto value = PARAM_A(1, IntType).ToInt();
+
+			auto& cppStream = GetStream(context, stream);
+			cppStream.WriteInt(value);
+		} ASSERT_END;
+		return SVM_IEC_NONE;
+	}
+	std::uint32_t ReadSignedInt(VirtualContext& context) {
+		ASSERT_BEGIN {
+			const auto stream = PARAM_A(0, STRUCT(VirtualStream)->Type);
+
+			auto& cppStream = GetStream(context, stream);
+			context.PushFundamental(IntObject(cppStream.ReadSignedInt()));
+		} ASSERT_END;
+		return SVM_IEC_NONE;
+	}
+	std::uint32_t WriteSignedInt(VirtualContext& context) {
+		ASSERT_BEGIN {
+			const auto stream = PARAM_A(0, STRUCT(VirtualStream)->Type);
+			const auto value = PARAM_A(1, IntType).ToInt();
+
+			auto& cppStream = GetStream(context, stream);
+			cppStream.WriteSignedInt(value);
+		} ASSERT_END;
+		return SVM_IEC_NONE;
+	}
+	std::uint32_t ReadLong(VirtualContext& context) {
+		ASSERT_BEGIN {
+			const auto stream = PARAM_A(0, STRUCT(VirtualStream)->Type);
+
+			auto& cppStream = GetStream(context, stream);
+			context.PushFundamental(LongObject(cppStream.ReadLong()));
+		} ASSERT_END;
+		return SVM_IEC_NONE;
+	}
+	std::uint32_t WriteLong(VirtualContext& context) {
+		ASSERT_BEGIN {
+			const auto stream = PARAM_A(0, STRUCT(VirtualStream)->Type);
+			const auto value = PARAM_A(1, LongType).ToLong();
+
+			auto& cppStream = GetStream(context, stream);
+			cppStream.WriteLong(value);
+		} ASSERT_END;
+		return SVM_IEC_NONE;
+	}
+	std::uint32_t ReadSignedLong(VirtualContext& context) {
+		ASSERT_BEGIN {
+			const auto stream = PARAM_A(0, STRUCT(VirtualStream)->Type);
+
+			auto& cppStream = GetStream(context, stream);
+			context.PushFundamental(LongObject(cppStream.ReadSignedLong()));
+		} ASSERT_END;
+		return SVM_IEC_NONE;
+	}
+	std::uint32_t WriteSignedLong(VirtualContext& context) {
+		ASSERT_BEGIN {
+			const auto stream = PARAM_A(0, STRUCT(VirtualStream)->Type);
+			const auto value = PARAM_A(1, LongType).ToLong();
+
+			auto& cppStream = GetStream(context, stream);
+			cppStream.WriteSignedLong(value);
+		} ASSERT_END;
+		return SVM_IEC_NONE;
+	}
+	std::uint32_t ReadDouble(VirtualContext& context) {
+		ASSERT_BEGIN {
+			const auto stream = PARAM_A(0, STRUCT(VirtualStream)->Type);
+
+			auto& cppStream = GetStream(context, stream);
+			context.PushFundamental(DoubleObject(cppStream.ReadDouble()));
+		} ASSERT_END;
+		return SVM_IEC_NONE;
+	}
+	std::uint32_t WriteDouble(VirtualContext& context) {
+		ASSERT_BEGIN {
+			const auto stream = PARAM_A(0, STRUCT(VirtualStream)->Type);
+			const auto value = PARAM_A(1, DoubleType).ToDouble();
+
+			auto& cppStream = GetStream(context, stream);
+			cppStream.WriteDouble(value);
+		} ASSERT_END;
+		return SVM_IEC_NONE;
+	}
+	std::uint32_t ReadChar32(VirtualContext& context) {
+		ASSERT_BEGIN {
+			const auto stream = PARAM_A(0, STRUCT(VirtualStream)->Type);
+
+			auto& cppStream = GetStream(context, stream);
+			context.PushFundamental(IntObject(cppStream.ReadChar32()));
+		} ASSERT_END;
+		return SVM_IEC_NONE;
+	}
+	std::uint32_t WriteChar32(VirtualContext& context) {
+		ASSERT_BEGIN {
+			const auto stream = PARAM_A(0, STRUCT(VirtualStream)->Type);
+			const auto value = PARAM_A(1, IntType).ToInt();
+
+			auto& cppStream = GetStream(context, stream);
+			cppStream.WriteChar32(value);
+		} ASSERT_END;
+		return SVM_IEC_NONE;
+	}
+	std::uint32_t ReadString32(VirtualContext& context) {
+		ASSERT_BEGIN {
+			const auto stream = PARAM_A(0, STRUCT(VirtualStream)->Type);
+
+			auto& cppStream = GetStream(context, stream);
+			cppStream.Utf8.clear();
+			cppStream.ReadUtf8(cppStream.Utf8);
+
+			const auto result = context.PushStructure(STRUCT(VirtualString32));
+			string::ConvertFromUtf8(context, cppStream.Utf8, result);
+		} ASSERT_END;
+		return SVM_IEC_NONE;
+	}
+	std::uint32_t WriteString32(VirtualContext& context) {
+		ASSERT_BEGIN {
+			const auto stream = PARAM_A(0, STRUCT(VirtualStream)->Type);
+			const auto value = PDREF_A(PARAM_A(1, PointerType), STRUCT(VirtualString32)->Type);
+
+			auto& cppStream = GetStream(context, stream);
+			cppStream.Utf8.clear();
+			string::ConvertToUtf8(context, value, cppStream.Utf8);
+			cppStream.WriteUtf8(cppStream.Utf8);
+		} ASSERT_END;
+		return SVM_IEC_NONE;
+	}
+
+	constexpr std::size_t BlockChunkSize = 8 * 1024;
+
+	template<typename T, typename R>
+	std::uint32_t ReadBlock(VirtualContext& context, Type elementType) {
+		ASSERT_BEGIN {
+			const auto stream = PARAM_A(0, STRUCT(VirtualStream)->Type);
+			const auto array = PDREF_A(PARAM_A(1, PointerType), ArrayType);
+			const auto begin = PARAM_A(2, LongType).ToLong();
+			const auto count = PARAM_A(3, LongType).ToLong();
+
+			auto& cppStream = GetStream(context, stream);
+			Assert(array.IsArray() == elementType, SVM_IEC_STDLIB_TYPEASSERTFAIL);
+			Assert(IsValidRange(begin, count, array.GetCount()), SVM_IEC_STDLIB_ARRAY_OUTOFRANGE);
+
+			T* const elements = GetElementData<T>(context, array, begin);
+
+			std::uint64_t read = 0;
+			if constexpr (std::is_same_v<T, R>) {
+				read = cppStream.ReadBytes(elements, static_cast<std::size_t>(count * sizeof(R))) / sizeof(R);
+			} else {
+				// Narrower raw values are read in chunks through the reused buffer of the stream, and then widened into the elements
+				static_assert(sizeof(R) == 1);
+				cppStream.Utf8.resize(BlockChunkSize);
+				R* const chunk = reinterpret_cast<R*>(cppStream.Utf8.data());
+				while (read < count) {
+					const auto chunkCount = static_cast<std::size_t>(std::min<std::uint64_t>(count - read, BlockChunkSize));
+					const std::size_t readCount = cppStream.ReadBytes(chunk, chunkCount * sizeof(R)) / sizeof(R);
+					std::copy(chunk, chunk + readCount, elements + read);
+
+					read += readCount;
+					if (readCount != chunkCount) break;
+				}
+			}
+			context.PushFundamental(LongObject(read));
+		} ASSERT_END;
+		return SVM_IEC_NONE;
+	}
+	template<typename T, typename R>
+	std::uint32_t WriteBlock(VirtualContext& context, Type elementType) {
+		ASSERT_BEGIN {
+			const auto stream = PARAM_A(0, STRUCT(VirtualStream)->Type);
+			const auto array = PDREF_A(PARAM_A(1, PointerType), ArrayType);
+			const auto begin = PARAM_A(2, LongType).ToLong();
+			const auto count = PARAM_A(3, LongType).ToLong();
+
+			auto& cppStream = GetStream(context, stream);
+			Assert(array.IsArray() == elementType, SVM_IEC_STDLIB_TYPEASSERTFAIL);
+			Assert(IsValidRange(begin, count, array.GetCount()), SVM_IEC_STDLIB_ARRAY_OUTOFRANGE);
+
+			const T* const elements = GetElementData<T>(context, array, begin);
+
+			if constexpr (std::is_same_v<T, R>) {
+				cppStream.WriteBytes(elements, static_cast<std::size_t>(count * sizeof(R)));
+			} else {
+				static_assert(sizeof(R) == 1);
+				cppStream.Utf8.resize(BlockChunkSize);
+				R* const chunk = reinterpret_cast<R*>(cppStream.Utf8.data());
+				for (std::uint64_t written = 0; written < count;) {
+					const auto chunkCount = static_cast<std::size_t>(std::min<std::uint64_t>(count - written, BlockChunkSize));
+					for (std::size_t i = 0; i < chunkCount; ++i) {
+						chunk[i] = static_cast<R>(elements[written + i]);
+					}
+					cppStream.WriteBytes(chunk, chunkCount * sizeof(R));
+
+					written += chunkCount;
+				}
+			}
+		} ASSERT_END;
+		return SVM_IEC_NONE;
+	}
+
+	template<typename T>
+	std::uint32_t ReadNumbers(VirtualContext& context, Type elementType) {
+		ASSERT_BEGIN {
+			const auto stream = PARAM_A(0, STRUCT(VirtualStream)->Type);
+			const auto array = PDREF_A(PARAM_A(1, PointerType), ArrayType);
+			const auto begin = PARAM_A(2, LongType).ToLong();
+			const auto count = PARAM_A(3, LongType).ToLong();
+
+			auto& cppStream = GetStream(context, stream);
+			Assert(array.IsArray() == elementType, SVM_IEC_STDLIB_TYPEASSERTFAIL);
+			Assert(IsValidRange(begin, count, array.GetCount()), SVM_IEC_STDLIB_ARRAY_OUTOFRANGE);
+
+			T* const elements = GetElementData<T>(context, array, begin);
+
+			std::uint64_t read = 0;
+			for (T value; read < count && cppStream.TryReadNumber(value); ++read) {
+				elements[read] = value;
+			}
+			context.PushFundamental(LongObject(read));
+		} ASSERT_END;
+		return SVM_IEC_NONE;
+	}
+
+	std::uint32_t ReadBytes(VirtualContext& context) {
+		return ReadBlock<std::uint32_t, std::uint8_t>(context, IntType);
+	}
+	std::uint32_t WriteBytes(VirtualContext& context) {
+		return WriteBlock<std::uint32_t, std::uint8_t>(context, IntType);
+	}
+	std::uint32_t ReadInts(VirtualContext& context) {
+		return ReadBlock<std::uint32_t, std::uint32_t>(context, IntType);
+	}
+	std::uint32_t WriteInts(VirtualContext& context) {
+		return WriteBlock<std::uint32_t, std::uint32_t>(context, IntType);
+	}
+	std::uint32_t ReadLongs(VirtualContext& context) {
+		return ReadBlock<std::uint64_t, std::uint64_t>(context, LongType);
+	}
+	std::uint32_t WriteLongs(VirtualContext& context) {
+		return WriteBlock<std::uint64_t, std::uint64_t>(context, LongType);
+	}
+	std::uint32_t ReadDoubles(VirtualContext& context) {
+		return ReadBlock<double, double>(context, DoubleType);
+	}
+	std::uint32_t WriteDoubles(VirtualContext& context) {
+		return WriteBlock<double, double>(context, DoubleType);
+	}
+	std::uint32_t ReadIntArray(VirtualContext& context) {
+		return ReadNumbers<std::uint32_t>(context, IntType);
+	}
+	std::uint32_t ReadLongArray(VirtualContext& context) {
+		return ReadNumbers<std::uint64_t>(context, LongType);
+	}
+	std::uint32_t ReadDoubleArray(VirtualContext& context) {
+		return ReadNumbers<double>(context, DoubleType);
+	}
+	std::uint32_t Flush(VirtualContext& context) {
+		ASSERT_BEGIN {
+			const auto stream = PARAM_A(0, STRUCT(VirtualStream)->Type);
+			GetStream(context, stream).Flush();
+		} ASSERT_END;
+		return SVM_IEC_NONE;
+	}
+
+	constexpr std::string_view Dependencies[] = {
+		"/std/string.sbf",
+	};
+	constexpr MappingDescriptor StructureMappings[] = {
+		{ 0, "String32" },
+	};
+
+	constexpr FieldDescriptor StreamFields[] = {
+		{ TypeCode::Long, 0 }, // _handle
+	};
+
+	constexpr StructureDescriptor Structures[] = {
+		{ "Stream", StreamFields },
+	};
+	constexpr FunctionDescriptor Functions[] = {
+		{ "getStdin", 0, true, GetStdin },
+		{ "getStdout", 0, true, GetStdout },
+		{ "openReadonlyFile", 1, true, OpenReadonlyFile },
+		{ "openWriteonlyFile", 1, true, OpenWriteonlyFile },
+		{ "closeFile", 1, false, CloseFile },
+		{ "readInt", 1, true, ReadInt },
+		{ "writeInt", 2, false, WriteInt },
+		{ "readSignedInt", 1, true, ReadSignedInt },
+		{ "writeSignedInt", 2, false, WriteSignedInt },
+		{ "readLong", 1, true, ReadLong },
+		{ "writeLong", 2, false, WriteLong },
+		{ "readSignedLong", 1, true, ReadSignedLong },
+		{ "writeSignedLong", 2, false, WriteSignedLong },
+		{ "readDouble", 1, true, ReadDouble },
+		{ "writeDouble", 2, false, WriteDouble },
+		{ "readChar32", 1, true, ReadChar32 },
+		{ "writeChar32", 2, false, WriteChar32 },
+		{ "readString32", 1, true, ReadString32 },
+		{ "writeString32", 2, false, WriteString32 },
+		{ "readBytes", 4, true, ReadBytes },
+		{ "writeBytes", 4, false, WriteBytes },
+		{ "readInts", 4, true, ReadInts },
+		{ "writeInts", 4, false, WriteInts },
+		{ "readLongs", 4, true, ReadLongs },
+		{ "writeLongs", 4, false, WriteLongs },
+		{ "readDoubles", 4, true, ReadDoubles },
+		{ "writeDoubles", 4, false, WriteDoubles },
+		{ "readIntArray", 4, true, ReadIntArray },
+		{ "readLongArray", 4, true, ReadLongArray },
+		{ "readDoubleArray", 4, true, ReadDoubleArray },
+		{ "flush", 1, false, Flush },
+		{ "openReadonlyBinaryFile", 1, true, OpenReadonlyBinaryFile },
+		{ "openWriteonlyBinaryFile", 1, true, OpenWriteonlyBinaryFile },
+	};
+}
+
+namespace svm::detail::stdlib {
+	constexpr ModuleDescriptor IOModule = {
+		"/std/io.sbf", io::Dependencies, io::StructureMappings, io::Structures, io::Functions,
+	};
+}
+
+namespace svm {
+	StdIOStatistics GetStdIOStatistics(LocalStateTable& localStates) {
+		auto* const streams = localStates.Find<detail::stdlib::io::StreamManager>();
+
+		StdIOStatistics result;
+		if (!streams) return result; // The program never used /std/io.sbf
+
+		result.ReadSize = streams->ClosedReadSize;
+		result.WrittenSize = streams->ClosedWrittenSize;
+		streams->Streams.ForEach([&result](std::unique_ptr<detail::stdlib::io::Stream>& stream) {
+			result.ReadSize += stream->ReadSize;
+			result.WrittenSize += stream->WrittenSize;
+		});
+		return result;
+	}
+}
\ No newline at end of file
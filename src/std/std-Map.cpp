@@ -0,0 +1,349 @@
+#include <svm/detail/Stdlib.hpp>
+
+#include <svm/GarbageCollector.hpp>
+#include <svm/detail/HandleTable.hpp>
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+namespace svm::detail::stdlib::map {
+	constexpr std::uint32_t MapHandle = 0;
+	constexpr std::size_t MinCapacity = 16;
+
+	// Open addressing with linear probing and backward-shift deletion.
+	// The hashes are kept apart from the entries, so that probing walks a dense array of integers.
+	template<typename K>
+	class HashTable final {
+	private:
+		struct Entry final {
+			K Key{};
+			ValueObject Value;
+		};
+
+		std::vector<std::uint64_t> m_Hashes; // 0 marks an empty slot
+		std::vector<Entry> m_Entries;
+		std::size_t m_Count = 0;
+
+	public:
+		template<typename KV>
+		ValueObject* Find(const KV& key) noexcept {
+			if (m_Count == 0) return nullptr;
+
+			const std::size_t index = FindIndex(key, Hash(key));
+			if (m_Hashes[index] == 0) return nullptr;
+			else return &m_Entries[index].Value;
+		}
+		template<typename KV>
+		void Set(const KV& key, const ValueObject& value) {
+			if (ValueObject* const existing = Find(key)) {
+				*existing = value;
+				return;
+			}
+
+			// The load factor is kept under 3/4
+			if ((m_Count + 1) * 4 > m_Hashes.size() * 3) {
+				Rehash(std::max(MinCapacity, m_Hashes.size() * 2));
+			}
+
+			const std::uint64_t hash = Hash(key);
+			const std::size_t index = FindIndex(key, hash);
+			if (m_Hashes[index] == 0) {
+				m_Hashes[index] = hash;
+				m_Entries[index].Key = K(key);
+				++m_Count;
+			}
+			m_Entries[index].Value = value;
+		}
+		template<typename KV>
+		bool Remove(const KV& key) {
+			if (m_Count == 0) return false;
+
+			std::size_t hole = FindIndex(key, Hash(key));
+			if (m_Hashes[hole] == 0) return false;
+
+			// Later entries of the same cluster are shifted back unless that would move them before their home slot
+			const std::size_t mask = m_Hashes.size() - 1;
+			for (std::size_t i = (hole + 1) & mask; m_Hashes[i] != 0; i = (i + 1) & mask) {
+				const std::size_t home = static_cast<std::size_t>(m_Hashes[i]) & mask;
+				if (((i - home) & mask) >= ((i - hole) & mask)) {
+					m_Hashes[hole] = m_Hashes[i];
+					m_Entries[hole] = std::move(m_Entries[i]);
+					hole = i;
+				}
+			}
+
+			m_Hashes[hole] = 0;
+			m_Entries[hole] = Entry();
+			--m_Count;
+			return true;
+		}
+		void Clear() noexcept {
+			m_Hashes.clear();
+			m_Entries.clear();
+			m_Count = 0;
+		}
+		std::size_t GetCount() const noexcept {
+			return m_Count;
+		}
+
+		template<typename F>
+		void ForEachValue(F&& function) {
+			for (std::size_t i = 0; i < m_Hashes.size(); ++i) {
+				if (m_Hashes[i] != 0) {
+					function(m_Entries[i].Value);
+				}
+			}
+		}
+
+	private:
+		template<typename KV>
+		std::size_t FindIndex(const KV& key, std::uint64_t hash) const noexcept {
+			const std::size_t mask = m_Hashes.size() - 1;
+			std::size_t index = static_cast<std::size_t>(hash) & mask;
+			while (m_Hashes[index] != 0 && (m_Hashes[index] != hash || m_Entries[index].Key != key)) {
+				index = (index + 1) & mask;
+			}
+			return index;
+		}
+		void Rehash(std::size_t capacity) {
+			std::vector<std::uint64_t> hashes(capacity);
+			std::vector<Entry> entries(capacity);
+			const std::size_t mask = capacity - 1;
+
+			for (std::size_t i = 0; i < m_Hashes.size(); ++i) {
+				if (m_Hashes[i] == 0) continue;
+
+				std::size_t index = static_cast<std::size_t>(m_Hashes[i]) & mask;
+				while (hashes[index] != 0) {
+					index = (index + 1) & mask;
+				}
+				hashes[index] = m_Hashes[i];
+				entries[index] = std::move(m_Entries[i]);
+			}
+
+			m_Hashes = std::move(hashes);
+			m_Entries = std::move(entries);
+		}
+
+		static std::uint64_t Hash(std::uint64_t key) noexcept {
+			// Finalizer of SplitMix64, so that sequential keys do not form clusters
+			key = (key ^ (key >> 30)) * 0xBF58476D1CE4E5B9;
+			key = (key ^ (key >> 27)) * 0x94D049BB133111EB;
+			key ^= key >> 31;
+			return key != 0 ? key : 1;
+		}
+		static std::uint64_t Hash(std::u32string_view key) noexcept {
+			return Hash(static_cast<std::uint64_t>(std::hash<std::u32string_view>()(key)));
+		}
+	};
+
+	enum class KeyKind {
+		Int,
+		Long,
+		String,
+	};
+
+	struct Map final {
+		KeyKind Kind;
+		HashTable<std::uint64_t> IntegerTable;
+		HashTable<std::u32string> StringTable;
+	};
+
+	// Owned by each interpreter through its local state table
+	struct MapManager final : GCRootProvider {
+		HandleTable<Map> Maps;
+
+		Map& GetMap(std::uint64_t map) {
+			return *Maps.Get(map);
+		}
+		std::uint64_t AddMap(Map&& map) {
+			return Maps.Add(std::move(map));
+		}
+		bool RemoveMap(std::uint64_t map) {
+			return Maps.Remove(map);
+		}
+		bool IsValidMap(std::uint64_t map) const noexcept {
+			return Maps.IsValid(map);
+		}
+
+		void VisitGCRoots(const std::function<void(Type*)>& visitor) override {
+			const auto visitValue = [&visitor](ValueObject& value) {
+				if (value.ValueType == GCPointerType) {
+					visitor(&value.ValueType);
+				}
+			};
+
+			Maps.ForEach([&visitValue](Map& map) {
+				map.IntegerTable.ForEachValue(visitValue);
+				map.StringTable.ForEachValue(visitValue);
+			});
+		}
+	};
+}
+
+namespace svm::detail::stdlib::map {
+	// The order must match the descriptors below
+	constexpr VirtualModule::StructureIndex VirtualMap = static_cast<VirtualModule::StructureIndex>(0);
+	constexpr VirtualModule::MappedStructureIndex VirtualString32 = static_cast<VirtualModule::MappedStructureIndex>(0);
+
+	Map& GetMap(VirtualContext& context, const VirtualObject& map) {
+		const auto mapHandle = FIELD(map, MapHandle).ToLong();
+		auto& mapManager = context.GetLocalState<MapManager>();
+
+		Assert(mapManager.IsValidMap(mapHandle), SVM_IEC_STDLIB_MAP_INVALIDMAP);
+		return mapManager.GetMap(mapHandle);
+	}
+	template<typename F>
+	void VisitKey(VirtualContext& context, Map& map, const VirtualObject& key, F&& function) {
+		switch (map.Kind) {
+		case KeyKind::Int:
+			function(map.IntegerTable, static_cast<std::uint64_t>(Assert(key, IntType).ToInt()));
+			break;
+
+		case KeyKind::Long:
+			function(map.IntegerTable, Assert(key, LongType).ToLong());
+			break;
+
+		case KeyKind::String: {
+			// String keys are looked up without copying the characters of the String32
+			const auto string = PDREF_A(Assert(key, PointerType), STRUCT(VirtualString32)->Type);
+			const auto length = static_cast<std::size_t>(FIELD(string, string::StringLength).ToLong());
+			const auto data = reinterpret_cast<const char32_t*>(string::GetData32(context, string));
+			function(map.StringTable, std::u32string_view(data, length));
+			break;
+		}
+		}
+	}
+
+	void Create(VirtualContext& context, KeyKind kind) {
+		Map map;
+		map.Kind = kind;
+
+		const auto mapHandle = context.GetLocalState<MapManager>().AddMap(std::move(map));
+		const auto result = context.PushStructure(STRUCT(VirtualMap));
+		FIELD(result, MapHandle).SetLong(mapHandle);
+	}
+	std::uint32_t CreateInt(VirtualContext& context) {
+		Create(context, KeyKind::Int);
+		return SVM_IEC_NONE;
+	}
+	std::uint32_t CreateLong(VirtualContext& context) {
+		Create(context, KeyKind::Long);
+		return SVM_IEC_NONE;
+	}
+	std::uint32_t CreateString(VirtualContext& context) {
+		Create(context, KeyKind::String);
+		return SVM_IEC_NONE;
+	}
+	std::uint32_t Destroy(VirtualContext& context) {
+		ASSERT_BEGIN {
+			const auto map = PARAM_A(0, STRUCT(VirtualMap)->Type);
+			const auto mapHandle = FIELD(map, MapHandle).ToLong();
+
+			Assert(context.GetLocalState<MapManager>().RemoveMap(mapHandle), SVM_IEC_STDLIB_MAP_INVALIDMAP);
+		} ASSERT_END;
+		return SVM_IEC_NONE;
+	}
+
+	std::uint32_t Set(VirtualContext& context) {
+		ASSERT_BEGIN {
+			const auto map = PARAM_A(0, STRUCT(VirtualMap)->Type);
+			const auto value = ToValueObject(PARAM(2));
+
+			VisitKey(context, GetMap(context, map), PARAM(1), [&](auto& table, const auto& key) {
+				table.Set(key, value);
+			});
+		} ASSERT_END;
+		return SVM_IEC_NONE;
+	}
+	std::uint32_t Get(VirtualContext& context) {
+		ASSERT_BEGIN {
+			const auto map = PARAM_A(0, STRUCT(VirtualMap)->Type);
+
+			VisitKey(context, GetMap(context, map), PARAM(1), [&](auto& table, const auto& key) {
+				const ValueObject* const value = table.Find(key);
+				Assert(value != nullptr, SVM_IEC_STDLIB_MAP_KEYNOTFOUND);
+				PushValueObject(context, *value);
+			});
+		} ASSERT_END;
+		return SVM_IEC_NONE;
+	}
+	std::uint32_t Contains(VirtualContext& context) {
+		ASSERT_BEGIN {
+			const auto map = PARAM_A(0, STRUCT(VirtualMap)->Type);
+
+			VisitKey(context, GetMap(context, map), PARAM(1), [&](auto& table, const auto& key) {
+				context.PushFundamental(IntObject(table.Find(key) != nullptr));
+			});
+		} ASSERT_END;
+		return SVM_IEC_NONE;
+	}
+	std::uint32_t Remove(VirtualContext& context) {
+		ASSERT_BEGIN {
+			const auto map = PARAM_A(0, STRUCT(VirtualMap)->Type);
+
+			VisitKey(context, GetMap(context, map), PARAM(1), [&](auto& table, const auto& key) {
+				context.PushFundamental(IntObject(table.Remove(key)));
+			});
+		} ASSERT_END;
+		return SVM_IEC_NONE;
+	}
+	std::uint32_t GetSize(VirtualContext& context) {
+		ASSERT_BEGIN {
+			const auto map = PARAM_A(0, STRUCT(VirtualMap)->Type);
+			const Map& cppMap = GetMap(context, map);
+
+			context.PushFundamental(LongObject(cppMap.IntegerTable.GetCount() + cppMap.StringTable.GetCount()));
+		} ASSERT_END;
+		return SVM_IEC_NONE;
+	}
+	std::uint32_t Clear(VirtualContext& context) {
+		ASSERT_BEGIN {
+			const auto map = PARAM_A(0, STRUCT(VirtualMap)->Type);
+			Map& cppMap = GetMap(context, map);
+
+			cppMap.IntegerTable.Clear();
+			cppMap.StringTable.Clear();
+		} ASSERT_END;
+		return SVM_IEC_NONE;
+	}
+
+	constexpr std::string_view Dependencies[] = {
+		"/std/string.sbf",
+	};
+	constexpr MappingDescriptor StructureMappings[] = {
+		{ 0, "String32" },
+	};
+
+	constexpr FieldDescriptor MapFields[] = {
+		{ TypeCode::Long, 0 }, // _handle
+	};
+
+	constexpr StructureDescriptor Structures[] = {
+		{ "Map", MapFields },
+	};
+	constexpr FunctionDescriptor Functions[] = {
+		{ "createInt", 0, true, CreateInt },
+		{ "createLong", 0, true, CreateLong },
+		{ "createString", 0, true, CreateString },
+		{ "destroy", 1, false, Destroy },
+		{ "set", 3, false, Set },
+		{ "get", 2, true, Get },
+		{ "contains", 2, true, Contains },
+		{ "remove", 2, true, Remove },
+		{ "getSize", 1, true, GetSize },
+		{ "clear", 1, false, Clear },
+	};
+}
+
+namespace svm::detail::stdlib {
+	constexpr ModuleDescriptor MapModule = {
+		"/std/map.sbf", map::Dependencies, map::StructureMappings, map::Structures, map::Functions,
+	};
+}
\ No newline at end of file
@@ -0,0 +1,340 @@
+#include <svm/detail/Stdlib.hpp>
+
+#include <svm/Macro.hpp>
+#include <svm/detail/HandleTable.hpp>
+
+#include <cstring>
+#include <filesystem>
+#include <memory>
+#include <type_traits>
+#include <utility>
+
+#ifdef SVM_WINDOWS
+#	define NOMINMAX
+#	include <Windows.h>
+#else
+#	include <fcntl.h>
+#	include <sys/mman.h>
+#	include <sys/stat.h>
+#	include <unistd.h>
+#endif
+
+namespace svm::detail::stdlib::mmap {
+	constexpr std::uint32_t MappingHandle = 0;
+
+	class MappedFile final {
+	private:
+		void* m_Data = nullptr;
+		std::size_t m_Size = 0;
+		bool m_IsWriteable = false;
+
+#ifdef SVM_WINDOWS
+		HANDLE m_File = INVALID_HANDLE_VALUE;
+		HANDLE m_Mapping = nullptr;
+#else
+		int m_File = -1;
+#endif
+
+	public:
+		MappedFile(const std::filesystem::path& path, bool isWriteable)
+			: m_IsWriteable(isWriteable) {
+			if (!Map(path)) {
+				Unmap();
+				throw SVM_IEC_STDLIB_MMAP_FAILED;
+			}
+		}
+		MappedFile(const MappedFile&) = delete;
+		~MappedFile() {
+			Unmap();
+		}
+
+	public:
+		MappedFile& operator=(const MappedFile&) = delete;
+
+	public:
+		std::uint8_t* GetData() const noexcept {
+			return static_cast<std::uint8_t*>(m_Data);
+		}
+		std::size_t GetSize() const noexcept {
+			return m_Size;
+		}
+		bool IsWriteable() const noexcept {
+			return m_IsWriteable;
+		}
+
+#ifdef SVM_WINDOWS
+		void Flush() noexcept {
+			if (!m_Data || !m_IsWriteable) return;
+
+			FlushViewOfFile(m_Data, 0);
+			FlushFileBuffers(m_File);
+		}
+
+	private:
+		bool Map(const std::filesystem::path& path) noexcept {
+			m_File = CreateFileW(path.c_str(), GENERIC_READ | (m_IsWriteable ? GENERIC_WRITE : 0),
+				FILE_SHARE_READ | FILE_SHARE_WRITE, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+			if (m_File == INVALID_HANDLE_VALUE) return false;
+
+			LARGE_INTEGER size;
+			if (!GetFileSizeEx(m_File, &size)) return false;
+			else if ((m_Size = static_cast<std::size_t>(size.QuadPart)) == 0) return true;
+
+			m_Mapping = CreateFileMappingW(m_File, nullptr, m_IsWriteable ? PAGE_READWRITE : PAGE_READONLY, 0, 0, nullptr);
+			if (!m_Mapping) return false;
+
+			m_Data = MapViewOfFile(m_Mapping, m_IsWriteable ? FILE_MAP_WRITE : FILE_MAP_READ, 0, 0, 0);
+			return m_Data != nullptr;
+		}
+		void Unmap() noexcept {
+			if (m_Data) {
+				UnmapViewOfFile(m_Data);
+				m_Data = nullptr;
+			}
+			if (m_Mapping) {
+				CloseHandle(m_Mapping);
+				m_Mapping = nullptr;
+			}
+			if (m_File != INVALID_HANDLE_VALUE) {
+				CloseHandle(m_File);
+				m_File = INVALID_HANDLE_VALUE;
+			}
+		}
+#else
+		void Flush() noexcept {
+			if (!m_Data || !m_IsWriteable) return;
+
+			msync(m_Data, m_Size, MS_SYNC);
+		}
+
+	private:
+		bool Map(const std::filesystem::path& path) noexcept {
+			m_File = open(path.c_str(), m_IsWriteable ? O_RDWR : O_RDONLY);
+			if (m_File == -1) return false;
+
+			struct stat status;
+			if (fstat(m_File, &status) == -1) return false;
+			else if ((m_Size = static_cast<std::size_t>(status.st_size)) == 0) return true;
+
+			void* const data = ::mmap(nullptr, m_Size, PROT_READ | (m_IsWriteable ? PROT_WRITE : 0), MAP_SHARED, m_File, 0);
+			if (data == MAP_FAILED) return false;
+
+			m_Data = data;
+			return true;
+		}
+		void Unmap() noexcept {
+			if (m_Data) {
+				munmap(m_Data, m_Size);
+				m_Data = nullptr;
+			}
+			if (m_File != -1) {
+				close(m_File);
+				m_File = -1;
+			}
+		}
+#endif
+	};
+
+	// Owned by each interpreter through its local state table
+	struct MappingManager {
+		HandleTable<std::unique_ptr<MappedFile>> Mappings;
+
+		MappedFile& GetMapping(std::uint64_t mapping) {
+			return **Mappings.Get(mapping);
+		}
+		std::uint64_t AddMapping(std::unique_ptr<MappedFile>&& mapping) {
+			return Mappings.Add(std::move(mapping));
+		}
+		bool RemoveMapping(std::uint64_t mapping) {
+			return Mappings.Remove(mapping);
+		}
+		bool IsValidMapping(std::uint64_t mapping) const noexcept {
+			return Mappings.IsValid(mapping);
+		}
+	};
+}
+
+namespace svm::detail::stdlib::mmap {
+	// The order must match the descriptors below
+	constexpr VirtualModule::StructureIndex VirtualMapping = static_cast<VirtualModule::StructureIndex>(0);
+	constexpr VirtualModule::MappedStructureIndex VirtualString32 = static_cast<VirtualModule::MappedStructureIndex>(0);
+
+	MappedFile& GetMapping(VirtualContext& context, const VirtualObject& mapping) {
+		const auto mappingHandle = FIELD(mapping, MappingHandle).ToLong();
+		auto& mappingManager = context.GetLocalState<MappingManager>();
+
+		Assert(mappingManager.IsValidMapping(mappingHandle), SVM_IEC_STDLIB_MMAP_INVALIDMAPPING);
+		return mappingManager.GetMapping(mappingHandle);
+	}
+	std::uint32_t OpenMapping(VirtualContext& context, bool isWriteable) {
+		ASSERT_BEGIN {
+			const auto path = PDREF_A(PARAM(0), STRUCT(VirtualString32)->Type);
+			const auto cppPath = string::ConvertToCppString32(context, path);
+
+			const auto mappingHandle = context.GetLocalState<MappingManager>().AddMapping(std::make_unique<MappedFile>(
+				std::filesystem::path(cppPath), isWriteable));
+			const auto result = context.PushStructure(STRUCT(VirtualMapping));
+			FIELD(result, MappingHandle).SetLong(mappingHandle);
+		} ASSERT_END;
+		return SVM_IEC_NONE;
+	}
+
+	std::uint32_t OpenReadonly(VirtualContext& context) {
+		return OpenMapping(context, false);
+	}
+	std::uint32_t OpenReadWrite(VirtualContext& context) {
+		return OpenMapping(context, true);
+	}
+	std::uint32_t Close(VirtualContext& context) {
+		ASSERT_BEGIN {
+			const auto mapping = PARAM_A(0, STRUCT(VirtualMapping)->Type);
+			const auto mappingHandle = FIELD(mapping, MappingHandle).ToLong();
+
+			Assert(context.GetLocalState<MappingManager>().RemoveMapping(mappingHandle), SVM_IEC_STDLIB_MMAP_INVALIDMAPPING);
+		} ASSERT_END;
+		return SVM_IEC_NONE;
+	}
+	std::uint32_t Flush(VirtualContext& context) {
+		ASSERT_BEGIN {
+			const auto mapping = PARAM_A(0, STRUCT(VirtualMapping)->Type);
+			GetMapping(context, mapping).Flush();
+		} ASSERT_END;
+		return SVM_IEC_NONE;
+	}
+	std::uint32_t GetSize(VirtualContext& context) {
+		ASSERT_BEGIN {
+			const auto mapping = PARAM_A(0, STRUCT(VirtualMapping)->Type);
+			context.PushFundamental(LongObject(GetMapping(context, mapping).GetSize()));
+		} ASSERT_END;
+		return SVM_IEC_NONE;
+	}
+
+	template<typename O, typename R>
+	std::uint32_t GetValue(VirtualContext& context) {
+		ASSERT_BEGIN {
+			const auto mapping = PARAM_A(0, STRUCT(VirtualMapping)->Type);
+			const auto index = PARAM(1).ToLong();
+
+			const MappedFile& cppMapping = GetMapping(context, mapping);
+			Assert(index < cppMapping.GetSize() / sizeof(R), SVM_IEC_STDLIB_MMAP_OUTOFRANGE);
+
+			R value;
+			std::memcpy(&value, cppMapping.GetData() + index * sizeof(R), sizeof(R));
+			context.PushFundamental(O(value));
+		} ASSERT_END;
+		return SVM_IEC_NONE;
+	}
+	template<typename R>
+	std::uint32_t SetValue(VirtualContext& context) {
+		ASSERT_BEGIN {
+			const auto mapping = PARAM_A(0, STRUCT(VirtualMapping)->Type);
+			const auto index = PARAM(1).ToLong();
+			const auto value = PARAM(2);
+
+			const MappedFile& cppMapping = GetMapping(context, mapping);
+			Assert(cppMapping.IsWriteable(), SVM_IEC_STDLIB_MMAP_READONLY);
+			Assert(index < cppMapping.GetSize() / sizeof(R), SVM_IEC_STDLIB_MMAP_OUTOFRANGE);
+
+			R cppValue;
+			if constexpr (std::is_same_v<R, std::uint32_t>) {
+				cppValue = value.ToInt();
+			} else if constexpr (std::is_same_v<R, std::uint64_t>) {
+				cppValue = value.ToLong();
+			} else {
+				cppValue = value.ToDouble();
+			}
+			std::memcpy(cppMapping.GetData() + index * sizeof(R), &cppValue, sizeof(R));
+		} ASSERT_END;
+		return SVM_IEC_NONE;
+	}
+	template<typename R>
+	std::uint32_t ReadBlock(VirtualContext& context, Type elementType) {
+		ASSERT_BEGIN {
+			const auto mapping = PARAM_A(0, STRUCT(VirtualMapping)->Type);
+			const auto index = PARAM(1).ToLong();
+			const auto array = PDREF_A(PARAM(2), ArrayType);
+			const auto begin = PARAM(3).ToLong();
+			const auto count = PARAM(4).ToLong();
+
+			const MappedFile& cppMapping = GetMapping(context, mapping);
+			Assert(array.IsArray() == elementType, SVM_IEC_STDLIB_TYPEASSERTFAIL);
+			Assert(IsValidRange(begin, count, array.GetCount()), SVM_IEC_STDLIB_ARRAY_OUTOFRANGE);
+			Assert(IsValidRange(index, count, cppMapping.GetSize() / sizeof(R)), SVM_IEC_STDLIB_MMAP_OUTOFRANGE);
+
+			std::memcpy(GetElementData<R>(context, array, begin), cppMapping.GetData() + index * sizeof(R), static_cast<std::size_t>(count * sizeof(R)));
+		} ASSERT_END;
+		return SVM_IEC_NONE;
+	}
+
+	std::uint32_t GetInt(VirtualContext& context) {
+		return GetValue<IntObject, std::uint32_t>(context);
+	}
+	std::uint32_t GetLong(VirtualContext& context) {
+		return GetValue<LongObject, std::uint64_t>(context);
+	}
+	std::uint32_t GetDouble(VirtualContext& context) {
+		return GetValue<DoubleObject, double>(context);
+	}
+	std::uint32_t SetInt(VirtualContext& context) {
+		return SetValue<std::uint32_t>(context);
+	}
+	std::uint32_t SetLong(VirtualContext& context) {
+		return SetValue<std::uint64_t>(context);
+	}
+	std::uint32_t SetDouble(VirtualContext& context) {
+		return SetValue<double>(context);
+	}
+	std::uint32_t ReadInts(VirtualContext& context) {
+		return ReadBlock<std::uint32_t>(context, IntType);
+	}
+	std::uint32_t ReadLongs(VirtualContext& context) {
+		return ReadBlock<std::uint64_t>(context, LongType);
+	}
+	std::uint32_t ReadDoubles(VirtualContext& context) {
+		return ReadBlock<double>(context, DoubleType);
+	}
+
+	constexpr std::string_view Dependencies[] = {
+		"/std/string.sbf",
+	};
+	constexpr MappingDescriptor StructureMappings[] = {
+		{ 0, "String32" },
+	};
+
+	constexpr FieldDescriptor MappingFields[] = {
+		{ TypeCode::Long, 0 }, // _handle
+	};
+
+	constexpr StructureDescriptor Structures[] = {
+		{ "Mapping", MappingFields },
+	};
+	constexpr TypeCode OpenParameters[] = { TypeCode::Pointer };
+	constexpr TypeCode GetParameters[] = { TypeCode::None, TypeCode::Long }; // mapping, index
+	constexpr TypeCode SetIntParameters[] = { TypeCode::None, TypeCode::Long, TypeCode::Int };
+	constexpr TypeCode SetLongParameters[] = { TypeCode::None, TypeCode::Long, TypeCode::Long };
+	constexpr TypeCode SetDoubleParameters[] = { TypeCode::None, TypeCode::Long, TypeCode::Double };
+	constexpr TypeCode ReadParameters[] = { TypeCode::None, TypeCode::Long, TypeCode::Pointer, TypeCode::Long, TypeCode::Long };
+
+	constexpr FunctionDescriptor Functions[] = {
+		{ "openReadonly", 1, true, OpenReadonly, OpenParameters },
+		{ "openReadWrite", 1, true, OpenReadWrite, OpenParameters },
+		{ "close", 1, false, Close },
+		{ "flush", 1, false, Flush },
+		{ "getSize", 1, true, GetSize },
+		{ "getInt", 2, true, GetInt, GetParameters },
+		{ "getLong", 2, true, GetLong, GetParameters },
+		{ "getDouble", 2, true, GetDouble, GetParameters },
+		{ "setInt", 3, false, SetInt, SetIntParameters },
+		{ "setLong", 3, false, SetLong, SetLongParameters },
+		{ "setDouble", 3, false, SetDouble, SetDoubleParameters },
+		{ "readInts", 5, false, ReadInts, ReadParameters },
+		{ "readLongs", 5, false, ReadLongs, ReadParameters },
+		{ "readDoubles", 5, false, ReadDoubles, ReadParameters },
+	};
+}
+
+namespace svm::detail::stdlib {
+	constexpr ModuleDescriptor MmapModule = {
+		"/std/mmap.sbf", mmap::Dependencies, mmap::StructureMappings, mmap::Structures, mmap::Functions,
+	};
+}
\ No newline at end of file
@@ -0,0 +1,467 @@
+#include <svm/detail/Stdlib.hpp>
+
+#include <svm/Macro.hpp>
+
+#include <algorithm>
+#include <cstring>
+#include <functional>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+#ifdef SVM_SSE2
+#	include <emmintrin.h>
+#endif
+#ifdef SVM_MSVC
+#	include <intrin.h>
+#endif
+
+namespace svm::detail::stdlib::string {
+	void Expand32(VirtualContext& context, const VirtualObject& string, std::uint64_t required) {
+		auto capacity = FIELD(string, StringCapacity).ToLong();
+		if (required <= capacity) return;
+
+		// The script chooses the capacity, so the byte size of the array is checked before it reaches the allocator
+		Assert(CalcPackedArraySize(IntType, required) != 0, SVM_IEC_STDLIB_OUTOFMEMORY);
+		if (capacity == 0) {
+			capacity = required;
+		} else {
+			do {
+				capacity <<= 1; // Doubling
+			} while (required > capacity);
+		}
+		if (CalcPackedArraySize(IntType, capacity) == 0) {
+			capacity = required;
+		}
+
+		// The data array is grown in place when the allocator can, instead of being copied into a new one
+		// The capacity is only updated once the array really has that many elements
+		const auto data = FIELD(string, StringData);
+		if (data.ToPointer() == VPNULL) {
+			const auto array = context.NewFundamental(IntObject(), capacity);
+			Assert(!(array == VNULL), SVM_IEC_STDLIB_OUTOFMEMORY);
+			data.SetPointer(PREF(array));
+		} else {
+			Assert(context.ReallocateFundamental(data, capacity), SVM_IEC_STDLIB_OUTOFMEMORY);
+		}
+		FIELD(string, StringCapacity).SetLong(capacity);
+	}
+
+	std::uint32_t* GetData32(VirtualContext& context, const VirtualObject& string) {
+		const auto data = FIELD(string, StringData);
+		if (data.ToPointer() == VPNULL) return nullptr;
+
+		return GetElementData<std::uint32_t>(context, PDREF(data), 0);
+	}
+
+	void Append32(VirtualContext& context, const VirtualObject& string, const VirtualObject& src, std::uint64_t begin, std::uint64_t count) {
+		if (count == 0) return;
+
+		const auto length = FIELD(string, StringLength).ToLong();
+		Expand32(context, string, length + count);
+
+		// Expanding may have moved the source if both are the same string
+		std::memmove(GetData32(context, string) + length, GetData32(context, src) + begin, static_cast<std::size_t>(count * sizeof(std::uint32_t)));
+		FIELD(string, StringLength).SetLong(length + count);
+	}
+	void Assign32(VirtualContext& context, const VirtualObject& string, const std::uint32_t* data, std::uint64_t count) {
+		Expand32(context, string, count);
+		if (count != 0) {
+			std::memcpy(GetData32(context, string), data, static_cast<std::size_t>(count * sizeof(std::uint32_t)));
+		}
+		FIELD(string, StringLength).SetLong(count);
+	}
+
+	constexpr std::size_t NotFound = static_cast<std::size_t>(-1);
+
+	unsigned CountTrailingZeros(std::uint32_t value) noexcept {
+#ifdef SVM_MSVC
+		unsigned long index;
+		_BitScanForward(&index, value);
+		return static_cast<unsigned>(index);
+#else
+		return static_cast<unsigned>(__builtin_ctz(value));
+#endif
+	}
+	std::size_t FindChar32(const std::uint32_t* data, std::size_t length, std::uint32_t character) noexcept {
+		std::size_t i = 0;
+#ifdef SVM_SSE2
+		const __m128i pattern = _mm_set1_epi32(static_cast<int>(character));
+		for (; i + 4 <= length; i += 4) {
+			const __m128i block = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + i));
+			const int mask = _mm_movemask_epi8(_mm_cmpeq_epi32(block, pattern));
+			if (mask != 0) return i + CountTrailingZeros(static_cast<std::uint32_t>(mask)) / 4;
+		}
+#endif
+		for (; i < length; ++i) {
+			if (data[i] == character) return i;
+		}
+		return length;
+	}
+	std::size_t Mismatch32(const std::uint32_t* lhs, const std::uint32_t* rhs, std::size_t length) noexcept {
+		std::size_t i = 0;
+#ifdef SVM_SSE2
+		for (; i + 4 <= length; i += 4) {
+			const __m128i lhsBlock = _mm_loadu_si128(reinterpret_cast<const __m128i*>(lhs + i));
+			const __m128i rhsBlock = _mm_loadu_si128(reinterpret_cast<const __m128i*>(rhs + i));
+			const int mask = _mm_movemask_epi8(_mm_cmpeq_epi32(lhsBlock, rhsBlock));
+			if (mask != 0xFFFF) return i + CountTrailingZeros(static_cast<std::uint32_t>(~mask & 0xFFFF)) / 4;
+		}
+#endif
+		for (; i < length; ++i) {
+			if (lhs[i] != rhs[i]) return i;
+		}
+		return length;
+	}
+	std::size_t Find32(const std::uint32_t* data, std::size_t length, const std::uint32_t* pattern, std::size_t patternLength, std::size_t begin) noexcept {
+		if (begin > length || patternLength > length - begin) return NotFound;
+		else if (patternLength == 0) return begin;
+
+		// Candidates are located by their first character, then checked as a whole
+		const std::size_t last = length - patternLength;
+		for (std::size_t i = begin; i <= last; ++i) {
+			i += FindChar32(data + i, last - i + 1, pattern[0]);
+			if (i > last) break;
+			else if (Mismatch32(data + i + 1, pattern + 1, patternLength - 1) == patternLength - 1) return i;
+		}
+		return NotFound;
+	}
+
+	std::u32string ConvertToCppString32(VirtualContext& context, const VirtualObject& string) {
+		const auto length = static_cast<std::size_t>(FIELD(string, StringLength).ToLong());
+		const std::uint32_t* const data = GetData32(context, string);
+
+		std::u32string result(length, 0);
+		if (length != 0) {
+			std::memcpy(result.data(), data, length * sizeof(char32_t));
+		}
+		return result;
+	}
+	void ConvertFromCppString32(VirtualContext& context, const std::u32string& cppString, const VirtualObject& string) {
+		const auto size = static_cast<std::uint64_t>(cppString.size());
+		Expand32(context, string, size);
+		FIELD(string, StringLength).SetLong(size);
+
+		if (size != 0) {
+			std::memcpy(GetData32(context, string), cppString.data(), cppString.size() * sizeof(char32_t));
+		}
+	}
+
+	std::size_t DecodeUtf8(const char* src, std::size_t size, std::uint32_t* dest) noexcept {
+		const auto bytes = reinterpret_cast<const std::uint8_t*>(src);
+		std::size_t i = 0, length = 0;
+		while (i < size) {
+			// Runs of ASCII are detected a block at a time and widened without any branch per character
+#ifdef SVM_SSE2
+			while (size - i >= 16) {
+				const __m128i block = _mm_loadu_si128(reinterpret_cast<const __m128i*>(bytes + i));
+				if (_mm_movemask_epi8(block) != 0) break;
+
+				const __m128i zero = _mm_setzero_si128();
+				const __m128i low = _mm_unpacklo_epi8(block, zero);
+				const __m128i high = _mm_unpackhi_epi8(block, zero);
+				__m128i* const out = reinterpret_cast<__m128i*>(dest + length);
+				_mm_storeu_si128(out, _mm_unpacklo_epi16(low, zero));
+				_mm_storeu_si128(out + 1, _mm_unpackhi_epi16(low, zero));
+				_mm_storeu_si128(out + 2, _mm_unpacklo_epi16(high, zero));
+				_mm_storeu_si128(out + 3, _mm_unpackhi_epi16(high, zero));
+				i += 16;
+				length += 16;
+			}
+#else
+			while (size - i >= 8) {
+				std::uint64_t block;
+				std::memcpy(&block, bytes + i, sizeof(block));
+				if ((block & 0x8080808080808080) != 0) break;
+
+				for (std::size_t j = 0; j < 8; ++j) {
+					dest[length + j] = bytes[i + j];
+				}
+				i += 8;
+				length += 8;
+			}
+#endif
+			if (i == size) break;
+
+			const std::uint8_t lead = bytes[i];
+			if (lead < 0x80) {
+				dest[length++] = lead;
+				++i;
+				continue;
+			}
+
+			std::size_t count = 0;
+			std::uint32_t codePoint = 0, minCodePoint = 0;
+			if ((lead & 0xE0) == 0xC0) {
+				count = 2;
+				codePoint = lead & 0x1F;
+				minCodePoint = 0x80;
+			} else if ((lead & 0xF0) == 0xE0) {
+				count = 3;
+				codePoint = lead & 0x0F;
+				minCodePoint = 0x800;
+			} else if ((lead & 0xF8) == 0xF0) {
+				count = 4;
+				codePoint = lead & 0x07;
+				minCodePoint = 0x10000;
+			}
+
+			bool isValid = count != 0 && size - i >= count;
+			for (std::size_t j = 1; isValid && j < count; ++j) {
+				if ((bytes[i + j] & 0xC0) != 0x80) {
+					isValid = false;
+				} else {
+					codePoint = codePoint << 6 | (bytes[i + j] & 0x3F);
+				}
+			}
+			isValid = isValid && codePoint >= minCodePoint && codePoint <= 0x10FFFF && (codePoint < 0xD800 || codePoint > 0xDFFF);
+
+			if (isValid) {
+				dest[length++] = codePoint;
+				i += count;
+			} else {
+				dest[length++] = ReplacementCharacter;
+				++i;
+			}
+		}
+		return length;
+	}
+	void EncodeUtf8(const std::uint32_t* src, std::size_t count, std::string& dest) {
+		const std::size_t begin = dest.size();
+		dest.resize(begin + count * 4);
+
+		auto out = reinterpret_cast<std::uint8_t*>(dest.data() + begin);
+		for (std::size_t i = 0; i < count; ++i) {
+			std::uint32_t codePoint = src[i];
+			if (codePoint < 0x80) {
+				*out++ = static_cast<std::uint8_t>(codePoint);
+				continue;
+			} else if (codePoint > 0x10FFFF || (codePoint >= 0xD800 && codePoint <= 0xDFFF)) {
+				codePoint = ReplacementCharacter;
+			}
+
+			if (codePoint < 0x800) {
+				*out++ = static_cast<std::uint8_t>(0xC0 | codePoint >> 6);
+			} else if (codePoint < 0x10000) {
+				*out++ = static_cast<std::uint8_t>(0xE0 | codePoint >> 12);
+				*out++ = static_cast<std::uint8_t>(0x80 | (codePoint >> 6 & 0x3F));
+			} else {
+				*out++ = static_cast<std::uint8_t>(0xF0 | codePoint >> 18);
+				*out++ = static_cast<std::uint8_t>(0x80 | (codePoint >> 12 & 0x3F));
+				*out++ = static_cast<std::uint8_t>(0x80 | (codePoint >> 6 & 0x3F));
+			}
+			*out++ = static_cast<std::uint8_t>(0x80 | (codePoint & 0x3F));
+		}
+		dest.resize(static_cast<std::size_t>(out - reinterpret_cast<std::uint8_t*>(dest.data())));
+	}
+	void ConvertFromUtf8(VirtualContext& context, std::string_view utf8, const VirtualObject& string) {
+		// A UTF-8 string never has more characters than bytes
+		Expand32(context, string, utf8.size());
+
+		const std::size_t length = utf8.empty() ? 0 : DecodeUtf8(utf8.data(), utf8.size(), GetData32(context, string));
+		FIELD(string, StringLength).SetLong(length);
+	}
+	void ConvertToUtf8(VirtualContext& context, const VirtualObject& string, std::string& utf8) {
+		const auto length = static_cast<std::size_t>(FIELD(string, StringLength).ToLong());
+		if (length == 0) return;
+
+		EncodeUtf8(GetData32(context, string), length, utf8);
+	}
+}
+
+namespace svm::detail::stdlib::string {
+	std::uint32_t Create32(VirtualContext& context) {
+		const auto result = context.PushStructure(STRUCT(VirtualString32));
+		FIELD(result, StringData).SetPointer(VPNULL);
+		FIELD(result, StringLength).SetLong(0);
+		FIELD(result, StringCapacity).SetLong(0);
+		return SVM_IEC_NONE;
+	}
+	std::uint32_t Push(VirtualContext& context) {
+		ASSERT_BEGIN {
+			const auto string = PDREF_A(PARAM(0), STRUCT(VirtualString32)->Type);
+			const auto stringLength = FIELD(string, StringLength).ToLong();
+			const auto value = PARAM(1).ToInt();
+
+			Expand32(context, string, stringLength + 1);
+			ITEM(PDREF(FIELD(string, StringData)), stringLength).SetInt(value);
+			FIELD(string, StringLength).SetLong(stringLength + 1);
+		} ASSERT_END;
+		return SVM_IEC_NONE;
+	}
+	std::uint32_t Concat(VirtualContext& context) {
+		ASSERT_BEGIN {
+			const auto dest = PDREF_A(PARAM(0), STRUCT(VirtualString32)->Type);
+			const auto src = PDREF_A(PARAM(1), STRUCT(VirtualString32)->Type);
+
+			Append32(context, dest, src, 0, FIELD(src, StringLength).ToLong());
+		} ASSERT_END;
+		return SVM_IEC_NONE;
+	}
+	std::uint32_t Reserve(VirtualContext& context) {
+		ASSERT_BEGIN {
+			const auto string = PDREF_A(PARAM(0), STRUCT(VirtualString32)->Type);
+			const auto capacity = PARAM(1).ToLong();
+
+			Expand32(context, string, capacity);
+		} ASSERT_END;
+		return SVM_IEC_NONE;
+	}
+	std::uint32_t AppendSlice(VirtualContext& context) {
+		ASSERT_BEGIN {
+			const auto dest = PDREF_A(PARAM(0), STRUCT(VirtualString32)->Type);
+			const auto src = PDREF_A(PARAM(1), STRUCT(VirtualString32)->Type);
+			const auto begin = PARAM(2).ToLong();
+			const auto count = PARAM(3).ToLong();
+
+			Assert(IsValidRange(begin, count, FIELD(src, StringLength).ToLong()), SVM_IEC_STDLIB_ARRAY_OUTOFRANGE);
+			Append32(context, dest, src, begin, count);
+		} ASSERT_END;
+		return SVM_IEC_NONE;
+	}
+	std::uint32_t Substring(VirtualContext& context) {
+		ASSERT_BEGIN {
+			const auto string = PDREF_A(PARAM(0), STRUCT(VirtualString32)->Type);
+			const auto begin = PARAM(1).ToLong();
+			const auto count = PARAM(2).ToLong();
+
+			Assert(IsValidRange(begin, count, FIELD(string, StringLength).ToLong()), SVM_IEC_STDLIB_ARRAY_OUTOFRANGE);
+
+			const auto result = context.PushStructure(STRUCT(VirtualString32));
+			FIELD(result, StringData).SetPointer(VPNULL);
+			FIELD(result, StringLength).SetLong(0);
+			FIELD(result, StringCapacity).SetLong(0);
+			if (count != 0) {
+				Assign32(context, result, GetData32(context, string) + begin, count);
+			}
+		} ASSERT_END;
+		return SVM_IEC_NONE;
+	}
+	std::uint32_t Find(VirtualContext& context) {
+		ASSERT_BEGIN {
+			const auto string = PDREF_A(PARAM(0), STRUCT(VirtualString32)->Type);
+			const auto pattern = PDREF_A(PARAM(1), STRUCT(VirtualString32)->Type);
+			const auto begin = PARAM(2).ToLong();
+
+			const std::size_t result = Find32(
+				GetData32(context, string), static_cast<std::size_t>(FIELD(string, StringLength).ToLong()),
+				GetData32(context, pattern), static_cast<std::size_t>(FIELD(pattern, StringLength).ToLong()),
+				static_cast<std::size_t>(begin));
+			context.PushFundamental(LongObject(result == NotFound ? static_cast<std::uint64_t>(-1) : result));
+		} ASSERT_END;
+		return SVM_IEC_NONE;
+	}
+	std::uint32_t Compare(VirtualContext& context) {
+		ASSERT_BEGIN {
+			const auto lhs = PDREF_A(PARAM(0), STRUCT(VirtualString32)->Type);
+			const auto lhsLength = static_cast<std::size_t>(FIELD(lhs, StringLength).ToLong());
+			const auto rhs = PDREF_A(PARAM(1), STRUCT(VirtualString32)->Type);
+			const auto rhsLength = static_cast<std::size_t>(FIELD(rhs, StringLength).ToLong());
+
+			// Code points are compared in order, and a prefix comes before the longer string
+			const std::uint32_t* const lhsData = GetData32(context, lhs);
+			const std::uint32_t* const rhsData = GetData32(context, rhs);
+			const std::size_t length = std::min(lhsLength, rhsLength);
+			const std::size_t index = length == 0 ? 0 : Mismatch32(lhsData, rhsData, length);
+
+			std::int32_t result = 0;
+			if (index != length) {
+				result = lhsData[index] > rhsData[index] ? 1 : -1;
+			} else if (lhsLength != rhsLength) {
+				result = lhsLength > rhsLength ? 1 : -1;
+			}
+			PushOrdering(context, result);
+		} ASSERT_END;
+		return SVM_IEC_NONE;
+	}
+	std::uint32_t Hash(VirtualContext& context) {
+		ASSERT_BEGIN {
+			const auto string = PDREF_A(PARAM(0), STRUCT(VirtualString32)->Type);
+			const auto length = static_cast<std::size_t>(FIELD(string, StringLength).ToLong());
+
+			const std::u32string_view view(reinterpret_cast<const char32_t*>(GetData32(context, string)), length);
+			context.PushFundamental(LongObject(static_cast<std::uint64_t>(std::hash<std::u32string_view>()(view))));
+		} ASSERT_END;
+		return SVM_IEC_NONE;
+	}
+	std::uint32_t Split(VirtualContext& context) {
+		ASSERT_BEGIN {
+			const auto string = PDREF_A(PARAM(0), STRUCT(VirtualString32)->Type);
+			const auto length = static_cast<std::size_t>(FIELD(string, StringLength).ToLong());
+			const auto separator = PARAM(1).ToInt();
+
+			const std::uint32_t* data = GetData32(context, string);
+			std::vector<std::pair<std::size_t, std::size_t>> pieces;
+			for (std::size_t begin = 0;;) {
+				const std::size_t end = length == 0 ? 0 : begin + FindChar32(data + begin, length - begin, separator);
+				pieces.emplace_back(begin, end - begin);
+				if (end == length) break;
+
+				begin = end + 1;
+			}
+
+			// The pieces are returned as a new array of String32, each of which must be destroyed
+			const auto result = context.NewStructure(STRUCT(VirtualString32), pieces.size());
+			for (std::size_t i = 0; i < pieces.size(); ++i) {
+				const auto piece = ITEM(result, i);
+				FIELD(piece, StringData).SetPointer(VPNULL);
+				FIELD(piece, StringLength).SetLong(0);
+				FIELD(piece, StringCapacity).SetLong(0);
+				if (pieces[i].second != 0) {
+					Assign32(context, piece, GetData32(context, string) + pieces[i].first, pieces[i].second);
+				}
+			}
+			context.PushFundamental(PointerObject(reinterpret_cast<void*>(static_cast<std::uintptr_t>(PREF(result)))));
+		} ASSERT_END;
+		return SVM_IEC_NONE;
+	}
+	std::uint32_t Destroy(VirtualContext& context) {
+		ASSERT_BEGIN {
+			const auto string = PDREF_A(PARAM(0), STRUCT(VirtualString32)->Type);
+			const auto data = FIELD(string, StringData);
+			if (data.ToPointer() != VPNULL) {
+				context.DeleteObject(data);
+			}
+		} ASSERT_END;
+		return SVM_IEC_NONE;
+	}
+
+	constexpr FieldDescriptor String32Fields[] = {
+		{ TypeCode::Pointer, 0 }, // data
+		{ TypeCode::Long, 0 }, // length
+		{ TypeCode::Long, 0 }, // capacity
+	};
+
+	// The order must match VirtualString32
+	constexpr StructureDescriptor Structures[] = {
+		{ "String32", String32Fields },
+	};
+	constexpr TypeCode StringParameters[] = { TypeCode::Pointer };
+	constexpr TypeCode StringIntParameters[] = { TypeCode::Pointer, TypeCode::Int };
+	constexpr TypeCode StringLongParameters[] = { TypeCode::Pointer, TypeCode::Long };
+	constexpr TypeCode StringsParameters[] = { TypeCode::Pointer, TypeCode::Pointer };
+	constexpr TypeCode SliceParameters[] = { TypeCode::Pointer, TypeCode::Long, TypeCode::Long }; // string, begin, count
+	constexpr TypeCode AppendSliceParameters[] = { TypeCode::Pointer, TypeCode::Pointer, TypeCode::Long, TypeCode::Long };
+	constexpr TypeCode FindParameters[] = { TypeCode::Pointer, TypeCode::Pointer, TypeCode::Long };
+
+	constexpr FunctionDescriptor Functions[] = {
+		{ "create32", 0, true, Create32 },
+		{ "push", 2, false, Push, StringIntParameters },
+		{ "concat", 2, false, Concat, StringsParameters },
+		{ "destroy", 1, false, Destroy, StringParameters },
+		{ "reserve", 2, false, Reserve, StringLongParameters },
+		{ "appendSlice", 4, false, AppendSlice, AppendSliceParameters },
+		{ "substring", 3, true, Substring, SliceParameters },
+		{ "find", 3, true, Find, FindParameters },
+		{ "compare", 2, true, Compare, StringsParameters },
+		{ "hash", 1, true, Hash, StringParameters },
+		{ "split", 2, true, Split, StringIntParameters },
+	};
+}
+
+namespace svm::detail::stdlib {
+	constexpr ModuleDescriptor StringModule = {
+		"/std/string.sbf", {}, {}, string::Structures, string::Functions,
+	};
+}
\ No newline at end of file
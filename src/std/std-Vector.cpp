@@ -0,0 +1,181 @@
+#include <svm/detail/Stdlib.hpp>
+
+#include <svm/GarbageCollector.hpp>
+#include <svm/detail/HandleTable.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <new>
+#include <utility>
+#include <vector>
+
+namespace svm::detail::stdlib::vector {
+	constexpr std::uint32_t VectorHandle = 0;
+
+	// Owned by each interpreter through its local state table
+	struct VectorManager final : GCRootProvider {
+		HandleTable<std::vector<ValueObject>> Vectors;
+
+		std::vector<ValueObject>& GetVector(std::uint64_t vector) {
+			return *Vectors.Get(vector);
+		}
+		std::uint64_t AddVector(std::vector<ValueObject>&& vector) {
+			return Vectors.Add(std::move(vector));
+		}
+		bool RemoveVector(std::uint64_t vector) {
+			return Vectors.Remove(vector);
+		}
+		bool IsValidVector(std::uint64_t vector) const noexcept {
+			return Vectors.IsValid(vector);
+		}
+
+		void VisitGCRoots(const std::function<void(Type*)>& visitor) override {
+			Vectors.ForEach([&visitor](std::vector<ValueObject>& vector) {
+				for (ValueObject& value : vector) {
+					if (value.ValueType == GCPointerType) {
+						visitor(&value.ValueType);
+					}
+				}
+			});
+		}
+	};
+}
+
+namespace svm::detail::stdlib::vector {
+	// The order must match the descriptors below
+	constexpr VirtualModule::StructureIndex VirtualVector = static_cast<VirtualModule::StructureIndex>(0);
+
+	std::vector<ValueObject>& GetVector(VirtualContext& context, const VirtualObject& vector) {
+		const auto vectorHandle = FIELD(vector, VectorHandle).ToLong();
+		auto& vectorManager = context.GetLocalState<VectorManager>();
+
+		Assert(vectorManager.IsValidVector(vectorHandle), SVM_IEC_STDLIB_VECTOR_INVALIDVECTOR);
+		return vectorManager.GetVector(vectorHandle);
+	}
+
+	std::uint32_t Create(VirtualContext& context) {
+		const auto vectorHandle = context.GetLocalState<VectorManager>().AddVector({});
+		const auto result = context.PushStructure(STRUCT(VirtualVector));
+		FIELD(result, VectorHandle).SetLong(vectorHandle);
+		return SVM_IEC_NONE;
+	}
+	std::uint32_t Destroy(VirtualContext& context) {
+		ASSERT_BEGIN {
+			const auto vector = PARAM_A(0, STRUCT(VirtualVector)->Type);
+			const auto vectorHandle = FIELD(vector, VectorHandle).ToLong();
+
+			Assert(context.GetLocalState<VectorManager>().RemoveVector(vectorHandle), SVM_IEC_STDLIB_VECTOR_INVALIDVECTOR);
+		} ASSERT_END;
+		return SVM_IEC_NONE;
+	}
+
+	std::uint32_t Push(VirtualContext& context) {
+		ASSERT_BEGIN {
+			const auto vector = PARAM_A(0, STRUCT(VirtualVector)->Type);
+			const auto value = ToValueObject(PARAM(1));
+
+			auto& cppVector = GetVector(context, vector);
+
+			try {
+				cppVector.push_back(value);
+			} catch (const std::bad_alloc&) {
+				throw SVM_IEC_STDLIB_OUTOFMEMORY;
+			}
+		} ASSERT_END;
+		return SVM_IEC_NONE;
+	}
+	std::uint32_t Pop(VirtualContext& context) {
+		ASSERT_BEGIN {
+			const auto vector = PARAM_A(0, STRUCT(VirtualVector)->Type);
+			auto& cppVector = GetVector(context, vector);
+
+			Assert(!cppVector.empty(), SVM_IEC_STDLIB_VECTOR_OUTOFRANGE);
+			const ValueObject value = cppVector.back();
+			cppVector.pop_back();
+			PushValueObject(context, value);
+		} ASSERT_END;
+		return SVM_IEC_NONE;
+	}
+	std::uint32_t Get(VirtualContext& context) {
+		ASSERT_BEGIN {
+			const auto vector = PARAM_A(0, STRUCT(VirtualVector)->Type);
+			const auto index = PARAM(1).ToLong();
+			const auto& cppVector = GetVector(context, vector);
+
+			Assert(index < cppVector.size(), SVM_IEC_STDLIB_VECTOR_OUTOFRANGE);
+			PushValueObject(context, cppVector[static_cast<std::size_t>(index)]);
+		} ASSERT_END;
+		return SVM_IEC_NONE;
+	}
+	std::uint32_t Set(VirtualContext& context) {
+		ASSERT_BEGIN {
+			const auto vector = PARAM_A(0, STRUCT(VirtualVector)->Type);
+			const auto index = PARAM(1).ToLong();
+			const auto value = ToValueObject(PARAM(2));
+			auto& cppVector = GetVector(context, vector);
+
+			Assert(index < cppVector.size(), SVM_IEC_STDLIB_VECTOR_OUTOFRANGE);
+			cppVector[static_cast<std::size_t>(index)] = value;
+		} ASSERT_END;
+		return SVM_IEC_NONE;
+	}
+	std::uint32_t GetSize(VirtualContext& context) {
+		ASSERT_BEGIN {
+			const auto vector = PARAM_A(0, STRUCT(VirtualVector)->Type);
+			context.PushFundamental(LongObject(GetVector(context, vector).size()));
+		} ASSERT_END;
+		return SVM_IEC_NONE;
+	}
+	std::uint32_t Reserve(VirtualContext& context) {
+		ASSERT_BEGIN {
+			const auto vector = PARAM_A(0, STRUCT(VirtualVector)->Type);
+			const auto capacity = PARAM(1).ToLong();
+
+			auto& cppVector = GetVector(context, vector);
+
+			Assert(capacity <= cppVector.max_size(), SVM_IEC_STDLIB_OUTOFMEMORY);
+			try {
+				cppVector.reserve(static_cast<std::size_t>(capacity));
+			} catch (const std::bad_alloc&) {
+				throw SVM_IEC_STDLIB_OUTOFMEMORY;
+			}
+		} ASSERT_END;
+		return SVM_IEC_NONE;
+	}
+	std::uint32_t Clear(VirtualContext& context) {
+		ASSERT_BEGIN {
+			const auto vector = PARAM_A(0, STRUCT(VirtualVector)->Type);
+			GetVector(context, vector).clear();
+		} ASSERT_END;
+		return SVM_IEC_NONE;
+	}
+
+	constexpr FieldDescriptor VectorFields[] = {
+		{ TypeCode::Long, 0 }, // _handle
+	};
+
+	constexpr StructureDescriptor Structures[] = {
+		{ "Vector", VectorFields },
+	};
+	constexpr TypeCode IndexParameters[] = { TypeCode::None, TypeCode::Long }; // vector, index or capacity
+	constexpr TypeCode SetParameters[] = { TypeCode::None, TypeCode::Long, TypeCode::None };
+
+	constexpr FunctionDescriptor Functions[] = {
+		{ "create", 0, true, Create },
+		{ "destroy", 1, false, Destroy },
+		{ "push", 2, false, Push },
+		{ "pop", 1, true, Pop },
+		{ "get", 2, true, Get, IndexParameters },
+		{ "set", 3, false, Set, SetParameters },
+		{ "getSize", 1, true, GetSize },
+		{ "reserve", 2, false, Reserve, IndexParameters },
+		{ "clear", 1, false, Clear },
+	};
+}
+
+namespace svm::detail::stdlib {
+	constexpr ModuleDescriptor VectorModule = {
+		"/std/vector.sbf", {}, {}, vector::Structures, vector::Functions,
+	};
+}
\ No newline at end of file
@@ -3,6 +3,7 @@
 #include <svm/Heap.hpp>
 #include <svm/Interpreter.hpp>
 #include <svm/Object.hpp>
+#include <svm/detail/PackedArray.hpp>
 
 #include <cassert>
 #include <cstddef>
@@ -11,10 +12,18 @@
 namespace svm {
 	VirtualContext::VirtualContext(Interpreter& interpreter, VirtualStack& stack, Heap& heap) noexcept
 		: m_Interpreter(interpreter), m_Stack(stack), m_Heap(heap) {}
+	VirtualContext::~VirtualContext() {
+		if (m_IsPinning) {
+			m_Heap.UnpinManagedHeap();
+		}
+	}
 
 	void VirtualContext::OccurException(std::uint32_t code) noexcept {
 		m_Interpreter.OccurException(code);
 	}
+	LocalStateTable& VirtualContext::GetLocalStates() noexcept {
+		return m_Interpreter.GetLocalStates();
+	}
 
 	Structure VirtualContext::GetStructure(VirtualModule::StructureIndex structure) {
 		return m_Interpreter.GetStructure(static_cast<TypeCode>(
@@ -27,6 +36,14 @@ namespace svm {
 			+ m_Interpreter.GetStructureCountWithoutMappings()
 			+ static_cast<std::uint32_t>(TypeCode::Structure)));
 	}
+	Structure VirtualContext::GetStructure(Type type) {
+		assert(type.IsStructure());
+
+		return m_Interpreter.GetStructure(type);
+	}
+	std::uint32_t VirtualContext::GetStructureCount() const noexcept {
+		return m_Interpreter.GetStructureCountWithoutMappings();
+	}
 
 	VirtualObject VirtualContext::GetField(const VirtualObject& structure, std::uint32_t index) {
 		const Type type = structure.IsStructure();
@@ -40,6 +57,12 @@ namespace svm {
 		const Type type = array.IsArray();
 		assert(type != nullptr);
 
+		if (detail::IsPackedElementType(type)) {
+			ArrayObject* const arrayPtr = static_cast<ArrayObject*>(array.GetObjectPtr());
+			return static_cast<Object*>(detail::MakePackedPointer(
+				static_cast<std::uint8_t*>(detail::GetPackedElements(arrayPtr)) + index * detail::GetPackedElementSize(type), type));
+		}
+
 		return reinterpret_cast<Object*>(
 			reinterpret_cast<std::uint8_t*>(static_cast<ArrayObject*>(array.GetObjectPtr()) + 1)
 			+ index * type->Size);
@@ -61,6 +84,7 @@ namespace svm {
 			return top;
 		} else {
 			const auto size = m_Interpreter.CalcArraySize(type, count);
+			if (size == 0) return VNULL;
 			if (!m_Stack.Expand(size)) return VNULL;
 
 			VirtualObject top = m_Stack.GetTop();
@@ -79,6 +103,7 @@ namespace svm {
 			return top;
 		} else {
 			const auto size = m_Interpreter.CalcArraySize(structure->Type, count);
+			if (size == 0) return VNULL;
 			if (!m_Stack.Expand(size)) return VNULL;
 
 			VirtualObject top = m_Stack.GetTop();
@@ -113,6 +138,7 @@ namespace svm {
 			}
 		} else {
 			const auto size = m_Interpreter.CalcArraySize(type, count);
+			if (size == 0) return VNULL;
 			if (void* const addr = m_Heap.AllocateUnmanagedHeap(size); addr) {
 				InitFundamental(addr, type, count);
 				return static_cast<Object*>(addr);
@@ -134,6 +160,7 @@ namespace svm {
 			}
 		} else {
 			const auto size = m_Interpreter.CalcArraySize(type, count);
+			if (size == 0) return VNULL;
 			if (const auto addr = static_cast<ManagedHeapInfo*>(m_Heap.AllocateManagedHeap(m_Interpreter, size)); addr) {
 				InitFundamental(addr + 1, type, count);
 				return addr;
@@ -154,6 +181,7 @@ namespace svm {
 			}
 		} else {
 			const auto size = m_Interpreter.CalcArraySize(structure->Type, count);
+			if (size == 0) return VNULL;
 			if (void* const addr = m_Heap.AllocateUnmanagedHeap(size); addr) {
 				InitStructure(addr, structure, count);
 				return static_cast<Object*>(addr);
@@ -175,6 +203,7 @@ namespace svm {
 			}
 		} else {
 			const auto size = m_Interpreter.CalcArraySize(structure->Type, count);
+			if (size == 0) return VNULL;
 			if (const auto addr = static_cast<ManagedHeapInfo*>(
 				m_Heap.AllocateManagedHeap(m_Interpreter, size)); addr) {
 				InitStructure(addr + 1, structure, count);
@@ -184,6 +213,32 @@ namespace svm {
 			}
 		}
 	}
+	bool VirtualContext::ReallocateFundamental(const VirtualObject& object, std::uint64_t count) {
+		assert(object.IsPointer());
+		assert(count != 0);
+
+		void* const address = reinterpret_cast<void*>(static_cast<std::uintptr_t>(object.ToPointer()));
+		const std::uint64_t oldCount = static_cast<ArrayObject*>(address)->Count;
+		const Type type = *reinterpret_cast<const Type*>(static_cast<ArrayObject*>(address) + 1);
+		assert(type.IsFundamentalType());
+
+		const std::size_t size = m_Interpreter.CalcArraySize(type, count);
+		if (size == 0) return false;
+
+		void* const newAddress = m_Heap.ReallocateUnmanagedHeap(address, size);
+		if (!newAddress) return false;
+
+		ArrayObject* const array = static_cast<ArrayObject*>(newAddress);
+		array->Count = count;
+		if (!detail::IsPackedElementType(type)) {
+			for (std::uint64_t i = oldCount; i < count; ++i) {
+				*reinterpret_cast<Type*>(reinterpret_cast<std::uint8_t*>(array + 1) + i * type->Size) = type;
+			}
+		}
+
+		object.SetPointer(static_cast<VirtualObject::PointerTarget>(reinterpret_cast<std::uintptr_t>(newAddress)));
+		return true;
+	}
 	void VirtualContext::DeleteObject(const VirtualObject& object) {
 		assert(object.IsPointer());
 
@@ -192,10 +247,16 @@ namespace svm {
 	}
 
 	void VirtualContext::CopyObject(const VirtualObject& dest, const VirtualObject& src) {
-		if (src.GetType().IsFundamentalType()) {
-			assert(dest.GetType() == src.GetType());
+		if (const Type type = src.GetType(); type.IsFundamentalType()) {
+			assert(dest.GetType() == type);
 
-			std::memcpy(dest.GetObjectPtr(), src.GetObjectPtr(), src.GetType()->Size);
+			Object* const destPtr = dest.GetObjectPtr();
+			Object* const srcPtr = src.GetObjectPtr();
+			if (detail::IsPackedPointer(destPtr) || detail::IsPackedPointer(srcPtr)) {
+				std::memcpy(GetValuePtr(destPtr), GetValuePtr(srcPtr), detail::GetPackedElementSize(type));
+			} else {
+				std::memcpy(destPtr, srcPtr, type->Size);
+			}
 		} else if (const Type structure = src.IsStructure(); structure != nullptr) {
 			assert(dest.GetType() == structure);
 
@@ -210,12 +271,31 @@ namespace svm {
 		}
 	}
 	void VirtualContext::CopyObjectUnsafe(VirtualObject::PointerTarget dest, VirtualObject::PointerTarget src, std::uint64_t count) {
+		const void* const srcPtr = reinterpret_cast<void*>(static_cast<std::uintptr_t>(src));
+		if (detail::IsPackedPointer(srcPtr)) {
+			std::memcpy(
+				detail::GetPackedPointerAddress(reinterpret_cast<void*>(static_cast<std::uintptr_t>(dest))),
+				detail::GetPackedPointerAddress(srcPtr),
+				static_cast<std::size_t>(detail::GetPackedElementSize(detail::GetPackedPointerType(srcPtr)) * count));
+			return;
+		}
+
 		std::memcpy(
 			reinterpret_cast<void*>(static_cast<std::uintptr_t>(dest)),
 			reinterpret_cast<void*>(static_cast<std::uintptr_t>(src)),
 			static_cast<std::size_t>(reinterpret_cast<Object*>(static_cast<std::uintptr_t>(src))->GetType()->Size * count));
 	}
 
+	void VirtualContext::PinManagedHeap() noexcept {
+		if (m_IsPinning) return;
+
+		m_Heap.PinManagedHeap();
+		m_IsPinning = true;
+	}
+	void* VirtualContext::GetValuePtr(Object* object) noexcept {
+		if (detail::IsPackedPointer(object)) return detail::GetPackedPointerAddress(object);
+		else return reinterpret_cast<Type*>(object) + 1;
+	}
 	void VirtualContext::InitFundamental(void* target, const Object& object, const Type& type) {
 		if (type == IntType) {
 			*static_cast<IntObject*>(target) = static_cast<const IntObject&>(object);
@@ -1,16 +1,22 @@
 #include <svm/virtual/VirtualFunction.hpp>
 
+#include <utility>
+
 namespace svm {
+	VirtualFunctionInfo::VirtualFunctionInfo(std::string name, std::uint16_t arity, bool hasResult, NativeFunction function, std::vector<Type> parameters) noexcept
+		: core::VirtualFunctionInfo(std::move(name), arity, hasResult), m_Function(function), m_Parameters(std::move(parameters)) {}
+	VirtualFunctionInfo::VirtualFunctionInfo(std::string name, std::uint16_t arity, bool hasResult, SvmNativeFunction function, std::vector<Type> parameters) noexcept
+		: core::VirtualFunctionInfo(std::move(name), arity, hasResult), m_ExtensionFunction(function), m_Parameters(std::move(parameters)) {}
 	VirtualFunctionInfo::VirtualFunctionInfo(VirtualFunctionInfo&& functionInfo) noexcept
-		: core::VirtualFunctionInfo(std::move(functionInfo)), m_Function(std::move(functionInfo.m_Function)) {}
+		: core::VirtualFunctionInfo(std::move(functionInfo)), m_Function(functionInfo.m_Function), m_ExtensionFunction(functionInfo.m_ExtensionFunction),
+		m_Parameters(std::move(functionInfo.m_Parameters)) {}
 
 	VirtualFunctionInfo& VirtualFunctionInfo::operator=(VirtualFunctionInfo&& functionInfo) noexcept {
 		core::VirtualFunctionInfo::operator=(std::move(functionInfo));
 
-		m_Function = std::move(functionInfo.m_Function);
+		m_Function = functionInfo.m_Function;
+		m_ExtensionFunction = functionInfo.m_ExtensionFunction;
+		m_Parameters = std::move(functionInfo.m_Parameters);
 		return *this;
 	}
-	void VirtualFunctionInfo::operator()(VirtualContext& context) const {
-		m_Function(context);
-	}
 }
\ No newline at end of file
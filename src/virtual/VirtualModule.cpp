@@ -25,4 +25,10 @@ namespace svm {
 
 		return static_cast<StructureIndex>(index);
 	}
+	void VirtualModule::AddFunction(std::string name, std::uint16_t arity, bool hasResult, NativeFunction function, std::vector<Type> parameters) {
+		GetFunctions().emplace_back(std::move(name), arity, hasResult, function, std::move(parameters));
+	}
+	void VirtualModule::AddFunction(std::string name, std::uint16_t arity, bool hasResult, SvmNativeFunction function, std::vector<Type> parameters) {
+		GetFunctions().emplace_back(std::move(name), arity, hasResult, function, std::move(parameters));
+	}
 }
\ No newline at end of file
@@ -1,5 +1,7 @@
 #include <svm/virtual/VirtualObject.hpp>
 
+#include <svm/detail/PackedArray.hpp>
+
 #include <cassert>
 
 namespace svm {
@@ -31,7 +33,10 @@ namespace svm {
 
 	Type VirtualObject::GetType() const noexcept {
 		if (std::holds_alternative<std::monostate>(m_Object)) return NoneType;
-		else return GetObjectPtr()->GetType();
+
+		const Object* const object = GetObjectPtr();
+		if (detail::IsPackedPointer(object)) return detail::GetPackedPointerType(object);
+		else return object->GetType();
 	}
 	bool VirtualObject::IsEmpty() const noexcept {
 		return GetType() == NoneType;
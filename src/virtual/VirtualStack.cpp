@@ -3,6 +3,7 @@
 #include <svm/Interpreter.hpp>
 #include <svm/Object.hpp>
 #include <svm/Stack.hpp>
+#include <svm/detail/PackedArray.hpp>
 
 #include <cstddef>
 #include <cstring>
@@ -29,9 +30,12 @@ namespace svm {
 
 		if (type.IsArray()) {
 			ArrayObject* const array = reinterpret_cast<ArrayObject*>(typePtr);
-			Object* const firstElement = static_cast<Object*>(array + 1);
-			const std::size_t size = static_cast<std::size_t>(array->Count * firstElement->GetType()->Size + sizeof(ArrayObject));
-			m_Stack->Reduce(size);
+			const Type elementType = static_cast<Object*>(array + 1)->GetType();
+			if (detail::IsPackedElementType(elementType)) {
+				m_Stack->Reduce(detail::CalcPackedArraySize(elementType, array->Count));
+			} else {
+				m_Stack->Reduce(static_cast<std::size_t>(array->Count * elementType->Size + sizeof(ArrayObject)));
+			}
 		} else {
 			m_Stack->Reduce(type->Size);
 		}
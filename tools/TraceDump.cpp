@@ -0,0 +1,173 @@
+#include <svm/Profiler.hpp>
+#include <svm/Tracer.hpp>
+
+#include <algorithm>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <exception>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <map>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+namespace {
+	void PrintFunction(std::ostream& stream, const svm::TraceRecord& record) {
+		stream << record.Module << ':';
+		if (record.Function == 0) {
+			stream << "entrypoint";
+		} else {
+			stream << '[' << record.Function - 1 << ']';
+		}
+	}
+	void PrintTopValue(std::ostream& stream, const svm::TraceRecord& record) {
+		if (!record.TopTypeCode) {
+			stream << "<empty>";
+			return;
+		}
+
+		switch (static_cast<svm::TypeCode>(*record.TopTypeCode)) {
+		case svm::TypeCode::Int:
+			stream << "int " << static_cast<std::int32_t>(static_cast<std::uint32_t>(record.TopValue));
+			break;
+
+		case svm::TypeCode::Long:
+			stream << "long " << static_cast<std::int64_t>(record.TopValue);
+			break;
+
+		case svm::TypeCode::Single: {
+			const auto bits = static_cast<std::uint32_t>(record.TopValue);
+			float value;
+			std::memcpy(&value, &bits, sizeof(value));
+			stream << "single " << value;
+			break;
+		}
+
+		case svm::TypeCode::Double: {
+			double value;
+			std::memcpy(&value, &record.TopValue, sizeof(value));
+			stream << "double " << value;
+			break;
+		}
+
+		case svm::TypeCode::Pointer:
+		case svm::TypeCode::GCPointer:
+			stream << (static_cast<svm::TypeCode>(*record.TopTypeCode) == svm::TypeCode::Pointer ? "pointer 0x" : "gcpointer 0x")
+				   << std::hex << record.TopValue << std::dec;
+			break;
+
+		case svm::TypeCode::Array:
+			stream << "array";
+			break;
+
+		default:
+			stream << "type(" << *record.TopTypeCode << ')';
+			break;
+		}
+	}
+
+	void Dump(std::ostream& stream, svm::TraceReader& reader) {
+		svm::TraceRecord record;
+		std::uint64_t count = 0;
+		while (reader.Read(record)) {
+			const char* const mnemonic = svm::Profiler::GetMnemonic(record.OpCode);
+
+			stream << std::setw(12) << count++ << "  ";
+			PrintFunction(stream, record);
+			stream << '(' << record.Index << ")  ";
+			if (mnemonic) {
+				stream << mnemonic;
+			} else {
+				stream << "<" << static_cast<int>(record.OpCode) << '>';
+			}
+			if (reader.HasTopValues()) {
+				stream << "  ; ";
+				PrintTopValue(stream, record);
+			}
+			stream << '\n';
+		}
+	}
+	void Summarize(std::ostream& stream, svm::TraceReader& reader) {
+		std::map<std::uint8_t, std::uint64_t> opCodes;
+		std::map<std::pair<std::uint32_t, std::uint32_t>, std::uint64_t> functions;
+
+		svm::TraceRecord record;
+		std::uint64_t count = 0;
+		while (reader.Read(record)) {
+			++opCodes[static_cast<std::uint8_t>(record.OpCode)];
+			++functions[{ record.Module, record.Function }];
+			++count;
+		}
+
+		stream << "Instructions: " << count << "\n\nOpcodes:\n";
+		std::vector<std::pair<std::uint8_t, std::uint64_t>> sortedOpCodes(opCodes.begin(), opCodes.end());
+		std::sort(sortedOpCodes.begin(), sortedOpCodes.end(), [](const auto& lhs, const auto& rhs) {
+			return lhs.second > rhs.second;
+		});
+		for (const auto& [opCode, opCodeCount] : sortedOpCodes) {
+			const char* const mnemonic = svm::Profiler::GetMnemonic(static_cast<svm::OpCode>(opCode));
+			stream << std::left << std::setw(12) << (mnemonic ? mnemonic : "<unknown>") << std::right << std::setw(16) << opCodeCount << '\n';
+		}
+
+		stream << "\nFunctions:\n";
+		std::vector<std::pair<std::pair<std::uint32_t, std::uint32_t>, std::uint64_t>> sortedFunctions(functions.begin(), functions.end());
+		std::sort(sortedFunctions.begin(), sortedFunctions.end(), [](const auto& lhs, const auto& rhs) {
+			return lhs.second > rhs.second;
+		});
+		for (const auto& [function, functionCount] : sortedFunctions) {
+			svm::TraceRecord key;
+			key.Module = function.first;
+			key.Function = function.second;
+
+			stream << std::setw(16) << functionCount << "  ";
+			PrintFunction(stream, key);
+			stream << '\n';
+		}
+	}
+}
+
+int main(int argc, char* argv[]) {
+	std::ios::sync_with_stdio(false);
+
+	std::string tracePath;
+	bool isSummary = false;
+
+	for (int i = 1; i < argc; ++i) {
+		const std::string_view arg = argv[i];
+		if (arg == "-summary") {
+			isSummary = true;
+		} else if (!arg.empty() && arg.front() != '-' && tracePath.empty()) {
+			tracePath = arg;
+		} else {
+			tracePath.clear();
+			break;
+		}
+	}
+	if (tracePath.empty()) {
+		std::cout << "Usage: ./ShitVM-trace-dump <Trace> [-summary]\n";
+		return EXIT_FAILURE;
+	}
+
+	std::ifstream stream(tracePath, std::ios::binary);
+	if (!stream) {
+		std::cout << "Error: Failed to open \"" << tracePath << "\".\n";
+		return EXIT_FAILURE;
+	}
+
+	try {
+		svm::TraceReader reader(stream);
+		if (isSummary) {
+			Summarize(std::cout, reader);
+		} else {
+			Dump(std::cout, reader);
+		}
+	} catch (const std::exception& e) {
+		std::cout << "Error: " << e.what() << '\n';
+		return EXIT_FAILURE;
+	}
+	return EXIT_SUCCESS;
+}
\ No newline at end of file